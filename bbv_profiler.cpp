@@ -0,0 +1,196 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#include "bbv_profiler.h"
+#include <algorithm>  //sort min
+#include <limits>
+
+/**
+ * @brief Method called by the hart when a branch or jump ends a basic block.
+ * Every instruction since the previous block ended is counted to this one.
+ * 
+ * @param addr address of the branch or jump that ends the block.
+ * @param insn_counter hart instruction counter including the branch.
+ */
+void bbv_profiler::end_block(uint32_t addr, uint64_t insn_counter)
+{
+    blocks[addr] += insn_counter - last_counter;
+    last_counter = insn_counter;
+}
+
+/**
+ * @brief Method to close the current interval. Its block vector is
+ * normalized and projected down to dims dimensions.
+ */
+void bbv_profiler::end_interval()
+{
+    point p = {};
+    uint64_t total = 0;
+
+    for (const auto &b : blocks)
+    {
+        total += b.second;
+    }
+
+    for (const auto &b : blocks)
+    {
+        double share = static_cast<double>(b.second) / total;
+        for (uint32_t d = 0; d < dims; d++)
+        {
+            p[d] += share * projection(b.first, d);
+        }
+    }
+
+    projected.push_back(p);
+    blocks.clear();
+}
+
+/**
+ * @brief Method to cluster the intervals and pick a representative for
+ * each cluster.
+ * 
+ * @param k number of clusters.
+ * @return std::vector<simpoint> representative intervals in execution
+ * order, with weights that add up to 1.
+ */
+std::vector<bbv_profiler::simpoint> bbv_profiler::pick(uint32_t k) const
+{
+    std::vector<simpoint> result;
+    uint32_t n = projected.size();
+
+    if (n == 0 || k == 0)
+    {
+        return result;
+    }
+    if (k > n)
+    {
+        k = n;
+    }
+
+    //seed with the first interval then repeatedly the farthest one
+    std::vector<point> centers = { projected[0] };
+    std::vector<double> nearest(n, std::numeric_limits<double>::max());
+
+    while (centers.size() < k)
+    {
+        uint32_t far = 0;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            nearest[i] = std::min(nearest[i], distance(projected[i], centers.back()));
+            if (nearest[i] > nearest[far])
+            {
+                far = i;
+            }
+        }
+        centers.push_back(projected[far]);
+    }
+
+    //Lloyd's iterations until the assignment stops changing
+    std::vector<uint32_t> cluster(n, 0);
+    for (uint32_t iter = 0; iter < 100; iter++)
+    {
+        bool changed = false;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint32_t best = 0;
+            for (uint32_t c = 1; c < k; c++)
+            {
+                if (distance(projected[i], centers[c]) < distance(projected[i], centers[best]))
+                {
+                    best = c;
+                }
+            }
+            changed |= (cluster[i] != best);
+            cluster[i] = best;
+        }
+
+        if (!changed && iter != 0)
+        {
+            break;
+        }
+
+        std::vector<point> sum(k, point{});
+        std::vector<uint32_t> count(k, 0);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            for (uint32_t d = 0; d < dims; d++)
+            {
+                sum[cluster[i]][d] += projected[i][d];
+            }
+            count[cluster[i]]++;
+        }
+        for (uint32_t c = 0; c < k; c++)
+        {
+            for (uint32_t d = 0; count[c] && d < dims; d++)
+            {
+                centers[c][d] = sum[c][d] / count[c];
+            }
+        }
+    }
+
+    //the representative is the interval closest to its cluster's center
+    std::vector<int64_t> rep(k, -1);
+    std::vector<uint32_t> count(k, 0);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t c = cluster[i];
+        count[c]++;
+        if (rep[c] < 0 || distance(projected[i], centers[c]) < distance(projected[rep[c]], centers[c]))
+        {
+            rep[c] = i;
+        }
+    }
+
+    for (uint32_t c = 0; c < k; c++)
+    {
+        if (rep[c] >= 0)
+        {
+            result.push_back({ static_cast<uint32_t>(rep[c]), static_cast<double>(count[c]) / n });
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const simpoint &a, const simpoint &b) { return a.interval < b.interval; });
+    return result;
+}
+
+/**
+ * @brief Method to return one entry of the random projection matrix. The
+ * entry is a hash of the block address so no matrix has to be stored.
+ * 
+ * @param addr block address (matrix column).
+ * @param d dimension (matrix row).
+ * @return double value in [-1, 1].
+ */
+double bbv_profiler::projection(uint32_t addr, uint32_t d)
+{
+    uint32_t h = addr * 2654435761u ^ (d + 1) * 0x9e3779b9u;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    return static_cast<double>(h) / 0xffffffffu * 2.0 - 1.0;
+}
+
+/**
+ * @brief Method to return the Manhattan distance between two points.
+ * 
+ * @param a first point.
+ * @param b second point.
+ * @return double distance.
+ */
+double bbv_profiler::distance(const point &a, const point &b)
+{
+    double sum = 0;
+    for (uint32_t d = 0; d < dims; d++)
+    {
+        sum += a[d] > b[d] ? a[d] - b[d] : b[d] - a[d];
+    }
+    return sum;
+}
@@ -0,0 +1,59 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#ifndef BBV_PROFILER_H
+#define BBV_PROFILER_H
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * SimPoint style basic block vector profiler. The hart reports the end of
+ * every basic block from its branch and jump handlers. Execution is split
+ * into intervals and each interval's block vector is reduced to a few
+ * dimensions by a random projection. The intervals are then clustered with
+ * k-means and one representative interval is picked per cluster.
+ ********************************************************************************/
+class bbv_profiler
+{
+public:
+    /// a representative interval and the fraction of execution it stands for
+    struct simpoint
+    {
+        uint32_t interval;
+        double weight;
+    };
+
+    /// insn_counter is the hart's count when profiling starts
+    explicit bbv_profiler(uint64_t insn_counter = 0) : last_counter(insn_counter) { }
+
+    void end_block(uint32_t addr, uint64_t insn_counter);
+    void end_interval();
+
+    uint32_t get_intervals() const { return projected.size(); }
+    std::vector<simpoint> pick(uint32_t k) const;
+
+    static constexpr uint32_t dims = 15;
+
+private:
+    typedef std::array<double, dims> point;
+
+    static double projection(uint32_t addr, uint32_t d);
+    static double distance(const point &a, const point &b);
+
+    std::unordered_map<uint32_t, uint64_t> blocks;  ///< insns per block this interval
+    std::vector<point> projected;                   ///< one per finished interval
+    uint64_t last_counter = { 0 };
+};
+
+#endif
@@ -0,0 +1,171 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+#include "blockdev.h"
+#include <fcntl.h>      //open
+#include <sys/mman.h>   //mmap munmap
+#include <sys/stat.h>   //fstat
+#include <unistd.h>     //close
+#include <iostream>
+
+/**
+ * @brief Construct a new blockdev object with no image.
+ * 
+ * @param mem memory that transfers copy to and from.
+ */
+blockdev::blockdev(memory &mem) : mem(mem)
+{
+}
+
+/**
+ * @brief Destroy the blockdev object. Sectors the guest wrote reach the
+ * image file when the mapping is removed, if not before.
+ */
+blockdev::~blockdev()
+{
+    if (image)
+    {
+        munmap(image, image_size);
+    }
+}
+
+/**
+ * @brief Method to map a disk image. It is opened for writing if the
+ * host allows it, otherwise it is read-only and cmd_write fails.
+ * 
+ * @param fname disk image file.
+ * @return true if the image could be mapped.
+ */
+bool blockdev::open(const std::string &fname)
+{
+    int fd = ::open(fname.c_str(), O_RDWR);
+    writable = fd >= 0;
+    if (!writable)
+    {
+        fd = ::open(fname.c_str(), O_RDONLY);
+    }
+
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size < sector_size)
+    {
+        std::cerr << "Can't open disk image '" << fname << "'." << std::endl;
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return false;
+    }
+
+    //only whole sectors are visible to the guest
+    image_size = st.st_size - st.st_size % sector_size;
+
+    void *p = mmap(nullptr, image_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (p == MAP_FAILED)
+    {
+        std::cerr << "Can't map disk image '" << fname << "'." << std::endl;
+        return false;
+    }
+
+    image = static_cast<uint8_t*>(p);
+    return true;
+}
+
+/**
+ * @brief Method to map the registers into memory.
+ * 
+ * @param base address of SECTOR, above the RAM.
+ * @return true if the registers were mapped.
+ */
+bool blockdev::map(uint32_t base)
+{
+    return mem.add_mmio(base, size,
+        [this](uint32_t offset, uint32_t) -> uint32_t
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            return read_reg(offset);
+        },
+        [this](uint32_t offset, uint32_t, uint32_t val)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            write_reg(offset, val);
+        });
+}
+
+/**
+ * @brief Method to read a register.
+ * 
+ * @param offset register offset from the base.
+ * @return uint32_t register value, 0 for offsets with no register.
+ */
+uint32_t blockdev::read_reg(uint32_t offset) const
+{
+    switch (offset)
+    {
+    case reg_sector:    return sector;
+    case reg_buffer:    return buffer;
+    case reg_count:     return count;
+    case reg_status:    return status;
+    case reg_capacity:  return image_size / sector_size;
+    default:            return 0;
+    }
+}
+
+/**
+ * @brief Method to write a register. Writes to the read-only registers
+ * are ignored.
+ * 
+ * @param offset register offset from the base.
+ * @param val value to write.
+ */
+void blockdev::write_reg(uint32_t offset, uint32_t val)
+{
+    switch (offset)
+    {
+    case reg_sector:    sector = val; break;
+    case reg_buffer:    buffer = val; break;
+    case reg_count:     count = val; break;
+    case reg_command:   status = transfer(val); break;
+    }
+}
+
+/**
+ * @brief Method to run a command. The sectors are copied in one block
+ * between the mapping and the RAM. Nothing is copied unless the whole
+ * transfer fits in both.
+ * 
+ * @param command cmd_read or cmd_write.
+ * @return uint32_t the new STATUS.
+ */
+uint32_t blockdev::transfer(uint32_t command)
+{
+    uint64_t first = (uint64_t)sector * sector_size;
+    uint64_t len = (uint64_t)count * sector_size;
+
+    if (!image || first + len > image_size || len > UINT32_MAX)
+    {
+        return status_error;
+    }
+
+    switch (command)
+    {
+    case cmd_read:
+        return mem.write_block(buffer, image + first, len) ? status_ok : status_error;
+
+    case cmd_write:
+        return (writable && mem.read_block(buffer, image + first, len)) ? status_ok : status_error;
+
+    default:
+        return status_error;
+    }
+}
@@ -0,0 +1,77 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+
+#ifndef BLOCKDEV_H
+#define BLOCKDEV_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "memory.h"
+
+/**
+ * A minimal block controller backed by a host disk image. The image is
+ * mmap'd, so a transfer is one copy between the mapping and the guest RAM
+ * and the image is never read up front. The guest sets SECTOR, BUFFER and
+ * COUNT, then writes a command. The transfer is done by the time the
+ * store to COMMAND finishes, and STATUS tells whether it worked.
+ *
+ *      0x00  SECTOR    first sector of the transfer
+ *      0x04  BUFFER    guest RAM address
+ *      0x08  COUNT     number of sectors
+ *      0x0c  COMMAND   cmd_read (disk to RAM) or cmd_write (RAM to disk)
+ *      0x10  STATUS    status_ok or status_error, read-only
+ *      0x14  CAPACITY  size of the image in sectors, read-only
+ ********************************************************************************/
+class blockdev
+{
+public:
+    blockdev(memory &mem);
+    ~blockdev();
+
+    bool open(const std::string &fname);
+    bool map(uint32_t base);
+
+    static constexpr uint32_t size = 0x18;          ///< bytes of registers mapped
+    static constexpr uint32_t sector_size = 512;
+
+    static constexpr uint32_t reg_sector = 0x00;
+    static constexpr uint32_t reg_buffer = 0x04;
+    static constexpr uint32_t reg_count = 0x08;
+    static constexpr uint32_t reg_command = 0x0c;
+    static constexpr uint32_t reg_status = 0x10;
+    static constexpr uint32_t reg_capacity = 0x14;
+
+    static constexpr uint32_t cmd_read = 1;
+    static constexpr uint32_t cmd_write = 2;
+    static constexpr uint32_t status_ok = 0;
+    static constexpr uint32_t status_error = 1;
+
+private:
+    uint32_t read_reg(uint32_t offset) const;
+    void write_reg(uint32_t offset, uint32_t val);
+    uint32_t transfer(uint32_t command);
+
+    memory &mem;
+    std::mutex lock;                ///< guards the registers between harts
+    uint8_t *image = { nullptr };   ///< mapping of the whole image
+    uint64_t image_size = { 0 };
+    bool writable = { false };
+    uint32_t sector = { 0 };
+    uint32_t buffer = { 0 };
+    uint32_t count = { 0 };
+    uint32_t status = { status_ok };
+};
+
+#endif
@@ -0,0 +1,220 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#include "checkpoint.h"
+#include <algorithm>    //all_of min
+#include <cstring>      //memcmp memcpy
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>      //open
+#include <sys/mman.h>   //mmap
+#include <sys/stat.h>   //fstat
+#include <unistd.h>     //close
+
+using std::cerr;
+using std::endl;
+
+constexpr char checkpoint::magic[8];
+constexpr char checkpoint::delta_magic[8];
+
+/**
+ * This function writes the hart and memory state to a checkpoint file.
+ *
+ * @param fname name of the checkpoint file.
+ * @param hart hart whose state is saved.
+ * @param mem memory whose touched pages are saved.
+ *
+ * @return true if the file was written.
+ ********************************************************************************/
+bool checkpoint::save(const std::string &fname, const rv32i_hart &hart, const memory &mem)
+{
+    return write(fname, hart, mem, false);
+}
+
+/**
+ * This function writes the hart state and the pages written since the last
+ * checkpoint to a delta checkpoint file. The caller clears the dirty pages
+ * once the file is written.
+ *
+ * @param fname name of the checkpoint file.
+ * @param hart hart whose state is saved.
+ * @param mem memory whose dirty pages are saved.
+ *
+ * @return true if the file was written.
+ ********************************************************************************/
+bool checkpoint::save_delta(const std::string &fname, const rv32i_hart &hart, const memory &mem)
+{
+    return write(fname, hart, mem, true);
+}
+
+/**
+ * This function writes a full or delta checkpoint file.
+ *
+ * @param fname name of the checkpoint file.
+ * @param hart hart whose state is saved.
+ * @param mem memory whose pages are saved.
+ * @param delta true to store only dirty pages.
+ *
+ * @return true if the file was written.
+ ********************************************************************************/
+bool checkpoint::write(const std::string &fname, const rv32i_hart &hart, const memory &mem, bool delta)
+{
+    std::ofstream outfile(fname, std::ios::out|std::ios::binary|std::ios::trunc);
+    if (!outfile.is_open())
+    {
+        cerr << "Can't open file '" << fname << "' for writing." << endl;
+        return false;
+    }
+
+    //find the pages that differ from the fill pattern, or for a delta
+    //the pages that have been written
+    std::vector<uint32_t> pages;
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> page(page_size);
+
+    for (uint32_t addr = 0; addr < mem.get_size(); addr += page_size)
+    {
+        if (delta && !mem.is_dirty(addr / page_size))
+        {
+            continue;
+        }
+
+        uint32_t len = std::min(page_size, mem.get_size() - addr);
+        std::fill(page.begin(), page.end(), fill);
+        mem.read_block(addr, page.data(), len);
+
+        if (delta || !std::all_of(page.begin(), page.end(), [](uint8_t b) { return b == fill; }))
+        {
+            pages.push_back(addr / page_size);
+            data.insert(data.end(), page.begin(), page.end());
+        }
+    }
+
+    header h = {};
+    memcpy(h.magic, delta ? delta_magic : magic, sizeof(h.magic));
+    h.version = version;
+    h.page_size = page_size;
+    h.mem_size = mem.get_size();
+    h.load_size = mem.get_load_size();
+    h.page_count = pages.size();
+    hart.get_state(h.state);
+
+    //align the page data so it can be used in place once mapped
+    uint64_t index_end = sizeof(h) + pages.size() * sizeof(uint32_t);
+    h.data_offset = (index_end + page_size - 1) / page_size * page_size;
+
+    outfile.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    outfile.write(reinterpret_cast<const char*>(pages.data()), pages.size() * sizeof(uint32_t));
+    std::vector<char> pad(h.data_offset - index_end, 0);
+    outfile.write(pad.data(), pad.size());
+    outfile.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    if (!outfile)
+    {
+        cerr << "Error writing checkpoint '" << fname << "'." << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * This function maps a checkpoint file and restores the hart and memory
+ * state from it. A delta checkpoint is applied on top of the current
+ * memory contents.
+ *
+ * @param fname name of the checkpoint file.
+ * @param hart hart to restore.
+ * @param mem memory to restore. It must be the same size as when saved.
+ *
+ * @return true if the state was restored.
+ ********************************************************************************/
+bool checkpoint::restore(const std::string &fname, rv32i_hart &hart, memory &mem)
+{
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        cerr << "Can't open file '" << fname << "' for reading." << endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(header))
+    {
+        cerr << "Checkpoint '" << fname << "' is too short." << endl;
+        close(fd);
+        return false;
+    }
+
+    void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        cerr << "Can't map checkpoint '" << fname << "'." << endl;
+        return false;
+    }
+
+    const uint8_t *base = static_cast<const uint8_t*>(map);
+    const header *h = reinterpret_cast<const header*>(base);
+    const uint32_t *pages = reinterpret_cast<const uint32_t*>(base + sizeof(header));
+
+    bool delta = memcmp(h->magic, delta_magic, sizeof(delta_magic)) == 0;
+    bool ok = true;
+    if ((!delta && memcmp(h->magic, magic, sizeof(magic)) != 0) || h->version != version || h->page_size != page_size)
+    {
+        cerr << "Checkpoint '" << fname << "' has an unsupported format." << endl;
+        ok = false;
+    }
+    else if (h->mem_size != mem.get_size())
+    {
+        cerr << "Checkpoint '" << fname << "' needs memory size " << hex::to_hex0x32(h->mem_size) << "." << endl;
+        ok = false;
+    }
+    else if (h->data_offset + static_cast<uint64_t>(h->page_count) * page_size > static_cast<uint64_t>(st.st_size))
+    {
+        cerr << "Checkpoint '" << fname << "' is truncated." << endl;
+        ok = false;
+    }
+
+    if (ok)
+    {
+        //pages that were not stored in a full checkpoint still hold the
+        //fill pattern, and in a delta they are unchanged
+        std::vector<uint8_t> blank(page_size, fill);
+        uint32_t next = 0;
+
+        for (uint32_t addr = 0; addr < mem.get_size(); addr += page_size)
+        {
+            uint32_t len = std::min(page_size, mem.get_size() - addr);
+            const uint8_t *src = blank.data();
+
+            if (next < h->page_count && pages[next] == addr / page_size)
+            {
+                src = base + h->data_offset + static_cast<uint64_t>(next) * page_size;
+                next++;
+            }
+            else if (delta)
+            {
+                continue;
+            }
+            mem.write_block(addr, src, len);
+        }
+
+        hart.set_state(h->state);
+        mem.set_load_size(h->load_size);
+
+        //the next delta is relative to the state just restored
+        mem.clear_dirty();
+    }
+
+    munmap(map, st.st_size);
+    return ok;
+}
@@ -0,0 +1,64 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <string>
+
+#include "hart_state.h"
+#include "memory.h"
+#include "rv32i_hart.h"
+
+/**
+ * Saves and restores the complete machine state. The file is a fixed header
+ * holding the hart_state, followed by the numbers of the stored pages and
+ * then the page contents aligned to page_size. Pages that still hold only
+ * the 0xa5 fill pattern are not stored. Restoring maps the file and copies
+ * the pages straight out of the mapping.
+ *
+ * A delta checkpoint has the same layout but a different magic and only
+ * stores the pages memory has marked dirty. Restoring a full checkpoint
+ * followed by its deltas in order rebuilds the state at any of them.
+ ********************************************************************************/
+class checkpoint
+{
+public:
+    static bool save(const std::string &fname, const rv32i_hart &hart, const memory &mem);
+    static bool save_delta(const std::string &fname, const rv32i_hart &hart, const memory &mem);
+    static bool restore(const std::string &fname, rv32i_hart &hart, memory &mem);
+
+    static constexpr uint32_t version = 7;
+    static constexpr uint32_t page_size = memory::page_size;
+    static constexpr uint8_t fill = 0xa5;
+
+private:
+    struct header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t page_size;
+        uint32_t mem_size;
+        uint32_t load_size;         ///< end of the loaded program, the heap starts after it
+        uint32_t page_count;
+        uint32_t reserved;          ///< zero, keeps data_offset aligned
+        uint64_t data_offset;
+        hart_state state;
+    };
+
+    static bool write(const std::string &fname, const rv32i_hart &hart, const memory &mem, bool delta);
+
+    static constexpr char magic[8] = { 'R', 'V', '3', '2', 'C', 'K', 'P', 'T' };
+    static constexpr char delta_magic[8] = { 'R', 'V', '3', '2', 'D', 'L', 'T', 'A' };
+};
+
+#endif
@@ -0,0 +1,129 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+#include "clint.h"
+
+/**
+ * @brief Construct a new clint object. mtimecmp starts at its largest
+ * value so the timer does not fire until the guest programs it.
+ * 
+ * @param hart hart whose interrupt inputs are driven.
+ * @param events queue that the timer expiry is put in.
+ */
+clint::clint(rv32i_hart &hart, event_queue &events) : hart(hart), events(events)
+{
+}
+
+/**
+ * @brief Method to map the registers into memory.
+ * 
+ * @param mem memory to map the CLINT into.
+ * @param base address of msip, above the RAM.
+ * @return true if the registers were mapped.
+ */
+bool clint::map(memory &mem, uint32_t base)
+{
+    return mem.add_mmio(base, size,
+        [this](uint32_t offset, uint32_t len) -> uint32_t
+        {
+            //narrow loads take their bytes out of the word
+            uint32_t val = read_word(offset & ~3u) >> (8 * (offset & 3));
+            return len == 4 ? val : val & ((1u << (8 * len)) - 1);
+        },
+        [this](uint32_t offset, uint32_t len, uint32_t val)
+        {
+            //narrow stores replace their bytes of the word
+            uint32_t shift = 8 * (offset & 3);
+            uint32_t mask = (len == 4 ? 0xffffffff : (1u << (8 * len)) - 1) << shift;
+            uint32_t word = read_word(offset & ~3u);
+            write_word(offset & ~3u, (word & ~mask) | ((val << shift) & mask));
+        });
+}
+
+/**
+ * @brief Method to read a register word.
+ * 
+ * @param offset word aligned offset from the base.
+ * @return uint32_t register value, 0 for offsets with no register.
+ */
+uint32_t clint::read_word(uint32_t offset) const
+{
+    switch (offset)
+    {
+    case reg_msip:          return msip;
+    case reg_mtimecmp:      return mtimecmp;
+    case reg_mtimecmp + 4:  return mtimecmp >> 32;
+    case reg_mtime:         return hart.get_time();
+    case reg_mtime + 4:     return hart.get_time() >> 32;
+    default:                return 0;
+    }
+}
+
+/**
+ * @brief Method to write a register word. Writes to mtime and to offsets
+ * with no register are ignored.
+ * 
+ * @param offset word aligned offset from the base.
+ * @param val value to write.
+ */
+void clint::write_word(uint32_t offset, uint32_t val)
+{
+    switch (offset)
+    {
+    case reg_msip:
+        msip = val & 1;
+        hart.set_mip(rv32i_hart::mip_msip, msip);
+        break;
+
+    case reg_mtimecmp:
+        mtimecmp = (mtimecmp & 0xffffffff00000000) | val;
+        update_timer();
+        break;
+
+    case reg_mtimecmp + 4:
+        mtimecmp = (mtimecmp & 0xffffffff) | (uint64_t)val << 32;
+        update_timer();
+        break;
+    }
+}
+
+/**
+ * @brief Method to set mip.MTIP from mtime and mtimecmp and, while the
+ * timer has not expired, schedule an event for the instruction count at
+ * which it will. An event left over from an older mtimecmp finds that it
+ * is no longer the armed one and does nothing.
+ */
+void clint::update_timer()
+{
+    uint64_t now = hart.get_time();
+    hart.set_mip(rv32i_hart::mip_mtip, now >= mtimecmp);
+
+    //expired, or too far out to ever be reached
+    if (now >= mtimecmp || mtimecmp > UINT64_MAX / rv32i_hart::insns_per_mtime)
+    {
+        armed = 0;
+        return;
+    }
+
+    uint64_t when = mtimecmp * rv32i_hart::insns_per_mtime;
+    if (when != armed)
+    {
+        armed = when;
+        events.schedule(when, [this, when](uint64_t)
+        {
+            if (armed == when)
+            {
+                update_timer();
+            }
+        });
+    }
+}
@@ -0,0 +1,56 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+
+#ifndef CLINT_H
+#define CLINT_H
+
+#include <cstdint>
+
+#include "memory.h"
+#include "rv32i_hart.h"
+#include "event_queue.h"
+
+/**
+ * A CLINT-compatible core-local interruptor for one hart: msip raises the
+ * machine software interrupt and mtime/mtimecmp the machine timer
+ * interrupt. mtime is the hart's time CSR, so it advances one tick every
+ * insns_per_mtime instructions and cannot be written. Rather than compare
+ * mtime against mtimecmp on every instruction, a write to mtimecmp puts
+ * one event in the event queue at the instruction count where the timer
+ * will expire.
+ ********************************************************************************/
+class clint
+{
+public:
+    clint(rv32i_hart &hart, event_queue &events);
+
+    bool map(memory &mem, uint32_t base);
+
+    static constexpr uint32_t size = 0x10000;       ///< bytes of registers mapped
+    static constexpr uint32_t reg_msip = 0x0000;
+    static constexpr uint32_t reg_mtimecmp = 0x4000;///< low word, high word at +4
+    static constexpr uint32_t reg_mtime = 0xbff8;   ///< low word, high word at +4
+
+private:
+    uint32_t read_word(uint32_t offset) const;
+    void write_word(uint32_t offset, uint32_t val);
+    void update_timer();
+
+    rv32i_hart &hart;
+    event_queue &events;
+    uint32_t msip = { 0 };
+    uint64_t mtimecmp = { UINT64_MAX };
+    uint64_t armed = { 0 };     ///< instruction count of the live event, 0 if none
+};
+
+#endif
@@ -10,45 +10,300 @@
 //***************************************************************************
 
 #include "cpu_single_hart.h"
+#include "checkpoint.h"
+#include "bbv_profiler.h"
+#include "guard_pages.h"
+#include <fstream>
+#include <algorithm>  //min
+#include <limits>
+#include <cstdio>     //remove
 
 
+/**
+ * @brief Method to prepare the hart for execution by setting the
+ * stack pointer to the top of memory.
+ */
+void cpu_single_hart::start()
+{
+    //set register x2 to mem size
+    regs.set(2, mem.get_size());
+}
+
 /**
  * @brief Method to run the simulator until is is halted or 
  * instruction execution limit is reached.
  * 
  * @param exec_limit maximum number of instructions that can be
  * executed.
+ * @return true unless a checkpoint could not be written or read back.
  */
-void cpu_single_hart::run(uint64_t exec_limit)
+bool cpu_single_hart::run(uint64_t exec_limit)
 {
-    //set register x2 to mem size
-    regs.set(2, mem.get_size());
+    bool ok = true;
+
+    //set register x2 to mem size unless resuming from a checkpoint
+    if (get_insn_counter() == 0)
+    {
+        start();
+    }
 
-    //if exec limit is zero
-    if(exec_limit == 0)
+    //profile basic block vectors and checkpoint the representative intervals
+    if(simpoint_interval != 0)
+    {
+        ok = run_simpoint(exec_limit);
+    }
+    else if(checkpoint_interval != 0)//write a full checkpoint now and a delta after every interval
+    {
+        ok = run_checkpointed(exec_limit);
+    }
+    else if(exec_limit == 0)//if exec limit is zero
     {
         //call tick() until is_halted() returns true
-        while(is_halted() != true)
-        {
-            tick();
-        }
+        run_to(std::numeric_limits<uint64_t>::max());
     }
 
-    if(exec_limit != 0)//if exec limit is not zero
+    else//if exec limit is not zero
     {
         //call tick() until is_halted() is true or until exec limit is reached
-        while(is_halted() != true && get_insn_counter() != exec_limit)
-        {
-            tick();
-        }
+        run_to(exec_limit);
     }
 
+    //the guest's output comes before the summary
+    flush_output();
+
     //if the hart becomes halted then print message indicating why
     if (is_halted())
     {
         std::cout << "Execution terminated. Reason: " << get_halt_reason() << std::endl;
     }
+    else if (is_idle())
+    {
+        std::cout << "Execution stopped. Reason: waiting for an interrupt that nothing can raise" << std::endl;
+    }
 
     //print number of instructions that have been executed
     std::cout << get_insn_counter() << " instructions executed" << std::endl;
+
+    return ok;
+}
+
+/**
+ * @brief Method to run at most one slice of instructions. Used by the
+ * hart_scheduler to interleave many harts on a few host threads.
+ * 
+ * @param slice maximum number of instructions to execute in this slice.
+ * @param exec_limit maximum number of instructions the hart may execute
+ * in total (zero means no limit).
+ * @return true if the hart can still run, false if it is halted, has
+ * reached its exec limit or is idle with nothing left to wake it.
+ */
+bool cpu_single_hart::run_slice(uint64_t slice, uint64_t exec_limit)
+{
+    //stop at the end of the slice or the instruction budget
+    uint64_t stop = std::numeric_limits<uint64_t>::max() - get_insn_counter() > slice ? get_insn_counter() + slice : std::numeric_limits<uint64_t>::max();
+    if (exec_limit != 0)
+    {
+        stop = std::min(stop, exec_limit);
+    }
+
+    run_to(stop);
+
+    return !is_halted() && !is_idle() && (exec_limit == 0 || get_insn_counter() < exec_limit);
+}
+
+/**
+ * @brief Method to call tick() until the hart halts or the instruction
+ * counter reaches stop. The events in the event queue run between ticks
+ * when they fall due. Nothing polls the devices, the inner loop only
+ * compares the counter with the count of the next event. A hart that goes
+ * idle in WFI or a jump to itself is moved straight to the next event or
+ * to stop, whichever comes first. An idle hart with no event to wait for
+ * returns early and stays idle. With guard pages this is also where an
+ * unchecked access outside of the RAM comes back to.
+ * 
+ * @param stop instruction count to stop at.
+ */
+void cpu_single_hart::run_to(uint64_t stop)
+{
+    //a fault jumps out of tick(), so it is never handed a temporary
+    static const std::string no_hdr;
+
+    //with guard pages the loads and stores skip the range checks. One
+    //that leaves the RAM faults on the host, lands here and is run again
+    //with the checks on
+    sigjmp_buf landing;
+    if (sigsetjmp(landing, 0) != 0)
+    {
+        retry_checked();
+    }
+    uint8_t *base = mem.get_guard_base();
+    if (base)
+    {
+        guard_pages::arm(base, &landing);
+    }
+    set_unchecked(base != nullptr);
+
+    while (!is_halted() && get_insn_counter() < stop)
+    {
+        //run uninterrupted up to the next event, which a device access
+        //may move closer
+        while (!is_halted() && !is_idle() && get_insn_counter() < stop && get_insn_counter() < events->next())
+        {
+            tick(no_hdr);
+        }
+
+        //nothing but time can pass until something wakes the hart. With no
+        //event left nothing ever will, so the hart is left idle and the
+        //caller decides what to do with it
+        if (is_idle())
+        {
+            if (events->next() == std::numeric_limits<uint64_t>::max())
+            {
+                break;
+            }
+            skip_idle(std::min(stop, events->next()));
+        }
+
+        events->run_due(get_insn_counter());
+    }
+
+    set_unchecked(false);
+    guard_pages::disarm();
+}
+
+/**
+ * @brief Method to enable periodic delta checkpoints during run().
+ * 
+ * @param prefix file name prefix. Checkpoint k is written to prefix.k
+ * where prefix.0 is a full checkpoint and the rest are deltas.
+ * @param interval number of instructions between checkpoints (zero
+ * disables them).
+ */
+void cpu_single_hart::set_checkpoint_interval(const std::string &prefix, uint64_t interval)
+{
+    checkpoint_prefix = prefix;
+    checkpoint_interval = interval;
+}
+
+/**
+ * @brief Method to run in slices of checkpoint_interval instructions and
+ * write a delta checkpoint after each one, including the last. The run
+ * stops at the first checkpoint that cannot be written, since every delta
+ * after it would be useless.
+ * 
+ * @param exec_limit maximum number of instructions that can be
+ * executed.
+ * @return true if every checkpoint was written.
+ */
+bool cpu_single_hart::run_checkpointed(uint64_t exec_limit)
+{
+    uint32_t seq = 0;
+
+    if (!checkpoint::save(checkpoint_prefix + "." + std::to_string(seq++), *this, mem))
+    {
+        return false;
+    }
+    mem.clear_dirty();
+
+    bool running = true;
+    while (running)
+    {
+        running = run_slice(checkpoint_interval, exec_limit);
+
+        if (!checkpoint::save_delta(checkpoint_prefix + "." + std::to_string(seq++), *this, mem))
+        {
+            return false;
+        }
+        mem.clear_dirty();
+    }
+    return true;
+}
+
+/**
+ * @brief Method to enable SimPoint profiling during run().
+ * 
+ * @param prefix file name prefix for the simpoint list and checkpoints.
+ * @param interval number of instructions per interval (zero disables
+ * profiling).
+ * @param k number of clusters, which is the most simpoints picked.
+ */
+void cpu_single_hart::set_simpoint(const std::string &prefix, uint64_t interval, uint32_t k)
+{
+    simpoint_prefix = prefix;
+    simpoint_interval = interval;
+    simpoint_k = k;
+}
+
+/**
+ * @brief Method to run with basic block vector profiling, pick the
+ * representative intervals and keep a full checkpoint of the start of each
+ * one in prefix.sp<interval>. The intervals and weights are listed in
+ * prefix.simpoints. Which intervals are picked is only known at the end,
+ * so every interval's checkpoint is written as the run reaches it and the
+ * ones that are not picked are deleted. Running only once means system
+ * calls and devices act once, as they would without -P. SimPoint is given
+ * up at the first checkpoint that cannot be written.
+ * 
+ * @param exec_limit maximum number of instructions that can be
+ * executed.
+ * @return true if every checkpoint was written.
+ */
+bool cpu_single_hart::run_simpoint(uint64_t exec_limit)
+{
+    //after -R the first block starts at the restored count, not at reset
+    bbv_profiler profiler(get_insn_counter());
+    set_bbv_profiler(&profiler);
+
+    //one block vector per interval, and a checkpoint of its start
+    std::vector<std::string> files;
+    bool running = true;
+    while (running)
+    {
+        files.push_back(simpoint_prefix + ".sp" + std::to_string(files.size()));
+        if (!checkpoint::save(files.back(), *this, mem))
+        {
+            break;
+        }
+
+        running = run_slice(simpoint_interval, exec_limit);
+        profiler.end_interval();
+    }
+    set_bbv_profiler(nullptr);
+
+    std::vector<bbv_profiler::simpoint> points;
+    if (!running)
+    {
+        points = profiler.pick(simpoint_k);
+    }
+
+    std::vector<bool> keep(files.size(), false);
+    std::ofstream list;
+    if (!running)
+    {
+        list.open(simpoint_prefix + ".simpoints");
+    }
+    for (const bbv_profiler::simpoint &sp : points)
+    {
+        keep[sp.interval] = true;
+
+        list << sp.interval << " " << sp.weight << " " << files[sp.interval] << std::endl;
+        std::cout << "SimPoint interval " << sp.interval << " weight " << sp.weight << " -> " << files[sp.interval] << std::endl;
+    }
+
+    //a failed run keeps no checkpoints at all
+    for (uint32_t i = 0; i < files.size(); i++)
+    {
+        if (!keep[i])
+        {
+            std::remove(files[i].c_str());
+        }
+    }
+
+    if (running)
+    {
+        return false;
+    }
+
+    std::cout << profiler.get_intervals() << " intervals of " << simpoint_interval << " instructions" << std::endl;
+    return true;
 }
\ No newline at end of file
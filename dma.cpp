@@ -0,0 +1,117 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+#include "dma.h"
+
+/**
+ * @brief Construct a new dma object.
+ * 
+ * @param hart hart whose retired instructions time the transfers.
+ * @param events queue that the completion is put in.
+ * @param mem memory that the descriptors and the data are in.
+ */
+dma::dma(rv32i_hart &hart, event_queue &events, memory &mem) : hart(hart), events(events), mem(mem)
+{
+}
+
+/**
+ * @brief Method to map the registers into memory.
+ * 
+ * @param base address of DESC, above the RAM.
+ * @return true if the registers were mapped.
+ */
+bool dma::map(uint32_t base)
+{
+    return mem.add_mmio(base, size,
+        [this](uint32_t offset, uint32_t) -> uint32_t { return read_reg(offset); },
+        [this](uint32_t offset, uint32_t, uint32_t val) { write_reg(offset, val); });
+}
+
+/**
+ * @brief Method to read a register.
+ * 
+ * @param offset register offset from the base.
+ * @return uint32_t register value, 0 for offsets with no register.
+ */
+uint32_t dma::read_reg(uint32_t offset) const
+{
+    switch (offset)
+    {
+    case reg_desc:      return desc;
+    case reg_status:    return status;
+    case reg_delay:     return delay;
+    default:            return 0;
+    }
+}
+
+/**
+ * @brief Method to write a register. A start with no delay finishes
+ * before the store does, otherwise the chain runs from an event DELAY
+ * instructions later so the data and the status change together.
+ * 
+ * @param offset register offset from the base.
+ * @param val value to write.
+ */
+void dma::write_reg(uint32_t offset, uint32_t val)
+{
+    switch (offset)
+    {
+    case reg_desc:
+        desc = val;
+        break;
+
+    case reg_delay:
+        delay = val;
+        break;
+
+    case reg_control:
+        if (val != ctrl_start || status == status_busy)
+        {
+            break;
+        }
+
+        if (delay == 0)
+        {
+            status = run_chain();
+            break;
+        }
+
+        status = status_busy;
+        events.schedule(hart.get_insn_counter() + delay, [this](uint64_t) { status = run_chain(); });
+        break;
+    }
+}
+
+/**
+ * @brief Method to copy every descriptor of the chain. The descriptors
+ * are read when the transfer completes, and the chain stops at the first
+ * one whose ranges are not in RAM.
+ * 
+ * @return uint32_t status_done, or status_error if a descriptor was bad
+ * or the chain did not end within max_chain descriptors.
+ */
+uint32_t dma::run_chain()
+{
+    uint32_t addr = desc;
+
+    for (uint32_t i = 0; i < max_chain && addr != 0; i++)
+    {
+        uint32_t d[4];
+        if (!mem.read_block(addr, d, sizeof(d)) || !mem.copy_block(d[1], d[0], d[2]))
+        {
+            return status_error;
+        }
+        addr = d[3];
+    }
+
+    return addr == 0 ? status_done : status_error;
+}
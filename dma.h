@@ -0,0 +1,72 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+
+#ifndef DMA_H
+#define DMA_H
+
+#include <cstdint>
+
+#include "memory.h"
+#include "rv32i_hart.h"
+#include "event_queue.h"
+
+/**
+ * A DMA controller that runs a chain of copy descriptors inside the guest
+ * RAM, each one as a single host memmove. The guest points DESC at the
+ * first descriptor, sets DELAY and writes ctrl_start to CONTROL. STATUS
+ * reads status_busy until DELAY instructions have retired, then the copies
+ * are done and STATUS changes to status_done or status_error.
+ *
+ *      0x00  DESC      guest address of the first descriptor
+ *      0x04  CONTROL   write ctrl_start to start, ignored while busy
+ *      0x08  STATUS    status_idle, status_busy, status_done or status_error
+ *      0x0c  DELAY     instructions from start to completion
+ *
+ * A descriptor is four words: source, destination, length in bytes and
+ * the address of the next descriptor, 0 at the end of the chain.
+ ********************************************************************************/
+class dma
+{
+public:
+    dma(rv32i_hart &hart, event_queue &events, memory &mem);
+
+    bool map(uint32_t base);
+
+    static constexpr uint32_t size = 0x10;          ///< bytes of registers mapped
+    static constexpr uint32_t max_chain = 0x10000;  ///< longest descriptor chain
+
+    static constexpr uint32_t reg_desc = 0x00;
+    static constexpr uint32_t reg_control = 0x04;
+    static constexpr uint32_t reg_status = 0x08;
+    static constexpr uint32_t reg_delay = 0x0c;
+
+    static constexpr uint32_t ctrl_start = 1;
+    static constexpr uint32_t status_idle = 0;
+    static constexpr uint32_t status_busy = 1;
+    static constexpr uint32_t status_done = 2;
+    static constexpr uint32_t status_error = 3;
+
+private:
+    uint32_t read_reg(uint32_t offset) const;
+    void write_reg(uint32_t offset, uint32_t val);
+    uint32_t run_chain();
+
+    rv32i_hart &hart;
+    event_queue &events;
+    memory &mem;
+    uint32_t desc = { 0 };
+    uint32_t status = { status_idle };
+    uint32_t delay = { 0 };
+};
+
+#endif
@@ -0,0 +1,56 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+#include "event_queue.h"
+#include <algorithm>    //push_heap pop_heap
+
+/**
+ * @brief Method to add an event.
+ * 
+ * @param when instruction count the event falls due at. An event that is
+ * already due runs at the next run_due().
+ * @param fn function to call.
+ */
+void event_queue::schedule(uint64_t when, handler fn)
+{
+    heap.push_back({ when, seq++, std::move(fn) });
+    std::push_heap(heap.begin(), heap.end(), later);
+    due = heap.front().when;
+}
+
+/**
+ * @brief Method to run every event that is due. An event may schedule
+ * more, and those run too if they are already due.
+ * 
+ * @param now current instruction count.
+ */
+void event_queue::run_due(uint64_t now)
+{
+    while (!heap.empty() && heap.front().when <= now)
+    {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        handler fn = std::move(heap.back().fn);
+        heap.pop_back();
+        due = heap.empty() ? std::numeric_limits<uint64_t>::max() : heap.front().when;
+        fn(now);
+    }
+}
+
+/**
+ * @brief Method that orders the heap so the earliest event is on top.
+ * 
+ * @return true if a falls due after b.
+ */
+bool event_queue::later(const event &a, const event &b)
+{
+    return a.when != b.when ? a.when > b.when : a.seq > b.seq;
+}
@@ -0,0 +1,57 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+/**
+ * Device events ordered by the instruction count they fall due at, kept
+ * in a min-heap. The count of the earliest event is cached, so the run
+ * loop only compares the instruction counter against next() between
+ * ticks and calls run_due() when it is reached. An event that a device
+ * schedules in the middle of a run lowers next() at once.
+ ********************************************************************************/
+class event_queue
+{
+public:
+    /// called with the instruction count the event ran at
+    typedef std::function<void(uint64_t now)> handler;
+
+    void schedule(uint64_t when, handler fn);
+    void run_due(uint64_t now);
+
+    /// instruction count of the earliest event, or the largest count if
+    /// there is none
+    uint64_t next() const { return due; }
+
+private:
+    struct event
+    {
+        uint64_t when;
+        uint64_t seq;           ///< events due together run in schedule order
+        handler fn;
+    };
+
+    static bool later(const event &a, const event &b);
+
+    std::vector<event> heap;
+    uint64_t seq = { 0 };
+    uint64_t due = { std::numeric_limits<uint64_t>::max() };
+};
+
+#endif
@@ -0,0 +1,205 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#include "fregisterfile.h"
+
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * @brief Construct a new fregisterfile object
+ * 
+ */
+fregisterfile::fregisterfile()
+{
+    reset();
+}
+
+/**
+ * @brief Method to reset the registers.
+ * 
+ */
+void fregisterfile::reset()
+{
+    //set regs vector to 32 for number of FP registers
+    regs.resize(32);
+
+    //initialize all registers to the same pattern as the GP registers
+    for (size_t regr = 0; regr < regs.size(); regr++)
+    {
+        set(regr, 0xf0f0f0f0f0f0f0f0);
+    }
+}
+
+/**
+ * @brief Method to set the register to a raw 64-bit value.
+ * 
+ * @param r register number.
+ * @param val value to set the register to.
+ */
+void fregisterfile::set(uint32_t r, uint64_t val)
+{
+    //f0 is an ordinary register, unlike x0
+    regs.at(r) = val;
+}
+
+/**
+ * @brief Method to return the raw 64-bit value in register r.
+ * 
+ * @param r register number.
+ * @return uint64_t value in register.
+ */
+uint64_t fregisterfile::get(uint32_t r) const
+{
+    return regs.at(r);
+}
+
+/**
+ * @brief Method to set the register to the bits of a single precision
+ * value, NaN-boxing it.
+ * 
+ * @param r register number.
+ * @param val bits of the single precision value.
+ */
+void fregisterfile::set_bits_s(uint32_t r, uint32_t val)
+{
+    set(r, 0xffffffff00000000 | val);
+}
+
+/**
+ * @brief Method to return the bits of the single precision value in
+ * register r.
+ * 
+ * @param r register number.
+ * @return uint32_t bits of the value, or the canonical NaN if the
+ * register is not properly NaN-boxed.
+ */
+uint32_t fregisterfile::get_bits_s(uint32_t r) const
+{
+    uint64_t val = get(r);
+
+    //the upper half must be all ones for a valid single precision value
+    return ((val >> 32) == 0xffffffff) ? (uint32_t)val : canonical_nan_s;
+}
+
+/**
+ * @brief Method to set the register to a single precision result. A NaN
+ * result is stored as the canonical NaN as the F extension requires.
+ * 
+ * @param r register number.
+ * @param val single precision value.
+ */
+void fregisterfile::set_s(uint32_t r, float val)
+{
+    uint32_t bits = canonical_nan_s;
+    if (!std::isnan(val))
+    {
+        memcpy(&bits, &val, sizeof(bits));
+    }
+    set_bits_s(r, bits);
+}
+
+/**
+ * @brief Method to return the single precision value in register r.
+ * 
+ * @param r register number.
+ * @return float value in register.
+ */
+float fregisterfile::get_s(uint32_t r) const
+{
+    uint32_t bits = get_bits_s(r);
+    float val;
+    memcpy(&val, &bits, sizeof(val));
+    return val;
+}
+
+/**
+ * @brief Method to set the register to a double precision result. A NaN
+ * result is stored as the canonical NaN as the D extension requires.
+ * 
+ * @param r register number.
+ * @param val double precision value.
+ */
+void fregisterfile::set_d(uint32_t r, double val)
+{
+    uint64_t bits = canonical_nan_d;
+    if (!std::isnan(val))
+    {
+        memcpy(&bits, &val, sizeof(bits));
+    }
+    set(r, bits);
+}
+
+/**
+ * @brief Method to return the double precision value in register r.
+ * 
+ * @param r register number.
+ * @return double value in register.
+ */
+double fregisterfile::get_d(uint32_t r) const
+{
+    uint64_t bits = get(r);
+    double val;
+    memcpy(&val, &bits, sizeof(val));
+    return val;
+}
+
+/**
+ * @brief Method to check for a single precision signaling NaN, a NaN
+ * with the most significant fraction bit clear.
+ * 
+ * @param bits bits of the single precision value.
+ * @return true if the value is a signaling NaN.
+ */
+bool fregisterfile::is_snan_s(uint32_t bits)
+{
+    return (bits & 0x7f800000) == 0x7f800000 && (bits & 0x007fffff) != 0 && !(bits & 0x00400000);
+}
+
+/**
+ * @brief Method to check for a double precision signaling NaN, a NaN
+ * with the most significant fraction bit clear.
+ * 
+ * @param bits bits of the double precision value.
+ * @return true if the value is a signaling NaN.
+ */
+bool fregisterfile::is_snan_d(uint64_t bits)
+{
+    return (bits & 0x7ff0000000000000) == 0x7ff0000000000000 && (bits & 0x000fffffffffffff) != 0 && !(bits & 0x0008000000000000);
+}
+
+/**
+ * @brief Method to dump the registers, four 64-bit registers per line.
+ * 
+ * @param hdr string that must be printed at beginning line.
+ */
+void fregisterfile::dump(const std::string &hdr) const
+{
+    for (size_t regr = 0; regr < regs.size(); regr += 4)
+    {
+        //format string for row header
+        std::string f = "f" + std::to_string(regr);
+
+        //print out header with proper formatting
+        std::cout << hdr;
+        std::cout << std::setw(3) << std::setfill(' ') << std::right << f;
+
+        //print the four register values in the current row
+        for (size_t col = 0; col < 4; col++)
+        {
+            uint64_t val = regs.at(regr + col);
+            std::cout << " " << to_hex32(val >> 32) << to_hex32(val & 0xffffffff);
+        }
+        std::cout << std::endl;
+    }
+}
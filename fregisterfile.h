@@ -0,0 +1,58 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+#ifndef FREGISTERFILE_H
+#define FREGISTERFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "hex.h"
+
+/**
+ * The 32 floating point registers of the F and D extensions. Each register
+ * is 64 bits wide. Single precision values are NaN-boxed: stored in the low
+ * 32 bits with the upper 32 bits all ones. Reading a single precision value
+ * from a register that is not properly boxed gives the canonical NaN.
+ ********************************************************************************/
+class fregisterfile : public hex
+{
+public:
+    fregisterfile();
+
+    void reset();
+
+    void set(uint32_t r, uint64_t val);
+    uint64_t get(uint32_t r) const;
+
+    void set_bits_s(uint32_t r, uint32_t val);
+    uint32_t get_bits_s(uint32_t r) const;
+
+    void set_s(uint32_t r, float val);
+    float get_s(uint32_t r) const;
+    void set_d(uint32_t r, double val);
+    double get_d(uint32_t r) const;
+
+    void dump(const std::string &hdr) const;
+
+    static bool is_snan_s(uint32_t bits);
+    static bool is_snan_d(uint64_t bits);
+
+    static constexpr uint32_t canonical_nan_s = 0x7fc00000;
+    static constexpr uint64_t canonical_nan_d = 0x7ff8000000000000;
+
+private:
+    std::vector<uint64_t> regs;
+};
+
+#endif
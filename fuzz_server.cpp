@@ -0,0 +1,188 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#include "fuzz_server.h"
+#include <cstring>      //memset strncpy
+#include <fstream>
+#include <iterator>
+#include <sys/mman.h>   //mmap
+#include <sys/wait.h>   //waitpid
+#include <unistd.h>     //fork _exit
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+/**
+ * @brief Construct a new fuzz_server object.
+ * 
+ * @param mem memory holding the loaded program.
+ * @param marker_pc pc at which the snapshot is taken.
+ * @param buffer_addr guest address that each input is copied to.
+ */
+fuzz_server::fuzz_server(memory &mem, uint32_t marker_pc, uint32_t buffer_addr) :
+    cpu_single_hart(mem), marker_pc(marker_pc), buffer_addr(buffer_addr), seen(coverage_size, 0)
+{
+    //the result must survive the child so put it in shared memory
+    void *p = mmap(nullptr, sizeof(result), PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+    if (p != MAP_FAILED)
+    {
+        shared = static_cast<result*>(p);
+    }
+}
+
+/**
+ * @brief Destroy the fuzz_server object and release the shared result.
+ */
+fuzz_server::~fuzz_server()
+{
+    if (shared)
+    {
+        munmap(shared, sizeof(result));
+    }
+}
+
+/**
+ * @brief Method to run the program from reset up to the marker pc. The
+ * state at that point becomes the snapshot every input starts from.
+ * 
+ * @param exec_limit maximum number of instructions to reach the marker.
+ * @return true if the marker was reached.
+ */
+bool fuzz_server::run_to_marker(uint64_t exec_limit)
+{
+    start();
+
+    while (!is_halted() && get_pc() != marker_pc && (exec_limit == 0 || get_insn_counter() < exec_limit))
+    {
+        tick();
+    }
+
+    if (get_pc() != marker_pc || is_halted())
+    {
+        cerr << "Marker " << to_hex0x32(marker_pc) << " not reached. Reason: " << get_halt_reason() << endl;
+        return false;
+    }
+
+    flush_output();
+    cout << "Snapshot at " << to_hex0x32(marker_pc) << " after " << get_insn_counter() << " instructions" << endl;
+    return shared != nullptr;
+}
+
+/**
+ * @brief Method to run one input from the snapshot in a forked child and
+ * print the halt reason and coverage it reached.
+ * 
+ * @param fname name of the input file.
+ * @param exec_limit maximum number of instructions per input.
+ * @return true if the input was run.
+ */
+bool fuzz_server::run_input(const std::string &fname, uint64_t exec_limit)
+{
+    std::ifstream infile(fname, std::ios::in|std::ios::binary);
+    if (!infile.is_open())
+    {
+        cerr << "Can't open file '" << fname << "' for reading." << endl;
+        return false;
+    }
+    std::vector<uint8_t> input((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+
+    memset(shared, 0, sizeof(result));
+
+    //flush so buffered output is not written twice
+    cout.flush();
+    flush_output();
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        cerr << "fork() failed" << endl;
+        return false;
+    }
+    if (pid == 0)
+    {
+        //_exit() skips the destructors that would flush the devices
+        run_child(input, exec_limit);
+        flush_output();
+        cout.flush();
+        _exit(0);
+    }
+
+    int status;
+    waitpid(pid, &status, 0);
+
+    //count edges and the ones no earlier input reached
+    uint32_t edges = 0;
+    uint32_t new_edges = 0;
+    for (uint32_t i = 0; i < coverage_size; i++)
+    {
+        if (shared->coverage[i])
+        {
+            edges++;
+            if (!seen[i])
+            {
+                seen[i] = 1;
+                new_edges++;
+            }
+        }
+    }
+
+    cout << fname << ": " << shared->insn_counter << " instructions, " << edges << " edges (" << new_edges << " new), ";
+    if (!WIFEXITED(status))
+    {
+        cout << "simulator crashed" << endl;
+    }
+    else if (shared->halted)
+    {
+        cout << "Reason: " << shared->halt_reason << endl;
+    }
+    else
+    {
+        cout << "exec limit reached" << endl;
+    }
+    return true;
+}
+
+/**
+ * @brief Method run in the forked child. Injects the input and runs until
+ * the hart halts or the exec limit is reached, recording an AFL-style
+ * hash of every edge taken.
+ * 
+ * @param input bytes to copy to the guest buffer.
+ * @param exec_limit maximum number of instructions to run.
+ */
+void fuzz_server::run_child(const std::vector<uint8_t> &input, uint64_t exec_limit)
+{
+    for (uint32_t i = 0; i < input.size(); i++)
+    {
+        mem.set8(buffer_addr + i, input[i]);
+    }
+    regs.set(10, buffer_addr);
+    regs.set(11, input.size());
+
+    uint64_t start_count = get_insn_counter();
+    uint32_t prev = 0;
+
+    while (!is_halted() && (exec_limit == 0 || get_insn_counter() - start_count < exec_limit))
+    {
+        //compressed instructions are only 2 byte aligned
+        uint32_t cur = (get_pc() >> 1) & (coverage_size - 1);
+        uint8_t &hit = shared->coverage[cur ^ prev];
+        hit += (hit != 0xff);
+        prev = cur >> 1;
+
+        tick();
+    }
+
+    shared->insn_counter = get_insn_counter() - start_count;
+    shared->halted = is_halted();
+    strncpy(shared->halt_reason, get_halt_reason().c_str(), sizeof(shared->halt_reason) - 1);
+}
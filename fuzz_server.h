@@ -0,0 +1,58 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#ifndef FUZZ_SERVER_H
+#define FUZZ_SERVER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cpu_single_hart.h"
+
+/**
+ * Fork server for fuzzing a guest program. The program is run once up to a
+ * marker pc and the whole simulator is then forked for every input, so each
+ * input starts from the same snapshot without reloading the image. The
+ * input is copied into a guest buffer with a0 = buffer address and
+ * a1 = length. Edge coverage is collected into a bitmap shared with the
+ * parent process.
+ ********************************************************************************/
+class fuzz_server : public cpu_single_hart
+{
+public:
+    fuzz_server(memory &mem, uint32_t marker_pc, uint32_t buffer_addr);
+    ~fuzz_server();
+
+    bool run_to_marker(uint64_t exec_limit);
+    bool run_input(const std::string &fname, uint64_t exec_limit);
+
+    static constexpr uint32_t coverage_size = 0x10000;
+
+private:
+    /// state the child hands back to the parent
+    struct result
+    {
+        uint64_t insn_counter;
+        uint32_t halted;
+        char halt_reason[64];
+        uint8_t coverage[coverage_size];
+    };
+
+    void run_child(const std::vector<uint8_t> &input, uint64_t exec_limit);
+
+    uint32_t marker_pc;
+    uint32_t buffer_addr;
+    result *shared = { nullptr };
+    std::vector<uint8_t> seen;          ///< every edge seen by any input so far
+};
+
+#endif
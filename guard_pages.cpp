@@ -0,0 +1,175 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+
+#include "guard_pages.h"
+#include <sys/mman.h>   //mmap mprotect munmap
+#include <unistd.h>     //sysconf
+#include <cstring>      //memset
+#include <mutex>        //call_once
+
+namespace
+{
+    //the reservation and landing point of the thread's running hart
+    thread_local const uint8_t *armed_base = nullptr;
+    thread_local sigjmp_buf *armed_landing = nullptr;
+
+    std::once_flag handler_installed;
+}
+
+/**
+ * @brief Method to reserve the guest address space and make the first len
+ * bytes of it usable. The first time it is called the SIGSEGV handler is
+ * installed.
+ * 
+ * @param len bytes of RAM. They end on a host page boundary so the byte
+ * after the last one faults.
+ * @return uint8_t* first byte of the RAM, nullptr if the host refused.
+ */
+uint8_t *guard_pages::reserve(size_t len)
+{
+    //one page to shift the RAM in, the guest address space and one page
+    //for accesses that start near its end
+    size_t page = host_page();
+    size_t usable = (len + page - 1) / page * page;
+
+    void *p = mmap(nullptr, guest_size + 2 * page, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    if (usable != 0 && mprotect(p, usable, PROT_READ | PROT_WRITE) != 0)
+    {
+        munmap(p, guest_size + 2 * page);
+        return nullptr;
+    }
+
+    //SA_NODEFER because the handler never returns, it jumps out and leaves
+    //SIGSEGV unblocked for the next fault
+    std::call_once(handler_installed, []()
+    {
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_sigaction = on_fault;
+        sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGSEGV, &sa, nullptr);
+    });
+
+    return static_cast<uint8_t*>(p) + (usable - len);
+}
+
+/**
+ * @brief Method to give a reservation back to the host.
+ * 
+ * @param base first byte of the RAM, as returned by reserve().
+ */
+void guard_pages::release(uint8_t *base)
+{
+    //the RAM was shifted by less than a page from the page aligned start
+    size_t page = host_page();
+    munmap(base - reinterpret_cast<uintptr_t>(base) % page, guest_size + 2 * page);
+}
+
+/**
+ * @brief Method to return the size of a host page.
+ * 
+ * @return size_t page size in bytes.
+ */
+size_t guard_pages::host_page()
+{
+    static const size_t page = sysconf(_SC_PAGESIZE);
+    return page;
+}
+
+/**
+ * @brief Method to set the landing point of the calling thread. Until
+ * disarm() a fault anywhere in the reservation at base jumps to it.
+ * 
+ * @param base start of the reservation.
+ * @param landing point set with sigsetjmp() that the handler jumps to.
+ */
+void guard_pages::arm(const uint8_t *base, sigjmp_buf *landing)
+{
+    armed_base = base;
+    armed_landing = landing;
+}
+
+/**
+ * @brief Method to clear the landing point of the calling thread.
+ */
+void guard_pages::disarm()
+{
+    armed_landing = nullptr;
+    armed_base = nullptr;
+}
+
+/**
+ * @brief SIGSEGV handler. A fault in the armed reservation jumps to the
+ * landing point. Anything else is a real crash, so the default action is
+ * put back and the faulting instruction runs again to get it.
+ * 
+ * @param sig SIGSEGV.
+ * @param info holds the faulting address.
+ * @param context unused.
+ */
+void guard_pages::on_fault(int sig, siginfo_t *info, void *context)
+{
+    (void)context;
+
+    const uint8_t *addr = static_cast<const uint8_t*>(info->si_addr);
+    if (armed_landing && addr >= armed_base && (uint64_t)(addr - armed_base) < guest_size + host_page())
+    {
+        sigjmp_buf *landing = armed_landing;
+        armed_landing = nullptr;
+        siglongjmp(*landing, 1);
+    }
+
+    signal(sig, SIG_DFL);
+}
+
+/**
+ * @brief Method to allocate the bytes of the memory vector.
+ * 
+ * @param n number of bytes.
+ * @return uint8_t* first byte.
+ */
+uint8_t *guard_allocator::allocate(size_t n)
+{
+    if (guard)
+    {
+        uint8_t *p = guard_pages::reserve(n);
+        if (p)
+        {
+            return p;
+        }
+        guard = false;
+    }
+    return std::allocator<uint8_t>().allocate(n);
+}
+
+/**
+ * @brief Method to free the bytes of the memory vector.
+ * 
+ * @param p first byte.
+ * @param n number of bytes.
+ */
+void guard_allocator::deallocate(uint8_t *p, size_t n)
+{
+    if (guard)
+    {
+        guard_pages::release(p);
+        return;
+    }
+    std::allocator<uint8_t>().deallocate(p, n);
+}
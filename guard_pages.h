@@ -0,0 +1,77 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+
+
+#ifndef GUARD_PAGES_H
+#define GUARD_PAGES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <setjmp.h>
+#include <signal.h>
+
+/**
+ * Host side of the guard page memory backend. The RAM is placed at the
+ * start of a reservation that spans the whole 32 bit guest address space
+ * plus one page, and everything past the RAM is PROT_NONE. Host code can
+ * then index the RAM with any guest address and no range check: one that
+ * is not in the RAM raises SIGSEGV instead of reading something else. The
+ * RAM is shifted into its first host page so that it ends on a page
+ * boundary, otherwise the tail of its last page would be usable too.
+ *
+ * A thread that accesses the reservation that way arms a landing point
+ * first. The SIGSEGV handler jumps back to it when the fault is inside the
+ * reservation, and leaves every other fault alone.
+ ********************************************************************************/
+class guard_pages
+{
+public:
+    static constexpr uint64_t guest_size = (uint64_t)1 << 32;
+
+    static uint8_t *reserve(size_t len);
+    static void release(uint8_t *base);
+
+    static void arm(const uint8_t *base, sigjmp_buf *landing);
+    static void disarm();
+
+private:
+    static void on_fault(int sig, siginfo_t *info, void *context);
+    static size_t host_page();
+};
+
+/**
+ * Allocator for the memory vector. With guard set the bytes come from
+ * guard_pages::reserve(), and if the host will not give that much address
+ * space it quietly becomes a plain allocator.
+ ********************************************************************************/
+class guard_allocator
+{
+public:
+    using value_type = uint8_t;
+    template<class U> struct rebind { using other = guard_allocator; };
+
+    guard_allocator(bool guard = false) : guard(guard) { }
+
+    uint8_t *allocate(size_t n);
+    void deallocate(uint8_t *p, size_t n);
+
+    bool is_guarded() const { return guard; }
+    bool operator==(const guard_allocator &other) const { return guard == other.guard; }
+    bool operator!=(const guard_allocator &other) const { return guard != other.guard; }
+
+private:
+    bool guard;
+};
+
+#endif
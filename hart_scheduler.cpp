@@ -0,0 +1,219 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#include "hart_scheduler.h"
+#include <thread>
+
+/**
+ * @brief Construct a new hart_scheduler object.
+ * 
+ * @param threads number of host threads to run harts on. Zero selects
+ * the number of host cores.
+ * @param slice number of instructions a hart runs before it is requeued.
+ */
+hart_scheduler::hart_scheduler(unsigned threads, uint64_t slice) : slice(slice)
+{
+    //default to one worker per host core
+    if (threads == 0)
+    {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+
+    for (unsigned i = 0; i < threads; i++)
+    {
+        workers.emplace_back(new worker);
+    }
+
+    if (this->slice == 0)
+    {
+        this->slice = default_slice;
+    }
+}
+
+/**
+ * @brief Method to add a hart to the scheduler. Harts are dealt out
+ * round robin so every worker starts with a share of the work.
+ * 
+ * @param h hart to schedule. It must outlive the scheduler.
+ */
+void hart_scheduler::add(cpu_single_hart *h)
+{
+    //set the stack pointer the same way cpu_single_hart::run() does
+    h->start();
+
+    harts.push_back(h);
+    push(next, h);
+    next = (next + 1) % workers.size();
+    runnable++;
+}
+
+/**
+ * @brief Method to run every hart until each one has halted or reached
+ * its exec limit.
+ * 
+ * @param exec_limit maximum number of instructions per hart (zero means
+ * no limit).
+ */
+void hart_scheduler::run(uint64_t exec_limit)
+{
+    std::vector<std::thread> threads;
+
+    for (unsigned i = 0; i < workers.size(); i++)
+    {
+        threads.emplace_back(&hart_scheduler::work, this, i, exec_limit);
+    }
+
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+}
+
+/**
+ * @brief Method to return the number of instructions executed by all harts.
+ * 
+ * @return uint64_t aggregate instruction count.
+ */
+uint64_t hart_scheduler::get_insn_counter() const
+{
+    uint64_t total = 0;
+    for (const cpu_single_hart *h : harts)
+    {
+        total += h->get_insn_counter();
+    }
+    return total;
+}
+
+/**
+ * @brief Method to take the most recently queued hart from a worker's
+ * own deque.
+ * 
+ * @param self index of the calling worker.
+ * @param h set to the hart that was dequeued.
+ * @return true if a hart was dequeued.
+ */
+bool hart_scheduler::pop(unsigned self, cpu_single_hart *&h)
+{
+    worker &w = *workers[self];
+    std::lock_guard<std::mutex> guard(w.lock);
+
+    if (w.queue.empty())
+    {
+        return false;
+    }
+
+    h = w.queue.back();
+    w.queue.pop_back();
+    queued--;
+    return true;
+}
+
+/**
+ * @brief Method to take the oldest hart from another worker's deque.
+ * 
+ * @param self index of the calling worker.
+ * @param h set to the hart that was stolen.
+ * @return true if a hart was stolen.
+ */
+bool hart_scheduler::steal(unsigned self, cpu_single_hart *&h)
+{
+    for (unsigned i = 1; i < workers.size(); i++)
+    {
+        worker &victim = *workers[(self + i) % workers.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+
+        if (!victim.queue.empty())
+        {
+            h = victim.queue.front();
+            victim.queue.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Method to queue a runnable hart on a worker's deque and wake a
+ * worker that has nothing to run.
+ * 
+ * @param self index of the worker.
+ * @param h hart to queue.
+ */
+void hart_scheduler::push(unsigned self, cpu_single_hart *h)
+{
+    {
+        worker &w = *workers[self];
+        std::lock_guard<std::mutex> guard(w.lock);
+        w.queue.push_back(h);
+        queued++;
+    }
+
+    //taking idle_lock orders the count with a worker about to wait
+    std::lock_guard<std::mutex> guard(idle_lock);
+    wake.notify_one();
+}
+
+/**
+ * @brief Method to park a hart that can no longer run so that no worker
+ * spins on it.
+ * 
+ * @param h hart to park.
+ */
+void hart_scheduler::park(cpu_single_hart *h)
+{
+    {
+        std::lock_guard<std::mutex> guard(parked_lock);
+        parked.push_back(h);
+        runnable--;
+    }
+
+    //the idle workers have to see the last hart go so they can return
+    std::lock_guard<std::mutex> guard(idle_lock);
+    wake.notify_all();
+}
+
+/**
+ * @brief Worker thread loop. Runs slices of its own harts and steals
+ * when idle until no runnable harts remain.
+ * 
+ * @param self index of this worker.
+ * @param exec_limit maximum number of instructions per hart.
+ */
+void hart_scheduler::work(unsigned self, uint64_t exec_limit)
+{
+    cpu_single_hart *h;
+
+    while (runnable != 0)
+    {
+        if (!pop(self, h) && !steal(self, h))
+        {
+            //every remaining hart is being run by another worker, sleep
+            //until one is queued or parked
+            std::unique_lock<std::mutex> guard(idle_lock);
+            wake.wait(guard, [this]() { return runnable == 0 || queued != 0; });
+            continue;
+        }
+
+        if (h->run_slice(slice, exec_limit))
+        {
+            push(self, h);
+        }
+        else
+        {
+            park(h);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#ifndef HART_SCHEDULER_H
+#define HART_SCHEDULER_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <atomic>
+
+#include "cpu_single_hart.h"
+
+/**
+ * Runs many simulated harts on a small pool of host threads. Each hart is
+ * a task that executes a slice of instructions at a time. Every host thread
+ * owns a deque of runnable harts and steals from the other deques when its
+ * own runs dry. Harts that halt, reach the exec limit or wait for an
+ * interrupt are parked and never rescheduled. Nothing raises interrupts
+ * on harts run this way, so a waiting hart would otherwise spin forever.
+ ********************************************************************************/
+class hart_scheduler
+{
+public:
+    hart_scheduler(unsigned threads, uint64_t slice = default_slice);
+
+    void add(cpu_single_hart *h);
+    void run(uint64_t exec_limit);
+
+    uint64_t get_insn_counter() const;
+    size_t get_parked() const { return parked.size(); }
+
+    static constexpr uint64_t default_slice = 10000;
+
+private:
+    struct worker
+    {
+        std::mutex lock;
+        std::deque<cpu_single_hart*> queue;
+    };
+
+    bool pop(unsigned self, cpu_single_hart *&h);
+    bool steal(unsigned self, cpu_single_hart *&h);
+    void push(unsigned self, cpu_single_hart *h);
+    void park(cpu_single_hart *h);
+    void work(unsigned self, uint64_t exec_limit);
+
+    uint64_t slice;
+    unsigned next = { 0 };
+    std::vector<cpu_single_hart*> harts;
+    std::vector<std::unique_ptr<worker>> workers;
+
+    std::mutex parked_lock;
+    std::vector<cpu_single_hart*> parked;
+    std::atomic<size_t> runnable = { 0 };
+
+    std::mutex idle_lock;                   ///< pairs with wake for idle workers
+    std::condition_variable wake;           ///< a hart was queued or parked
+    std::atomic<size_t> queued = { 0 };     ///< harts sitting in the deques
+};
+
+#endif
@@ -0,0 +1,51 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#ifndef HART_STATE_H
+#define HART_STATE_H
+
+#include <cstdint>
+
+/**
+ * Plain copy of everything needed to resume a hart. It has a fixed layout
+ * so it can be written to and mapped from checkpoint files as is.
+ ********************************************************************************/
+struct hart_state
+{
+    uint32_t pc;
+    uint32_t halt;
+    uint64_t insn_counter;
+    int32_t regs[32];
+    char halt_reason[64];
+    uint64_t fregs[32];
+    uint32_t fcsr;
+    uint32_t vlen;
+    uint32_t vl;
+    uint32_t vtype;
+    uint8_t vregs[32 * 128];    ///< 32 registers of up to vregisterfile::max_vlen bits
+    uint64_t cycle_base;
+    uint64_t instret_base;
+    uint32_t mcountinhibit;
+    uint32_t mstatus;
+    uint32_t mie;
+    uint32_t mip;
+    uint32_t mtvec;
+    uint32_t mscratch;
+    uint32_t mepc;
+    uint32_t mcause;
+    uint32_t mtval;
+    uint32_t priv;
+    uint32_t satp;
+    uint32_t mcounteren;
+    uint32_t scounteren;
+};
+
+#endif
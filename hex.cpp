@@ -29,6 +29,21 @@ std::string hex::to_hex8(uint8_t i)
     return os.str();
 }
 
+/**
+ * This function formats a 16 bit integer into a 4 character hex string with
+ * a leading zero.
+ *
+ * @param i unsigned 16 bit integer to be formatted.
+ *
+ * @return string with 4 hex digits representing the 16 bit integer
+ ********************************************************************************/
+std::string hex::to_hex16(uint16_t i)
+{
+    std::ostringstream os;
+    os << std::hex << std::setfill('0') << std::setw(4) << i;
+    return os.str();
+}
+
 /**
  * This function formats an 32 bit integer into a 8 character hex string with
  * a leading zero.
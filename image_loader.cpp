@@ -0,0 +1,518 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+
+#include "image_loader.h"
+#include <fcntl.h>      //open
+#include <sys/mman.h>   //mmap munmap
+#include <sys/stat.h>   //fstat
+#include <unistd.h>     //close
+#include <array>
+#include <algorithm>    //min max
+#include <cstring>      //memchr
+#include <cctype>       //tolower
+#include <functional>   //ref
+#include <iostream>
+#include <thread>
+
+namespace
+{
+    /**
+     * Builds the table that maps an ASCII character to its hex digit value.
+     * Anything that is not a hex digit maps to 0x10, so or'ing the values of
+     * a whole record together shows whether any digit was bad.
+     */
+    constexpr std::array<uint8_t, 256> make_hex_table()
+    {
+        std::array<uint8_t, 256> t = {};
+        for (int c = 0; c < 256; c++)
+        {
+            t[c] = 0x10;
+        }
+        for (int c = 0; c < 10; c++)
+        {
+            t['0' + c] = c;
+        }
+        for (int c = 0; c < 6; c++)
+        {
+            t['a' + c] = 10 + c;
+            t['A' + c] = 10 + c;
+        }
+        return t;
+    }
+
+    constexpr std::array<uint8_t, 256> hex_table = make_hex_table();
+
+    //the longest record is an Intel HEX one with 255 data bytes
+    constexpr uint32_t max_record = 1 + 2 + 1 + 255 + 1;
+}
+
+/**
+ * @brief Construct a new image_loader object.
+ * 
+ * @param mem memory the images are loaded into.
+ */
+image_loader::image_loader(memory &mem) : mem(mem)
+{
+}
+
+/**
+ * @brief Method to tell the format of an image from the extension of its
+ * file name. Anything not known to be Intel HEX or S-records is a flat
+ * binary.
+ * 
+ * @param fname file name of the image.
+ * @return format the image is in.
+ */
+image_loader::format image_loader::get_format(const std::string &fname)
+{
+    std::string::size_type dot = fname.rfind('.');
+    if (dot == std::string::npos)
+    {
+        return format_binary;
+    }
+
+    std::string ext = fname.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (ext == "hex" || ext == "ihex" || ext == "ihx")
+    {
+        return format_ihex;
+    }
+    if (ext == "srec" || ext == "s19" || ext == "s28" || ext == "s37" || ext == "mot")
+    {
+        return format_srec;
+    }
+    return format_binary;
+}
+
+/**
+ * @brief Method to load an image into memory. Flat binaries go through
+ * memory::load_file(), Intel HEX and S-record files are decoded here and
+ * their start address, if they have one, is kept for get_entry().
+ * 
+ * @param fname file name of the image.
+ * @return true if the image was loaded.
+ */
+bool image_loader::load(const std::string &fname)
+{
+    format fmt = get_format(fname);
+    if (fmt == format_binary)
+    {
+        return mem.load_file(fname);
+    }
+    return load_text(fname, fmt);
+}
+
+/**
+ * @brief Method to load an Intel HEX or S-record file. The records are
+ * decoded on up to one thread per host core and then written to memory in
+ * file order. Nothing is written if any record is bad.
+ * 
+ * @param fname file name of the image.
+ * @param fmt format_ihex or format_srec.
+ * @return true if the image was loaded.
+ */
+bool image_loader::load_text(const std::string &fname, format fmt)
+{
+    int fd = open(fname.c_str(), O_RDONLY);
+
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0)
+    {
+        std::cerr << "Can't open file '" << fname << "' for reading." << std::endl;
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return false;
+    }
+
+    size_t size = st.st_size;
+    const char *text = nullptr;
+    if (size != 0)
+    {
+        void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED)
+        {
+            std::cerr << "Can't map file '" << fname << "'." << std::endl;
+            close(fd);
+            return false;
+        }
+        text = static_cast<const char*>(p);
+    }
+    close(fd);
+
+    //one chunk per thread, but none smaller than min_chunk
+    size_t threads = std::thread::hardware_concurrency();
+    threads = std::max<size_t>(1, std::min<size_t>(threads, size / min_chunk));
+
+    //move each cut forward to the start of the next line
+    std::vector<chunk> chunks;
+    const char *begin = text;
+    for (size_t i = 0; i < threads && begin < text + size; i++)
+    {
+        const char *end = text + size;
+        if (i + 1 < threads)
+        {
+            const char *cut = std::max(begin, text + size / threads * (i + 1));
+            const char *eol = static_cast<const char*>(memchr(cut, '\n', text + size - cut));
+            end = eol ? eol + 1 : text + size;
+        }
+
+        chunks.emplace_back();
+        chunks.back().begin = begin;
+        chunks.back().end = end;
+        begin = end;
+    }
+
+    //decode the chunks, the first one on this thread
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < chunks.size(); i++)
+    {
+        workers.emplace_back(&image_loader::parse, std::ref(chunks[i]), fmt);
+    }
+    if (!chunks.empty())
+    {
+        parse(chunks[0], fmt);
+    }
+    for (auto &t : workers)
+    {
+        t.join();
+    }
+
+    if (text)
+    {
+        munmap(const_cast<char*>(text), size);
+    }
+
+    //report the first bad record before anything is written
+    uint32_t line = 0;
+    for (const chunk &c : chunks)
+    {
+        if (!c.error.empty())
+        {
+            std::cerr << fname << ":" << line + c.error_line << ": " << c.error << std::endl;
+            return false;
+        }
+        if (c.eof)
+        {
+            break;
+        }
+        line += c.lines;
+    }
+
+    //write the segments in file order, relocating the ones that depend on
+    //the extended address of an earlier chunk
+    uint32_t base = 0;
+    uint64_t image_end = 0;
+    line = 0;
+    for (const chunk &c : chunks)
+    {
+        for (const segment &s : c.segments)
+        {
+            uint32_t addr = s.addr + (s.relative ? base : 0);
+            if (!mem.write_block(addr, c.data.data() + s.offset, s.len))
+            {
+                std::cerr << fname << ":" << line + s.line << ": data from this record on does not fit in memory." << std::endl;
+                return false;
+            }
+            image_end = std::max<uint64_t>(image_end, (uint64_t)addr + s.len);
+        }
+
+        if (c.sets_base)
+        {
+            base = c.base;
+        }
+        if (c.entry_valid)
+        {
+            entry_valid = true;
+            entry = c.entry;
+        }
+        if (c.eof)
+        {
+            break;
+        }
+        line += c.lines;
+    }
+
+    mem.set_image_size(image_end);
+    return true;
+}
+
+/**
+ * @brief Method to decode every record of a chunk. It runs on a worker
+ * thread and only touches the chunk. Blank lines are skipped and the
+ * first bad record stops the chunk with an error.
+ * 
+ * @param c chunk to decode.
+ * @param fmt format_ihex or format_srec.
+ */
+void image_loader::parse(chunk &c, format fmt)
+{
+    uint8_t rec[max_record];
+    const char *p = c.begin;
+    uint32_t line = 0;
+
+    while (p < c.end && !c.eof)
+    {
+        const char *eol = static_cast<const char*>(memchr(p, '\n', c.end - p));
+        if (!eol)
+        {
+            eol = c.end;
+        }
+        line++;
+
+        //trim the line, it may come from a DOS file
+        const char *q = p;
+        const char *e = eol;
+        p = eol + 1;
+        while (q < e && (*q == ' ' || *q == '\t'))
+        {
+            q++;
+        }
+        while (e > q && (e[-1] == '\r' || e[-1] == ' ' || e[-1] == '\t'))
+        {
+            e--;
+        }
+        if (q == e)
+        {
+            continue;
+        }
+
+        //the record mark, and for S-records the type digit
+        char type = 0;
+        if (fmt == format_ihex ? *q != ':' : (*q != 'S' || e - q < 2))
+        {
+            c.error = "not a record.";
+            c.error_line = line;
+            return;
+        }
+        if (fmt == format_srec)
+        {
+            type = q[1];
+            q++;
+        }
+        q++;
+
+        //decode two digits per byte through the table
+        uint32_t n = (e - q) / 2;
+        if ((e - q) % 2 || n > max_record)
+        {
+            c.error = "bad record length.";
+            c.error_line = line;
+            return;
+        }
+
+        uint8_t bad = 0;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint8_t hi = hex_table[(uint8_t)q[2 * i]];
+            uint8_t lo = hex_table[(uint8_t)q[2 * i + 1]];
+            bad |= hi | lo;
+            rec[i] = hi << 4 | lo;
+        }
+        if (bad & 0x10)
+        {
+            c.error = "bad hex digit.";
+            c.error_line = line;
+            return;
+        }
+
+        if (!(fmt == format_ihex ? parse_ihex(c, rec, n, line) : parse_srec(c, type, rec, n, line)))
+        {
+            c.error_line = line;
+            return;
+        }
+    }
+
+    c.lines = line;
+}
+
+/**
+ * @brief Method to act on one decoded Intel HEX record: a byte count, a
+ * 16 bit offset, a type, the data and a checksum that makes all the bytes
+ * add up to 0.
+ * 
+ * @param c chunk the record is in.
+ * @param rec bytes of the record.
+ * @param n number of bytes.
+ * @param line line of the record within the chunk.
+ * @return true if the record is good, otherwise c.error says why.
+ */
+bool image_loader::parse_ihex(chunk &c, const uint8_t *rec, uint32_t n, uint32_t line)
+{
+    if (n < 5 || n != rec[0] + 5u)
+    {
+        c.error = "byte count does not match the record length.";
+        return false;
+    }
+
+    uint8_t sum = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        sum += rec[i];
+    }
+    if (sum != 0)
+    {
+        c.error = "bad checksum.";
+        return false;
+    }
+
+    uint32_t len = rec[0];
+    uint32_t offset = rec[1] << 8 | rec[2];
+    const uint8_t *data = rec + 4;
+
+    switch (rec[3])
+    {
+        case 0x00:  //data, relative to the extended address
+            add_data(c, (c.sets_base ? c.base : 0) + offset, data, len, line, !c.sets_base);
+            return true;
+
+        case 0x01:  //end of file
+            c.eof = true;
+            return true;
+
+        case 0x02:  //extended segment address
+        case 0x04:  //extended linear address
+            if (len != 2)
+            {
+                break;
+            }
+            c.sets_base = true;
+            c.base = (data[0] << 8 | data[1]) << ((rec[3] == 0x02) ? 4 : 16);
+            return true;
+
+        case 0x03:  //start segment address, CS:IP
+            if (len != 4)
+            {
+                break;
+            }
+            c.entry_valid = true;
+            c.entry = (data[0] << 8 | data[1]) * 16 + (data[2] << 8 | data[3]);
+            return true;
+
+        case 0x05:  //start linear address
+            if (len != 4)
+            {
+                break;
+            }
+            c.entry_valid = true;
+            c.entry = (uint32_t)data[0] << 24 | data[1] << 16 | data[2] << 8 | data[3];
+            return true;
+    }
+
+    c.error = "bad record type.";
+    return false;
+}
+
+/**
+ * @brief Method to act on one decoded S-record: a byte count, a 16, 24 or
+ * 32 bit address, the data and a checksum that makes all the bytes add up
+ * to 0xff.
+ * 
+ * @param c chunk the record is in.
+ * @param type record type digit after the S.
+ * @param rec bytes of the record.
+ * @param n number of bytes.
+ * @param line line of the record within the chunk.
+ * @return true if the record is good, otherwise c.error says why.
+ */
+bool image_loader::parse_srec(chunk &c, char type, const uint8_t *rec, uint32_t n, uint32_t line)
+{
+    if (n < 1 || n != rec[0] + 1u)
+    {
+        c.error = "byte count does not match the record length.";
+        return false;
+    }
+
+    uint8_t sum = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        sum += rec[i];
+    }
+    if (sum != 0xff)
+    {
+        c.error = "bad checksum.";
+        return false;
+    }
+
+    //width of the address field of each type, 0 for unknown types
+    static const uint32_t addr_size[] = { 2, 2, 3, 4, 0, 2, 3, 4, 3, 2 };
+    uint32_t w = (type >= '0' && type <= '9') ? addr_size[type - '0'] : 0;
+    if (w == 0)
+    {
+        c.error = "bad record type.";
+        return false;
+    }
+    if (n < w + 2)
+    {
+        c.error = "record too short for its address.";
+        return false;
+    }
+
+    uint32_t addr = 0;
+    for (uint32_t i = 0; i < w; i++)
+    {
+        addr = addr << 8 | rec[1 + i];
+    }
+
+    switch (type)
+    {
+        case '1':
+        case '2':
+        case '3':   //data
+            add_data(c, addr, rec + 1 + w, n - w - 2, line, false);
+            break;
+
+        case '7':
+        case '8':
+        case '9':   //start address, which also ends the file
+            c.entry_valid = true;
+            c.entry = addr;
+            c.eof = true;
+            break;
+
+        default:    //the header and record counts carry nothing to load
+            break;
+    }
+    return true;
+}
+
+/**
+ * @brief Method to add the data of a record to a chunk. Data that carries
+ * on from the previous record extends its segment, so a typical image
+ * becomes a few large writes.
+ * 
+ * @param c chunk the record is in.
+ * @param addr address of the first byte.
+ * @param p first data byte.
+ * @param len number of data bytes.
+ * @param line line of the record within the chunk.
+ * @param relative true if addr still needs the extended address the chunk
+ * starts with.
+ */
+void image_loader::add_data(chunk &c, uint32_t addr, const uint8_t *p, uint32_t len, uint32_t line, bool relative)
+{
+    if (len == 0)
+    {
+        return;
+    }
+
+    if (c.segments.empty() || c.segments.back().relative != relative || (uint64_t)c.segments.back().addr + c.segments.back().len != addr)
+    {
+        c.segments.push_back({ addr, (uint32_t)c.data.size(), 0, line, relative });
+    }
+
+    c.segments.back().len += len;
+    c.data.insert(c.data.end(), p, p + len);
+}
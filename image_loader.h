@@ -0,0 +1,88 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+
+#ifndef IMAGE_LOADER_H
+#define IMAGE_LOADER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "memory.h"
+
+/**
+ * Loads Intel HEX and Motorola S-record images into memory without
+ * converting them to a flat binary first. The text is mmap'd and cut into
+ * one chunk per host thread at line boundaries. Each thread decodes and
+ * checksums the records of its chunk into address/data segments, then the
+ * segments are written to memory in file order, so a later record that
+ * overlaps an earlier one wins just as it would in a serial loader.
+ *
+ * Intel HEX extended address records apply to the records after them,
+ * which may be in a later chunk. Segments that come before the first
+ * extended address record of a chunk are relocated by the base that the
+ * previous chunks end with once all chunks are decoded.
+ ********************************************************************************/
+class image_loader
+{
+public:
+    enum format { format_binary, format_ihex, format_srec };
+
+    image_loader(memory &mem);
+
+    static format get_format(const std::string &fname);
+    bool load(const std::string &fname);
+
+    bool has_entry() const { return entry_valid; }
+    uint32_t get_entry() const { return entry; }
+
+    static constexpr size_t min_chunk = 0x10000;    ///< smallest chunk worth a thread
+
+private:
+    struct segment
+    {
+        uint32_t addr;
+        uint32_t offset;        ///< first byte in chunk::data
+        uint32_t len;
+        uint32_t line;          ///< line of the first record, within the chunk
+        bool relative;          ///< add the extended address the chunk starts with
+    };
+
+    struct chunk
+    {
+        const char *begin;
+        const char *end;
+        std::vector<segment> segments;
+        std::vector<uint8_t> data;
+        uint32_t lines = { 0 };
+        bool sets_base = { false };     ///< has an Intel HEX extended address record
+        uint32_t base = { 0 };          ///< extended address in effect at the end
+        bool eof = { false };           ///< ends with the end of file record
+        bool entry_valid = { false };
+        uint32_t entry = { 0 };
+        std::string error;              ///< empty if every record decoded
+        uint32_t error_line = { 0 };
+    };
+
+    bool load_text(const std::string &fname, format fmt);
+    static void parse(chunk &c, format fmt);
+    static bool parse_ihex(chunk &c, const uint8_t *rec, uint32_t n, uint32_t line);
+    static bool parse_srec(chunk &c, char type, const uint8_t *rec, uint32_t n, uint32_t line);
+    static void add_data(chunk &c, uint32_t addr, const uint8_t *p, uint32_t len, uint32_t line, bool relative);
+
+    memory &mem;
+    bool entry_valid = { false };
+    uint32_t entry = { 0 };
+};
+
+#endif
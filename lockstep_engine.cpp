@@ -0,0 +1,537 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#include "lockstep_engine.h"
+#include "image_loader.h"
+#include <iostream>
+
+using std::cout;
+using std::endl;
+
+/**
+ * @brief Construct a new lockstep_engine object.
+ * 
+ * @param lanes number of harts that run the program.
+ * @param mem_size size of each hart's memory.
+ */
+lockstep_engine::lockstep_engine(uint32_t lanes, uint32_t mem_size) : lanes(lanes)
+{
+    //round the lane count up so every row is a whole number of SIMD blocks
+    width = (lanes + lane_block - 1) / lane_block * lane_block;
+
+    for (uint32_t l = 0; l < lanes; l++)
+    {
+        mems.emplace_back(new memory(mem_size));
+    }
+
+    //same reset state as registerfile::reset() with the stack pointer set
+    //the same way as cpu_single_hart::run()
+    regs.assign(32 * width, 0xf0f0f0f0);
+    std::fill(reg(0), reg(0) + width, 0);
+    std::fill(reg(2), reg(2) + width, mems.empty() ? 0 : mems[0]->get_size());
+
+    pc.assign(width, 0);
+    mask.assign(width, 0);
+    halted.assign(width, 1);
+    std::fill(halted.begin(), halted.begin() + lanes, 0);
+    halt_reason.assign(lanes, "none");
+    insn_counter.assign(lanes, 0);
+}
+
+/**
+ * @brief Method to load the program image into the memory of every lane.
+ * Intel HEX and S-record files are loaded the same way as for a single
+ * hart, and every lane starts at their entry point if they set one.
+ * 
+ * @param fname name of the program file.
+ * @return true if every lane loaded the file.
+ */
+bool lockstep_engine::load_file(const std::string &fname)
+{
+    for (auto &m : mems)
+    {
+        image_loader loader(*m);
+        if (!loader.load(fname))
+        {
+            return false;
+        }
+
+        if (loader.has_entry())
+        {
+            std::fill(pc.begin(), pc.begin() + lanes, loader.get_entry());
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Method to run every lane until it halts or reaches the exec limit.
+ * 
+ * @param exec_limit maximum number of instructions per lane (zero means
+ * no limit).
+ */
+void lockstep_engine::run(uint64_t exec_limit)
+{
+    while (select_group(exec_limit))
+    {
+        //every lane in the group shares the pc so they all fetch the same insn
+        if ((group_pc & 3) != 0)
+        {
+            exec_halt("PC alignment error");
+            continue;
+        }
+
+        uint32_t first = 0;
+        while (!mask[first])
+        {
+            first++;
+        }
+
+        for (uint32_t l = 0; l < lanes; l++)
+        {
+            insn_counter[l] += mask[l] ? 1 : 0;
+        }
+        issue_counter++;
+
+        exec(mems[first]->get32(group_pc));
+    }
+
+    uint32_t count = 0;
+    for (uint32_t l = 0; l < lanes; l++)
+    {
+        count += halted[l];
+    }
+
+    cout << count << " of " << lanes << " lanes halted" << endl;
+    cout << get_insn_counter() << " instructions executed in " << issue_counter << " issues" << endl;
+}
+
+/**
+ * @brief Method to dump the registers, pc and halt reason of every lane.
+ */
+void lockstep_engine::dump() const
+{
+    for (uint32_t l = 0; l < lanes; l++)
+    {
+        std::string hdr = "[" + std::to_string(l) + "] ";
+
+        //same layout as registerfile::dump()
+        for (uint32_t r = 0; r < 32; r++)
+        {
+            if (r % 8 == 0)
+            {
+                std::string x = "x" + std::to_string(r);
+                cout << hdr << std::string(x.size() < 3 ? 3 - x.size() : 0, ' ') << x;
+            }
+            cout << (r % 8 == 4 ? "  " : " ") << to_hex32(reg(r)[l]);
+            if (r % 8 == 7)
+            {
+                cout << endl;
+            }
+        }
+        cout << hdr << " pc " << to_hex32(pc[l]) << "  " << halt_reason[l] << endl;
+    }
+}
+
+/**
+ * @brief Method to return the number of instructions executed by all lanes.
+ * 
+ * @return uint64_t aggregate instruction count.
+ */
+uint64_t lockstep_engine::get_insn_counter() const
+{
+    uint64_t total = 0;
+    for (uint64_t n : insn_counter)
+    {
+        total += n;
+    }
+    return total;
+}
+
+/**
+ * @brief Method to select the next group of lanes to execute. The group is
+ * every runnable lane at the lowest pc, which lets lanes that branched
+ * ahead wait for the others to catch up.
+ * 
+ * @param exec_limit maximum number of instructions per lane.
+ * @return true if a group was selected, false if no lane can run.
+ */
+bool lockstep_engine::select_group(uint64_t exec_limit)
+{
+    bool found = false;
+
+    for (uint32_t l = 0; l < lanes; l++)
+    {
+        if (!halted[l] && (exec_limit == 0 || insn_counter[l] < exec_limit) && (!found || pc[l] < group_pc))
+        {
+            group_pc = pc[l];
+            found = true;
+        }
+    }
+
+    for (uint32_t l = 0; l < lanes; l++)
+    {
+        mask[l] = (!halted[l] && (exec_limit == 0 || insn_counter[l] < exec_limit) && pc[l] == group_pc) ? -1 : 0;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Method to execute an instruction for every lane in the group.
+ * Follows the same decode tree as rv32i_hart::exec().
+ * 
+ * @param insn RV32I instruction to be executed.
+ */
+void lockstep_engine::exec(uint32_t insn)
+{
+    uint32_t funct3 = get_funct3(insn);
+    uint32_t funct7 = get_funct7(insn);
+    int32_t imm_i = get_imm_i(insn);
+
+    switch(get_opcode(insn))
+    {
+        default:  exec_halt("Illegal instruction"); return;
+
+        case opcode_lui:   exec_alu_imm(insn, get_imm_u(insn), [](int32_t, int32_t imm) { return imm; }); return;
+        case opcode_auipc:  exec_alu_imm(insn, group_pc + get_imm_u(insn), [](int32_t, int32_t imm) { return imm; }); return;
+        case opcode_jal:  exec_jal(insn); return;
+        case opcode_jalr:  exec_jalr(insn); return;
+
+        case opcode_btype:
+            switch (funct3)
+            {
+                default:  exec_halt("Illegal instruction"); return;
+                case funct3_beq:  exec_branch(insn, [](int32_t a, int32_t b) { return a == b; }); return;
+                case funct3_bne:  exec_branch(insn, [](int32_t a, int32_t b) { return a != b; }); return;
+                case funct3_blt:  exec_branch(insn, [](int32_t a, int32_t b) { return a < b; }); return;
+                case funct3_bge:  exec_branch(insn, [](int32_t a, int32_t b) { return a >= b; }); return;
+                case funct3_bltu:  exec_branch(insn, [](int32_t a, int32_t b) { return (uint32_t)a < (uint32_t)b; }); return;
+                case funct3_bgeu:  exec_branch(insn, [](int32_t a, int32_t b) { return (uint32_t)a >= (uint32_t)b; }); return;
+            }
+
+        case opcode_load_imm:  exec_load(insn); return;
+        case opcode_stype:  exec_store(insn); return;
+
+        case opcode_alu_imm:
+            switch (funct3)
+            {
+                default:  exec_halt("Illegal instruction"); return;
+                case funct3_add:  exec_alu_imm(insn, imm_i, [](int32_t a, int32_t b) { return a + b; }); return;
+                case funct3_sll:  exec_alu_imm(insn, imm_i & 0x1f, [](int32_t a, int32_t b) { return (int32_t)((uint32_t)a << b); }); return;
+                case funct3_slt:  exec_alu_imm(insn, imm_i, [](int32_t a, int32_t b) { return (int32_t)(a < b); }); return;
+                case funct3_sltu:  exec_alu_imm(insn, imm_i, [](int32_t a, int32_t b) { return (int32_t)((uint32_t)a < (uint32_t)b); }); return;
+                case funct3_xor:  exec_alu_imm(insn, imm_i, [](int32_t a, int32_t b) { return a ^ b; }); return;
+                case funct3_or:  exec_alu_imm(insn, imm_i, [](int32_t a, int32_t b) { return a | b; }); return;
+                case funct3_and:  exec_alu_imm(insn, imm_i, [](int32_t a, int32_t b) { return a & b; }); return;
+
+                case funct3_srx:
+                    switch(funct7)
+                    {
+                        default:  exec_halt("Illegal instruction"); return;
+                        case funct7_srl:  exec_alu_imm(insn, imm_i & 0x1f, [](int32_t a, int32_t b) { return (int32_t)((uint32_t)a >> b); }); return;
+                        case funct7_sra:  exec_alu_imm(insn, imm_i & 0x1f, [](int32_t a, int32_t b) { return a >> b; }); return;
+                    }
+            }
+
+        case opcode_rtype:
+            switch (funct3)
+            {
+                default:  exec_halt("Illegal instruction"); return;
+                case funct3_add:
+                        switch(funct7)
+                        {
+                            default:  exec_halt("Illegal instruction"); return;
+                            case funct7_add:  exec_alu_reg(insn, [](int32_t a, int32_t b) { return (int32_t)((uint32_t)a + (uint32_t)b); }); return;
+                            case funct7_sub:  exec_alu_reg(insn, [](int32_t a, int32_t b) { return (int32_t)((uint32_t)a - (uint32_t)b); }); return;
+                        }
+
+                case funct3_sll:  exec_alu_reg(insn, [](int32_t a, int32_t b) { return (int32_t)((uint32_t)a << (b & 0x1f)); }); return;
+                case funct3_slt:  exec_alu_reg(insn, [](int32_t a, int32_t b) { return (int32_t)(a < b); }); return;
+                case funct3_sltu:  exec_alu_reg(insn, [](int32_t a, int32_t b) { return (int32_t)((uint32_t)a < (uint32_t)b); }); return;
+                case funct3_xor:  exec_alu_reg(insn, [](int32_t a, int32_t b) { return a ^ b; }); return;
+                case funct3_or:  exec_alu_reg(insn, [](int32_t a, int32_t b) { return a | b; }); return;
+                case funct3_and:  exec_alu_reg(insn, [](int32_t a, int32_t b) { return a & b; }); return;
+
+                case funct3_srx:
+                    switch(funct7)
+                    {
+                        default:  exec_halt("Illegal instruction"); return;
+                        case funct7_sra:  exec_alu_reg(insn, [](int32_t a, int32_t b) { return a >> (b & 0x1f); }); return;
+                        case funct7_srl:  exec_alu_reg(insn, [](int32_t a, int32_t b) { return (int32_t)((uint32_t)a >> (b & 0x1f)); }); return;
+                    }
+            }
+
+        case opcode_system:
+            if (insn == insn_ebreak)
+            {
+                exec_halt("EBREAK instruction");
+                return;
+            }
+
+            //only csrrs rd,mhartid,x0 is supported, the same as rv32i_hart
+            if (funct3 == funct3_csrrs && (imm_i & 0x0fff) == 0xf14 && get_rs1(insn) == 0)
+            {
+                uint32_t rd = get_rd(insn);
+                if (rd != 0)
+                {
+                    for (uint32_t l = 0; l < lanes; l++)
+                    {
+                        reg(rd)[l] = mask[l] ? l : reg(rd)[l];
+                    }
+                }
+                next_pc();
+                return;
+            }
+
+            exec_halt(funct3 == funct3_csrrs ? "Illegal CSR in CSRRS instruction" : "Illegal instruction");
+            return;
+    }
+}
+
+/**
+ * @brief Method to halt every lane in the group.
+ * 
+ * @param reason string that explains why the lanes halted.
+ */
+void lockstep_engine::exec_halt(const char *reason)
+{
+    for (uint32_t l = 0; l < lanes; l++)
+    {
+        if (mask[l])
+        {
+            halted[l] = true;
+            halt_reason[l] = reason;
+        }
+    }
+}
+
+/**
+ * @brief Method to advance the pc of every lane in the group by 4.
+ */
+void lockstep_engine::next_pc()
+{
+    for (uint32_t l = 0; l < width; l++)
+    {
+        pc[l] += mask[l] & 4;
+    }
+}
+
+/**
+ * @brief Method to execute an R-type ALU instruction across the group.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param op operation applied to rs1 and rs2 of each lane.
+ */
+template<typename OP>
+void lockstep_engine::exec_alu_reg(uint32_t insn, OP op)
+{
+    uint32_t rd = get_rd(insn);
+
+    if (rd != 0)
+    {
+        //rs1 or rs2 may be rd, only the mask is known not to alias
+        const int32_t *a = reg(get_rs1(insn));
+        const int32_t *b = reg(get_rs2(insn));
+        const int32_t *__restrict__ m = mask.data();
+        int32_t *d = reg(rd);
+
+        //branch free blend so the loop vectorizes
+        for (uint32_t l = 0; l < width; l++)
+        {
+            int32_t val = op(a[l], b[l]);
+            d[l] = (val & m[l]) | (d[l] & ~m[l]);
+        }
+    }
+
+    next_pc();
+}
+
+/**
+ * @brief Method to execute an ALU instruction with an immediate operand
+ * across the group.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param imm immediate operand shared by every lane.
+ * @param op operation applied to rs1 of each lane and the immediate.
+ */
+template<typename OP>
+void lockstep_engine::exec_alu_imm(uint32_t insn, int32_t imm, OP op)
+{
+    uint32_t rd = get_rd(insn);
+
+    if (rd != 0)
+    {
+        const int32_t *a = reg(get_rs1(insn));
+        const int32_t *__restrict__ m = mask.data();
+        int32_t *d = reg(rd);
+
+        for (uint32_t l = 0; l < width; l++)
+        {
+            int32_t val = op(a[l], imm);
+            d[l] = (val & m[l]) | (d[l] & ~m[l]);
+        }
+    }
+
+    next_pc();
+}
+
+/**
+ * @brief Method to execute a branch across the group. Lanes that disagree
+ * on the outcome end up with different pcs and split into two groups.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param op comparison applied to rs1 and rs2 of each lane.
+ */
+template<typename OP>
+void lockstep_engine::exec_branch(uint32_t insn, OP op)
+{
+    const int32_t *a = reg(get_rs1(insn));
+    const int32_t *b = reg(get_rs2(insn));
+    int32_t imm_b = get_imm_b(insn);
+
+    for (uint32_t l = 0; l < width; l++)
+    {
+        int32_t step = op(a[l], b[l]) ? imm_b : 4;
+        pc[l] += step & mask[l];
+    }
+}
+
+/**
+ * @brief Method to execute the jal instruction across the group.
+ * 
+ * @param insn RV32I instruction to be executed.
+ */
+void lockstep_engine::exec_jal(uint32_t insn)
+{
+    exec_alu_imm(insn, group_pc + 4, [](int32_t, int32_t imm) { return imm; });
+
+    //undo the pc += 4 from exec_alu_imm() and jump instead
+    int32_t target_addr = group_pc + get_imm_j(insn);
+    for (uint32_t l = 0; l < width; l++)
+    {
+        pc[l] = mask[l] ? target_addr : pc[l];
+    }
+}
+
+/**
+ * @brief Method to execute the jalr instruction across the group. Lanes
+ * may jump to different targets.
+ * 
+ * @param insn RV32I instruction to be executed.
+ */
+void lockstep_engine::exec_jalr(uint32_t insn)
+{
+    uint32_t rd = get_rd(insn);
+    const int32_t *a = reg(get_rs1(insn));
+    int32_t imm_i = get_imm_i(insn);
+
+    //compute the targets before rd is written in case rd == rs1
+    for (uint32_t l = 0; l < width; l++)
+    {
+        uint32_t target_addr = (a[l] + imm_i) & 0xfffffffe;
+        pc[l] = mask[l] ? target_addr : pc[l];
+    }
+
+    if (rd != 0)
+    {
+        int32_t *d = reg(rd);
+        for (uint32_t l = 0; l < width; l++)
+        {
+            d[l] = mask[l] ? group_pc + 4 : d[l];
+        }
+    }
+}
+
+/**
+ * @brief Method to execute a load across the group. Every lane reads its
+ * own memory so this is a scalar loop.
+ * 
+ * @param insn RV32I instruction to be executed.
+ */
+void lockstep_engine::exec_load(uint32_t insn)
+{
+    uint32_t funct3 = get_funct3(insn);
+    uint32_t rd = get_rd(insn);
+    const int32_t *a = reg(get_rs1(insn));
+    int32_t imm_i = get_imm_i(insn);
+
+    if (funct3 != funct3_lb && funct3 != funct3_lh && funct3 != funct3_lw && funct3 != funct3_lbu && funct3 != funct3_lhu)
+    {
+        exec_halt("Illegal instruction");
+        return;
+    }
+
+    for (uint32_t l = 0; l < lanes; l++)
+    {
+        if (!mask[l])
+        {
+            continue;
+        }
+
+        uint32_t addr = a[l] + imm_i;
+        int32_t val = 0;
+
+        switch (funct3)
+        {
+            case funct3_lb:  val = mems[l]->get8_sx(addr); break;
+            case funct3_lh:  val = mems[l]->get16_sx(addr); break;
+            case funct3_lw:  val = mems[l]->get32_sx(addr); break;
+            case funct3_lbu:  val = mems[l]->get8(addr); break;
+            case funct3_lhu:  val = mems[l]->get16(addr); break;
+        }
+
+        if (rd != 0)
+        {
+            reg(rd)[l] = val;
+        }
+    }
+
+    next_pc();
+}
+
+/**
+ * @brief Method to execute a store across the group.
+ * 
+ * @param insn RV32I instruction to be executed.
+ */
+void lockstep_engine::exec_store(uint32_t insn)
+{
+    uint32_t funct3 = get_funct3(insn);
+    const int32_t *a = reg(get_rs1(insn));
+    const int32_t *b = reg(get_rs2(insn));
+    int32_t imm_s = get_imm_s(insn);
+
+    if (funct3 != funct3_sb && funct3 != funct3_sh && funct3 != funct3_sw)
+    {
+        exec_halt("Illegal instruction");
+        return;
+    }
+
+    for (uint32_t l = 0; l < lanes; l++)
+    {
+        if (!mask[l])
+        {
+            continue;
+        }
+
+        uint32_t addr = a[l] + imm_s;
+
+        switch (funct3)
+        {
+            case funct3_sb:  mems[l]->set8(addr, b[l]); break;
+            case funct3_sh:  mems[l]->set16(addr, b[l]); break;
+            case funct3_sw:  mems[l]->set32(addr, b[l]); break;
+        }
+    }
+
+    next_pc();
+}
@@ -0,0 +1,81 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#ifndef LOCKSTEP_ENGINE_H
+#define LOCKSTEP_ENGINE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "memory.h"
+#include "rv32i_decode.h"
+
+/**
+ * Runs one program on many harts at once. Each hart is a lane with its own
+ * memory, and the register files are stored structure-of-arrays style (one
+ * int32_t lane per hart per register) so that ALU instructions are simple
+ * loops the compiler turns into host SIMD code. All lanes with the same pc
+ * execute together. When a branch diverges the lanes split into groups and
+ * the group with the lowest pc runs first so that they reconverge. Only
+ * the RV32I base instructions and a read of mhartid are implemented, so
+ * compressed code, the extensions, ECALL and other CSRs halt the lane.
+ ********************************************************************************/
+class lockstep_engine : public rv32i_decode
+{
+public:
+    lockstep_engine(uint32_t lanes, uint32_t mem_size);
+
+    bool load_file(const std::string &fname);
+    void run(uint64_t exec_limit);
+    void dump() const;
+
+    uint32_t get_lanes() const { return lanes; }
+    uint64_t get_insn_counter() const;
+    uint64_t get_issue_counter() const { return issue_counter; }
+    bool is_halted(uint32_t lane) const { return halted[lane]; }
+    const std::string &get_halt_reason(uint32_t lane) const { return halt_reason[lane]; }
+
+private:
+    static constexpr uint32_t lane_block = 16;
+
+    int32_t *reg(uint32_t r) { return &regs[r * width]; }
+    const int32_t *reg(uint32_t r) const { return &regs[r * width]; }
+
+    bool select_group(uint64_t exec_limit);
+    void exec(uint32_t insn);
+    void exec_halt(const char *reason);
+    void next_pc();
+
+    template<typename OP> void exec_alu_reg(uint32_t insn, OP op);
+    template<typename OP> void exec_alu_imm(uint32_t insn, int32_t imm, OP op);
+    template<typename OP> void exec_branch(uint32_t insn, OP op);
+    void exec_jal(uint32_t insn);
+    void exec_jalr(uint32_t insn);
+    void exec_load(uint32_t insn);
+    void exec_store(uint32_t insn);
+
+    uint32_t lanes;
+    uint32_t width;                 ///< lanes rounded up to a multiple of lane_block
+    uint32_t group_pc = { 0 };      ///< pc of the lanes in the current group
+
+    std::vector<std::unique_ptr<memory>> mems;
+    std::vector<int32_t> regs;      ///< 32 rows of width lanes
+    std::vector<uint32_t> pc;
+    std::vector<int32_t> mask;      ///< -1 for lanes in the current group
+    std::vector<uint8_t> halted;
+    std::vector<std::string> halt_reason;
+    std::vector<uint64_t> insn_counter;
+    uint64_t issue_counter = { 0 };
+};
+
+#endif
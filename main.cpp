@@ -13,13 +13,30 @@
 #include <cstdint> //uint32_t
 #include <unistd.h> //getopt
 #include <sstream>	//istringstream iss
+#include <memory>	//unique_ptr
+#include <vector>
+#include <functional>
+#include <tuple>	//tuple
 
 
 #include "hex.h"
 #include "memory.h"
 #include "rv32i_decode.h"
+#include "rv32c.h"
 #include "rv32i_hart.h"
+#include "vregisterfile.h"
 #include "cpu_single_hart.h"
+#include "hart_scheduler.h"
+#include "lockstep_engine.h"
+#include "fuzz_server.h"
+#include "checkpoint.h"
+#include "syscall_proxy.h"
+#include "uart16550.h"
+#include "clint.h"
+#include "blockdev.h"
+#include "dma.h"
+#include "event_queue.h"
+#include "image_loader.h"
 
 using std::cerr;
 using std::cout;
@@ -34,18 +51,25 @@ using std::endl;
  ********************************************************************************/
 static void disassemble(const memory &mem)
 {
-	for (uint32_t addr = 0; addr < mem.get_size(); addr++)
+	for (uint32_t addr = 0; addr < mem.get_size(); )
 	{
-		//just print the pc and fetched instruction-word values
-		if (addr % 4 == 0)
-		{
-			//render instruction by decoding it
-			std::string instruction = rv32i_decode::decode(addr, mem.get32(addr));
+		uint16_t parcel = mem.get16(addr);
 
-			//print the memory address, instruction hex value, and the instruction mnemonic
-			cout << hex::to_hex32(addr) << ": " << hex::to_hex32(mem.get32(addr)) << "  " << instruction << endl;
+		//compressed instructions are 2 bytes long
+		if (!rv32c::is_32bit(parcel))
+		{
+			//print the memory address, parcel hex value, and the instruction mnemonic
+			cout << hex::to_hex32(addr) << ": " << hex::to_hex16(parcel) << "      " << rv32i_decode::decode_compressed(addr, parcel) << endl;
+			addr += 2;
+			continue;
 		}
 
+		//render instruction by decoding it
+		std::string instruction = rv32i_decode::decode(addr, mem.get32(addr));
+
+		//print the memory address, instruction hex value, and the instruction mnemonic
+		cout << hex::to_hex32(addr) << ": " << hex::to_hex32(mem.get32(addr)) << "  " << instruction << endl;
+		addr += 4;
 	}
 }
 
@@ -58,12 +82,47 @@ static void disassemble(const memory &mem)
  ********************************************************************************/
 static void usage()
 {
-	cerr << "Usage: rv32i [-d] [-i] [-r] [-z] [-l exec-limit] [-m hex-mem-size] infile" << endl;
+	cerr << "Usage: rv32i [-d] [-i] [-r] [-z] [-g] [-H] [-l exec-limit] [-m hex-mem-size]" << endl;
+	cerr << "             [-p harts [-t threads]] [-v lanes] [-V vlen]" << endl;
+	cerr << "             [-x hex-addr:hex-size:rwx]... [-o hex-addr:file]..." << endl;
+	cerr << "             [-A hex-addr] [-c hex-addr] [-D hex-addr:file] [-u hex-addr [-U file]]" << endl;
+	cerr << "             [-f hex-marker-pc [-b hex-buffer-addr]]" << endl;
+	cerr << "             [-R checkpoint]... [-S checkpoint [-C interval | -P interval [-k clusters]]]" << endl;
+	cerr << "             infile [input...]" << endl;
+	cerr << "    -A map a DMA controller at this address, above the RAM" << endl;
+	cerr << "    -b guest buffer that each -f input is copied to (default = 0)" << endl;
+	cerr << "    -c map a CLINT timer at this address, above the RAM" << endl;
+	cerr << "    -C with -S, write a full checkpoint then a delta every interval insns" << endl;
+	cerr << "    -D map a block device above the RAM backed by a disk image, as" << endl;
+	cerr << "       address:file" << endl;
 	cerr << "    -d show disassembly before program execution" << endl;
+	cerr << "    -f fork server: snapshot at this pc then run each input from it," << endl;
+	cerr << "       not with -A, -c or -p" << endl;
+	cerr << "    -g put the RAM in a guard page reservation so loads and stores" << endl;
+	cerr << "       need no range checks" << endl;
+	cerr << "    -H run the bulk.cpy/set/cmp instructions on the host" << endl;
 	cerr << "    -i show instruction printing during execution" << endl;
+	cerr << "    -k number of SimPoint clusters for -P (default = 10)" << endl;
 	cerr << "    -l maximum number of instructions to exec" << endl;
 	cerr << "    -m specify memory size (default = 0x100)" << endl;
+	cerr << "    -o map a read-only image above the RAM, as address:file" << endl;
+	cerr << "    -p number of harts to simulate (default = 1), not with -A, -c, -C," << endl;
+	cerr << "       -f, -P, -R or -S" << endl;
+	cerr << "    -P with -S, profile basic block vectors over intervals of this many" << endl;
+	cerr << "       insns and checkpoint the SimPoint representative intervals" << endl;
 	cerr << "    -r show register printing during execution" << endl;
+	cerr << "    -R restore the machine state from a checkpoint (infile is optional)," << endl;
+	cerr << "       repeat to apply a chain of delta checkpoints in order" << endl;
+	cerr << "    -S save the machine state to a checkpoint after simulation" << endl;
+	cerr << "       (-C, -P, -R and -S cannot be used with -A, -c, -D or -u)" << endl;
+	cerr << "    -u map a 16550 UART at this address, above the RAM" << endl;
+	cerr << "    -U with -u, read the UART input from this file instead of stdin" << endl;
+	cerr << "    -t number of host threads for -p (default = host cores)" << endl;
+	cerr << "    -v run the program in lockstep on this many lanes, RV32I only and" << endl;
+	cerr << "       with no options but -l, -m and -z" << endl;
+	cerr << "    -V bits per vector register, a power of 2 from 64 to 1024 (default = 128)" << endl;
+	cerr << "    -x set the permissions of a RAM range, as address:size:rwx (default =" << endl;
+	cerr << "       the loaded image is rwx and the rest of the RAM rw)" << endl;
 	cerr << "    -z show a dump of the regs & memory after simulation" << endl;
 
 	exit(1);
@@ -85,20 +144,60 @@ static void usage()
 int main(int argc, char **argv)
 {
 	uint32_t memory_limit = 0x100; // default memory size = 256 bytes
-	int instruction_limit = 0;//max limit of instructions to execute
+	uint64_t instruction_limit = 0;//max limit of instructions to execute
+	uint32_t hart_count = 1;//number of harts sharing the memory
+	uint32_t thread_count = 0;//host threads to run the harts on
+	uint32_t lane_count = 0;//lanes for the lockstep engine
+	uint32_t marker_pc = 0;//pc at which the fork server takes its snapshot
+	uint32_t buffer_addr = 0;//guest buffer for fork server inputs
+	std::vector<std::string> restore_files;//checkpoint chain to resume from
+	std::string save_file;//checkpoint to write after the run
+	uint64_t checkpoint_interval = 0;//insns between periodic checkpoints
+	uint64_t simpoint_interval = 0;//insns per SimPoint interval
+	uint32_t simpoint_k = 10;//number of SimPoint clusters
+	uint32_t vlen = vregisterfile::default_vlen;//bits per vector register
+	std::vector<std::pair<uint32_t, std::string>> roms;//read-only images to map
+	uint32_t uart_addr = 0;//address of the UART registers
+	std::string uart_input;//file the UART receives from
+	uint32_t clint_addr = 0;//address of the CLINT registers
+	uint32_t dma_addr = 0;//address of the DMA controller registers
+	uint32_t disk_addr = 0;//address of the block device registers
+	std::string disk_image;//file behind the block device
+	std::vector<std::tuple<uint32_t, uint32_t, uint8_t>> perms;//RAM ranges and their permissions
 
 	//set of flags to set if argument is used in command line
 	bool dashD = false;
 	bool dashI = false;
 	bool dashR = false;
 	bool dashZ = false;
+	bool dashF = false;
+	bool dashH = false;
+	bool dashU = false;
+	bool dashC = false;
+	bool dashA = false;
+	bool dashG = false;
 
 	int opt;
 
-	while ((opt = getopt(argc, argv, "dirzl:m:")) != -1)
+	while ((opt = getopt(argc, argv, "A:c:D:dgirzHl:m:o:p:t:u:U:v:V:x:f:b:R:S:C:P:k:")) != -1)
 	{
 		switch (opt)
 		{
+			case 'A':
+				{
+					std::istringstream iss(optarg);
+					iss >> std::hex >> dma_addr;
+					dashA = true;
+					break;
+				}
+
+			case 'c':
+				{
+					std::istringstream iss(optarg);
+					iss >> std::hex >> clint_addr;
+					dashC = true;
+					break;
+				}
 						
 			case 'd':
 				{
@@ -106,6 +205,12 @@ int main(int argc, char **argv)
 					break;
 				}
 										
+			case 'g':
+				{
+					dashG = true;
+					break;
+				}
+
 			case 'i':
 				{
 					dashI = true;
@@ -124,6 +229,12 @@ int main(int argc, char **argv)
 					break;
 				}
 
+			case 'H':
+				{
+					dashH = true;
+					break;
+				}
+
 			case 'l':
 				{
 					std::istringstream iss(optarg);
@@ -138,21 +249,275 @@ int main(int argc, char **argv)
 					break;
 				}
 
+			case 'D':
+				{
+					std::istringstream iss(optarg);
+					if (!(iss >> std::hex >> disk_addr) || iss.get() != ':' || !std::getline(iss, disk_image))
+					{
+						usage();
+					}
+					break;
+				}
+
+			case 'o':
+				{
+					std::istringstream iss(optarg);
+					uint32_t base = 0;
+					std::string fname;
+					if (!(iss >> std::hex >> base) || iss.get() != ':' || !std::getline(iss, fname))
+					{
+						usage();
+					}
+					roms.emplace_back(base, fname);
+					break;
+				}
+
+			case 'p':
+				{
+					std::istringstream iss(optarg);
+					iss >> hart_count;
+					break;
+				}
+
+			case 't':
+				{
+					std::istringstream iss(optarg);
+					iss >> thread_count;
+					break;
+				}
+
+			case 'u':
+				{
+					std::istringstream iss(optarg);
+					iss >> std::hex >> uart_addr;
+					dashU = true;
+					break;
+				}
+
+			case 'U':
+				{
+					uart_input = optarg;
+					break;
+				}
+
+			case 'f':
+				{
+					std::istringstream iss(optarg);
+					iss >> std::hex >> marker_pc;
+					dashF = true;
+					break;
+				}
+
+			case 'b':
+				{
+					std::istringstream iss(optarg);
+					iss >> std::hex >> buffer_addr;
+					break;
+				}
+
+			case 'R':
+				{
+					restore_files.push_back(optarg);
+					break;
+				}
+
+			case 'S':
+				{
+					save_file = optarg;
+					break;
+				}
+
+			case 'C':
+				{
+					std::istringstream iss(optarg);
+					iss >> checkpoint_interval;
+					break;
+				}
+
+			case 'P':
+				{
+					std::istringstream iss(optarg);
+					iss >> simpoint_interval;
+					break;
+				}
+
+			case 'k':
+				{
+					std::istringstream iss(optarg);
+					iss >> simpoint_k;
+					break;
+				}
+
+			case 'v':
+				{
+					std::istringstream iss(optarg);
+					iss >> lane_count;
+					break;
+				}
+
+			case 'V':
+				{
+					std::istringstream iss(optarg);
+					iss >> vlen;
+					break;
+				}
+
+			case 'x':
+				{
+					std::istringstream iss(optarg);
+					uint32_t base = 0;
+					uint32_t size = 0;
+					std::string flags;
+					if (!(iss >> std::hex >> base) || iss.get() != ':' || !(iss >> std::hex >> size) || iss.get() != ':' || !std::getline(iss, flags))
+					{
+						usage();
+					}
+
+					//any of r, w and x, or - for no access at all
+					uint8_t perm = 0;
+					for (char c : flags)
+					{
+						if (c == 'r')
+							perm |= memory::perm_r;
+						else if (c == 'w')
+							perm |= memory::perm_w;
+						else if (c == 'x')
+							perm |= memory::perm_x;
+						else if (c != '-')
+							usage();
+					}
+					perms.emplace_back(base, size, perm);
+					break;
+				}
+
 			default: /* ’?’ */
 				usage();
 		}
 	}
 
+	if (!vregisterfile::is_valid_vlen(vlen))
+	{
+		usage();
+	}
+
+	//the CLINT and DMA controller run from the event queue of a single
+	//hart, the fork server snapshots a single hart, and a checkpoint holds
+	//a single hart and the RAM but none of the device state
+	bool checkpointing = !save_file.empty() || !restore_files.empty() || checkpoint_interval != 0 || simpoint_interval != 0;
+	if ((hart_count > 1 || dashF) && (dashC || dashA))
+	{
+		usage();
+	}
+	if (dashF && hart_count > 1)
+	{
+		usage();
+	}
+	if (checkpointing && (hart_count > 1 || dashC || dashA || dashU || !disk_image.empty()))
+	{
+		usage();
+	}
+
+	//Run one copy of the program per lane with every lane in its own memory.
+	//The lanes only run RV32I, with no devices, permissions or tracing
+	if (lane_count > 0)
+	{
+		bool other = dashD || dashI || dashR || dashH || dashU || dashC || dashA || dashF || dashG || hart_count > 1;
+		other = other || !perms.empty() || !roms.empty() || !disk_image.empty() || !uart_input.empty();
+		other = other || !save_file.empty() || !restore_files.empty() || checkpoint_interval != 0 || simpoint_interval != 0;
+		if (optind >= argc || other)
+		{
+			usage();
+		}
+
+		lockstep_engine engine(lane_count, memory_limit);
+		if (!engine.load_file(argv[optind]))
+		{
+			usage();
+		}
+
+		engine.run(instruction_limit);
+
+		if (dashZ)
+		{
+			engine.dump();
+		}
+
+		return 0;
+	}
+
 	//construct the mem and hart before disassembly
-	memory mem(memory_limit);
+	memory mem(memory_limit, dashG);
 	rv32i_hart hart(mem);
 
-	// fails to load file or missing filename
-	if (!mem.load_file(argv[optind]) || optind >= argc)
+	//map the ROMs above the RAM
+	for (const auto &rom : roms)
+	{
+		if (!mem.add_rom(rom.first, rom.second))
+		{
+			usage();
+		}
+	}
+
+	//map the console
+	uart16550 uart;
+	if (dashU && (!uart.map(mem, uart_addr) || (!uart_input.empty() && !uart.open_input(uart_input))))
+	{
+		usage();
+	}
+
+	//map the disk
+	blockdev disk(mem);
+	if (!disk_image.empty() && (!disk.open(disk_image) || !disk.map(disk_addr)))
+	{
+		usage();
+	}
+
+	// fails to load file or missing filename (the file is optional when
+	// the memory comes from a checkpoint). Intel HEX and S-record files
+	// are told apart by their extension and may set the reset pc
+	image_loader loader(mem);
+	if (restore_files.empty() && (optind >= argc || !loader.load(argv[optind])))
 	{
 		usage(); 
 	}
 
+	//the -x ranges override the default permissions of the image
+	for (const auto &p : perms)
+	{
+		if (!mem.set_perm(std::get<0>(p), std::get<1>(p), std::get<2>(p)))
+		{
+			usage();
+		}
+	}
+
+	//run the system calls the guest makes with ECALL on the host
+	syscall_proxy sys(mem);
+
+	//Run to the marker once, then run every input from that snapshot.
+	if (dashF)
+	{
+		fuzz_server server(mem, marker_pc, buffer_addr);
+		if (loader.has_entry())
+		{
+			server.set_reset_pc(loader.get_entry());
+		}
+		server.set_vlen(vlen);
+		server.set_syscall_proxy(&sys);
+		server.set_bulk_memory(dashH);
+		server.set_output_flush([&uart]() { uart.flush(); });
+		if (!server.run_to_marker(instruction_limit))
+		{
+			return 1;
+		}
+
+		for (int i = optind + 1; i < argc; i++)
+		{
+			server.run_input(argv[i], instruction_limit);
+		}
+
+		return 0;
+	}
+
 
 	//Show a disassembly of the entire memory before program simulation begins.
 	//By default, do not disassemble the program memory.
@@ -165,7 +530,116 @@ int main(int argc, char **argv)
 		cpu.reset();
 	}
 
+	//Run several harts over the same memory on a pool of host threads.
+	if (hart_count > 1)
+	{
+		std::vector<std::unique_ptr<cpu_single_hart>> harts;
+		hart_scheduler sched(thread_count);
+
+		for (uint32_t i = 0; i < hart_count; i++)
+		{
+			harts.emplace_back(new cpu_single_hart(mem));
+			if (loader.has_entry())
+			{
+				harts.back()->set_reset_pc(loader.get_entry());
+			}
+			harts.back()->set_mhartid(i);
+			harts.back()->set_vlen(vlen);
+			harts.back()->set_syscall_proxy(&sys);
+			harts.back()->set_bulk_memory(dashH);
+			sched.add(harts.back().get());
+		}
+
+		sched.run(instruction_limit);
+		uart.flush();
+
+		for (uint32_t i = 0; i < hart_count; i++)
+		{
+			if (harts[i]->is_halted())
+			{
+				cout << "Hart " << i << " execution terminated. Reason: " << harts[i]->get_halt_reason() << endl;
+			}
+			else if (harts[i]->is_idle())
+			{
+				cout << "Hart " << i << " execution stopped. Reason: waiting for an interrupt that nothing can raise" << endl;
+			}
+		}
+		cout << sched.get_insn_counter() << " instructions executed" << endl;
+
+		if (dashZ)
+		{
+			for (uint32_t i = 0; i < hart_count; i++)
+			{
+				harts[i]->dump("[" + std::to_string(i) + "] ");
+			}
+			mem.dump();
+		}
+
+		return 0;
+	}
+
 	cpu_single_hart cpu(mem);
+	if (loader.has_entry())
+	{
+		cpu.set_reset_pc(loader.get_entry());
+	}
+	cpu.set_vlen(vlen);
+	cpu.set_syscall_proxy(&sys);
+	cpu.set_bulk_memory(dashH);
+	cpu.set_output_flush([&uart]() { uart.flush(); });
+
+	//the UART drives the external interrupt input
+	uart.set_irq([&cpu](bool level) { cpu.set_mip(rv32i_hart::mip_meip, level); });
+
+	//devices that act on their own are run from the event queue between
+	//ticks
+	event_queue events;
+	cpu.set_event_queue(&events);
+
+	clint timer(cpu, events);
+	if (dashC && !timer.map(mem, clint_addr))
+	{
+		usage();
+	}
+
+	dma copier(cpu, events, mem);
+	if (dashA && !copier.map(dma_addr))
+	{
+		usage();
+	}
+
+	//look for UART input now and then so a receive interrupt can be
+	//raised while the guest is busy elsewhere
+	std::function<void(uint64_t)> poll_uart = [&](uint64_t now)
+	{
+		uart.poll();
+		events.schedule(now + uart16550::poll_interval, poll_uart);
+	};
+	if (dashU)
+	{
+		events.schedule(0, poll_uart);
+	}
+
+	//Resume from the state saved in a checkpoint and its deltas.
+	for (const std::string &fname : restore_files)
+	{
+		if (!checkpoint::restore(fname, cpu, mem))
+		{
+			return 1;
+		}
+	}
+
+	//Write save_file.0, save_file.1, ... while running.
+	if (!save_file.empty() && checkpoint_interval != 0)
+	{
+		cpu.set_checkpoint_interval(save_file, checkpoint_interval);
+	}
+
+	//Write save_file.simpoints and a checkpoint per SimPoint.
+	if (!save_file.empty() && simpoint_interval != 0)
+	{
+		cpu.set_simpoint(save_file, simpoint_interval, simpoint_k);
+	}
 
 	//Show instruction printing during execution.
 	//By default, do not print instructions during execution.
@@ -180,7 +654,16 @@ int main(int argc, char **argv)
 		cpu.set_show_registers(true);
 	}
 
-	cpu.run(instruction_limit);
+	if (!cpu.run(instruction_limit))
+	{
+		return 1;
+	}
+
+	//Save the state so a later run can resume from here.
+	if (!save_file.empty() && checkpoint_interval == 0 && simpoint_interval == 0 && !checkpoint::save(save_file, cpu, mem))
+	{
+		return 1;
+	}
 
 	//Show a dump of the hart status and memory after the simulation has halted.
 	if(dashZ)
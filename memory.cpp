@@ -16,6 +16,9 @@
 #include <ctype.h>  //isprint()
 #include <iostream>
 #include <fstream>  //load_file
+#include <algorithm>  //copy
+#include <cstring>    //memmove memset memcmp
+#include <iterator>   //istreambuf_iterator
 
 using std::cerr;
 using std::cout;
@@ -27,8 +30,10 @@ using std::hex;
  * byte/element to 0xa5.
  *
  * @param s size of the mem vector to be allocated.
+ * @param guard true to place the RAM at the start of a reservation of the
+ * whole guest address space, see guard_pages.
  ********************************************************************************/
-memory::memory(uint32_t s)
+memory::memory(uint32_t s, bool guard) : mem(guard_allocator(guard))
 {
     //allocate bytes for vector and round the length up % 16
     s = (s + 15) & 0xfffffff0;
@@ -38,6 +43,13 @@ memory::memory(uint32_t s)
 
     //initialize vector with 0xa5
     fill(mem.begin(), mem.end(), 0xa5);
+
+    //one dirty flag per page, all clean
+    dirty.resize((s + page_size - 1) / page_size, 0);
+
+    //every page can be read, written and executed until load_file() or
+    //set_perm() says otherwise
+    perms.resize((s + page_size - 1) / page_size, perm_r | perm_w | perm_x);
 }
 
 
@@ -98,12 +110,13 @@ uint32_t memory::get_size() const
  ********************************************************************************/
 uint8_t memory::get8(uint32_t addr) const
 {
-    //if address is in range then return position in vector
-    if (!check_illegal(addr))
+    //if address is in range then return position in vector, anything
+    //above the RAM is looked up in the memory map
+    if (addr < mem.size())
     {
-        return mem.at(addr);
+        return mem[addr];
     }
-    return 0;
+    return io_read(addr, 1);
 }
 
 
@@ -141,6 +154,12 @@ uint16_t memory::get16(uint32_t addr) const
     // uint16_t littleEndianOrder = get8(addr) + (get8(addr + 0x00000001) << 8);
     // cout << std::hex << "le: " << littleEndian << endl;
 
+    //a device sees one 16 bit access rather than two byte accesses
+    if (addr >= mem.size())
+    {
+        return io_read(addr, 2);
+    }
+
     return (get8(addr) + (get8(addr + 0x00000001) << 8));
 
 }
@@ -178,6 +197,12 @@ uint32_t memory::get32(uint32_t addr) const
     //combine bytes into little endian order to create 16 byte return value
     // uint32_t littleEndianOrder = get16(addr) + (get16(addr + 0x00000002) << 16);
 
+    //a device sees one 32 bit access rather than two 16 bit accesses
+    if (addr >= mem.size())
+    {
+        return io_read(addr, 4);
+    }
+
     return (get16(addr) + (get16(addr + 0x00000002) << 16));
 
 }
@@ -242,13 +267,15 @@ int32_t memory::get32_sx(uint32_t addr) const
  ********************************************************************************/
 void memory::set8(uint32_t addr, uint8_t val)
 {
-    //verify address and set byte in the memory
-    //at that address to value else discard
-    if (!check_illegal(addr))
+    //set byte in the memory at that address to value, anything
+    //above the RAM is looked up in the memory map
+    if (addr < mem.size())
     {
-        mem.at(addr) = val;
+        mem[addr] = val;
+        dirty[addr / page_size] = 1;
+        return;
     }
-    return;
+    io_write(addr, 1, val);
 }
 
 
@@ -262,6 +289,13 @@ void memory::set8(uint32_t addr, uint8_t val)
  ********************************************************************************/
 void memory::set16(uint32_t addr, uint16_t val)
 {
+    //a device sees one 16 bit access rather than two byte accesses
+    if (addr >= mem.size())
+    {
+        io_write(addr, 2, val);
+        return;
+    }
+
     //call set8() twice to store value in little endian
     //order into memory starting at address
     set8(addr, val);
@@ -279,6 +313,13 @@ void memory::set16(uint32_t addr, uint16_t val)
  ********************************************************************************/
 void memory::set32(uint32_t addr, uint32_t val)
 {
+    //a device sees one 32 bit access rather than two 16 bit accesses
+    if (addr >= mem.size())
+    {
+        io_write(addr, 4, val);
+        return;
+    }
+
     //call set16() twice to store value in little endian
     //order into memory starting at address
     set16(addr, val);
@@ -287,6 +328,487 @@ void memory::set32(uint32_t addr, uint32_t val)
 
 
 
+/**
+ * This function adds a read-only region to the memory map and fills it
+ * with the contents of a file. Stores to it are ignored.
+ *
+ * @param base unsigned 32 bit integer address of the first byte. It must
+ * be above the RAM.
+ * @param fname name of the file that holds the ROM image.
+ *
+ * @return true if the ROM was added or false if the file could not be
+ * read or the region does not fit.
+ ********************************************************************************/
+bool memory::add_rom(uint32_t base, const std::string &fname)
+{
+    std::ifstream infile(fname, std::ios::in|std::ios::binary);
+
+    if (!infile.is_open())
+    {
+        cerr << "Can't open file '" << fname << "' for reading." << endl;
+        return false;
+    }
+
+    region r;
+    r.base = base;
+    r.rom.assign(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+    r.size = r.rom.size();
+    return add_region(std::move(r));
+}
+
+
+/**
+ * This function adds a device to the memory map. Every load and store
+ * that lands in the region calls the device with the offset from base
+ * and the access size in bytes (1, 2 or 4).
+ *
+ * @param base unsigned 32 bit integer address of the first register. It
+ * must be above the RAM.
+ * @param size number of bytes the device decodes.
+ * @param read called for loads, returns the value zero extended.
+ * @param write called for stores with the value in the low bits.
+ *
+ * @return true if the device was added or false if the region does not
+ * fit.
+ ********************************************************************************/
+bool memory::add_mmio(uint32_t base, uint32_t size, io_read_fn read, io_write_fn write)
+{
+    region r;
+    r.base = base;
+    r.size = size;
+    r.read = std::move(read);
+    r.write = std::move(write);
+    return add_region(std::move(r));
+}
+
+
+/**
+ * This function inserts a region into the memory map, which is kept
+ * sorted by base. Regions must sit above the RAM so that a RAM access is
+ * told apart from a device access with the one compare against
+ * mem.size() that get*() and set*() already make.
+ *
+ * @param r region to insert.
+ *
+ * @return true if the region was inserted or false if it is empty,
+ * wraps, overlaps the RAM or overlaps another region.
+ ********************************************************************************/
+bool memory::add_region(region r)
+{
+    //find the first region above the new one
+    auto next = std::upper_bound(regions.begin(), regions.end(), r.base,
+        [](uint32_t base, const region &x) { return base < x.base; });
+
+    uint32_t last = r.base + r.size - 1;
+    bool bad = r.size == 0 || last < r.base || r.base < mem.size()
+        || (next != regions.end() && last >= next->base)
+        || (next != regions.begin() && (next - 1)->base + ((next - 1)->size - 1) >= r.base);
+
+    if (bad)
+    {
+        cerr << "Can't map " << hex::to_hex0x32(r.size) << " bytes at " << hex::to_hex0x32(r.base) << endl;
+        return false;
+    }
+
+    regions.insert(next, std::move(r));
+    return true;
+}
+
+
+/**
+ * This function finds the region that holds every byte of an access.
+ *
+ * @param addr unsigned 32 bit integer address of the first byte.
+ * @param size number of bytes accessed.
+ *
+ * @return the region or nullptr if the access is not fully inside one.
+ ********************************************************************************/
+const memory::region *memory::find_region(uint32_t addr, uint32_t size) const
+{
+    auto next = std::upper_bound(regions.begin(), regions.end(), addr,
+        [](uint32_t a, const region &x) { return a < x.base; });
+
+    if (next == regions.begin())
+    {
+        return nullptr;
+    }
+
+    const region &r = *(next - 1);
+    uint32_t offset = addr - r.base;
+    return (offset < r.size && size <= r.size - offset) ? &r : nullptr;
+}
+
+
+/**
+ * This function performs a load above the RAM. It is only reached once
+ * get*() has found that the address is not in RAM.
+ *
+ * @param addr unsigned 32 bit integer address of the first byte.
+ * @param size number of bytes to load (1, 2 or 4).
+ *
+ * @return the value zero extended, 0 if nothing is mapped there.
+ ********************************************************************************/
+uint32_t memory::io_read(uint32_t addr, uint32_t size) const
+{
+    const region *r = find_region(addr, size);
+
+    //prints the out of range warning
+    if (!r)
+    {
+        check_illegal(addr);
+        return 0;
+    }
+
+    uint32_t offset = addr - r->base;
+
+    //ROM is read in little endian order like the RAM
+    if (!r->rom.empty())
+    {
+        uint32_t val = 0;
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            val |= r->rom[offset + i] << (8 * i);
+        }
+        return val;
+    }
+
+    return r->read ? r->read(offset, size) : 0;
+}
+
+
+/**
+ * This function performs a store above the RAM. It is only reached once
+ * set*() has found that the address is not in RAM.
+ *
+ * @param addr unsigned 32 bit integer address of the first byte.
+ * @param size number of bytes to store (1, 2 or 4).
+ * @param val value to store in the low size bytes.
+ ********************************************************************************/
+void memory::io_write(uint32_t addr, uint32_t size, uint32_t val)
+{
+    const region *r = find_region(addr, size);
+
+    //prints the out of range warning
+    if (!r)
+    {
+        check_illegal(addr);
+        return;
+    }
+
+    //stores to ROM are dropped
+    if (r->rom.empty() && r->write)
+    {
+        r->write(addr - r->base, size, val);
+    }
+}
+
+
+
+/**
+ * This function copies a block of bytes out of the simulated memory. The
+ * whole range is checked once instead of once per byte.
+ *
+ * @param addr unsigned 32 bit integer address of the first byte.
+ * @param dst buffer that receives the bytes.
+ * @param len number of bytes to copy.
+ *
+ * @return true if the range is valid or false if nothing was copied.
+ ********************************************************************************/
+bool memory::read_block(uint32_t addr, void *dst, uint32_t len) const
+{
+    if (len == 0)
+    {
+        return true;
+    }
+
+    //check the first and last byte and that the range does not wrap
+    if (check_illegal(addr) || check_illegal(addr + len - 1) || addr + len < addr)
+    {
+        return false;
+    }
+
+    std::copy(mem.begin() + addr, mem.begin() + addr + len, static_cast<uint8_t*>(dst));
+    return true;
+}
+
+
+/**
+ * This function copies a block of bytes into the simulated memory. The
+ * whole range is checked once instead of once per byte.
+ *
+ * @param addr unsigned 32 bit integer address of the first byte.
+ * @param src buffer that holds the bytes.
+ * @param len number of bytes to copy.
+ *
+ * @return true if the range is valid or false if nothing was copied.
+ ********************************************************************************/
+bool memory::write_block(uint32_t addr, const void *src, uint32_t len)
+{
+    if (len == 0)
+    {
+        return true;
+    }
+
+    //check the first and last byte and that the range does not wrap
+    if (check_illegal(addr) || check_illegal(addr + len - 1) || addr + len < addr)
+    {
+        return false;
+    }
+
+    const uint8_t *p = static_cast<const uint8_t*>(src);
+    std::copy(p, p + len, mem.begin() + addr);
+    std::fill(dirty.begin() + addr / page_size, dirty.begin() + (addr + len - 1) / page_size + 1, 1);
+    return true;
+}
+
+
+/**
+ * This function returns a host pointer to a block of the simulated memory
+ * so that it can be read in place without copying it out first.
+ *
+ * @param addr unsigned 32 bit integer address of the first byte.
+ * @param len number of bytes that will be read.
+ *
+ * @return pointer to the first byte or nullptr if the range is not valid.
+ ********************************************************************************/
+const uint8_t *memory::get_read_ptr(uint32_t addr, uint32_t len) const
+{
+    //check the first and last byte and that the range does not wrap
+    if (check_illegal(addr) || (len != 0 && (check_illegal(addr + len - 1) || addr + len < addr)))
+    {
+        return nullptr;
+    }
+
+    return &mem[addr];
+}
+
+
+/**
+ * This function returns a host pointer to a block of the simulated memory
+ * so that it can be written in place. The pages are marked dirty up front.
+ *
+ * @param addr unsigned 32 bit integer address of the first byte.
+ * @param len number of bytes that will be written.
+ *
+ * @return pointer to the first byte or nullptr if the range is not valid.
+ ********************************************************************************/
+uint8_t *memory::get_write_ptr(uint32_t addr, uint32_t len)
+{
+    //check the first and last byte and that the range does not wrap
+    if (check_illegal(addr) || (len != 0 && (check_illegal(addr + len - 1) || addr + len < addr)))
+    {
+        return nullptr;
+    }
+
+    if (len != 0)
+    {
+        std::fill(dirty.begin() + addr / page_size, dirty.begin() + (addr + len - 1) / page_size + 1, 1);
+    }
+    return &mem[addr];
+}
+
+
+/**
+ * This function returns the number of bytes that load_file() read.
+ *
+ * @return size of the loaded program, 0 if nothing was loaded.
+ ********************************************************************************/
+uint32_t memory::get_load_size() const
+{
+    return load_size;
+}
+
+
+
+
+/**
+ * This function sets where the loaded program ends without changing any
+ * permissions. Used when the memory comes from a checkpoint instead.
+ *
+ * @param size number of bytes from address 0 to the end of the program.
+ ********************************************************************************/
+void memory::set_load_size(uint32_t size)
+{
+    load_size = size;
+}
+
+
+
+/**
+ * This function records where a loaded image ends. Only the pages of the
+ * image stay executable, the rest of the RAM is made read/write.
+ *
+ * @param size number of bytes from address 0 to the end of the image.
+ ********************************************************************************/
+void memory::set_image_size(uint32_t size)
+{
+    load_size = size;
+
+    uint32_t data = (size + page_size - 1) & ~(page_size - 1);
+    if (data < mem.size())
+    {
+        set_perm(data, mem.size() - data, perm_r | perm_w);
+    }
+}
+
+
+
+/**
+ * This function copies len bytes from src to dst inside the simulated
+ * memory with one host memmove. Both ranges are checked once and may
+ * overlap.
+ *
+ * @param dst unsigned 32 bit integer address of the first destination byte.
+ * @param src unsigned 32 bit integer address of the first source byte.
+ * @param len number of bytes to copy.
+ *
+ * @return true if both ranges are valid or false if nothing was copied.
+ ********************************************************************************/
+bool memory::copy_block(uint32_t dst, uint32_t src, uint32_t len)
+{
+    const uint8_t *from = get_read_ptr(src, len);
+    uint8_t *to = from ? get_write_ptr(dst, len) : nullptr;
+
+    if (!to)
+    {
+        return false;
+    }
+
+    std::memmove(to, from, len);
+    return true;
+}
+
+
+/**
+ * This function sets len bytes of the simulated memory to val with one
+ * host memset.
+ *
+ * @param addr unsigned 32 bit integer address of the first byte.
+ * @param val value stored in every byte.
+ * @param len number of bytes to set.
+ *
+ * @return true if the range is valid or false if nothing was set.
+ ********************************************************************************/
+bool memory::fill_block(uint32_t addr, uint8_t val, uint32_t len)
+{
+    uint8_t *to = get_write_ptr(addr, len);
+
+    if (!to)
+    {
+        return false;
+    }
+
+    std::memset(to, val, len);
+    return true;
+}
+
+
+/**
+ * This function compares two ranges of the simulated memory with one host
+ * memcmp.
+ *
+ * @param a unsigned 32 bit integer address of the first range.
+ * @param b unsigned 32 bit integer address of the second range.
+ * @param len number of bytes to compare.
+ * @param result set to -1, 0 or 1 as the first range is less than, equal
+ * to or greater than the second.
+ *
+ * @return true if both ranges are valid or false if nothing was compared.
+ ********************************************************************************/
+bool memory::compare_block(uint32_t a, uint32_t b, uint32_t len, int32_t &result) const
+{
+    const uint8_t *pa = get_read_ptr(a, len);
+    const uint8_t *pb = pa ? get_read_ptr(b, len) : nullptr;
+
+    if (!pb)
+    {
+        return false;
+    }
+
+    int diff = std::memcmp(pa, pb, len);
+    result = (diff > 0) - (diff < 0);
+    return true;
+}
+
+
+
+/**
+ * This function reports whether a page has been written since the last
+ * call to clear_dirty().
+ *
+ * @param page page number (address / page_size).
+ *
+ * @return true if the page has been written.
+ ********************************************************************************/
+bool memory::is_dirty(uint32_t page) const
+{
+    return page < dirty.size() && dirty[page];
+}
+
+
+
+/**
+ * This function sets the permissions of every page that overlaps a range
+ * of the RAM.
+ *
+ * @param addr unsigned 32 bit integer address of the first byte.
+ * @param len number of bytes, the range is rounded out to whole pages.
+ * @param perm any of perm_r, perm_w and perm_x or'd together.
+ *
+ * @return true if the permissions were set or false if the range is empty
+ * or not entirely inside the RAM.
+ ********************************************************************************/
+bool memory::set_perm(uint32_t addr, uint32_t len, uint8_t perm)
+{
+    if (len == 0 || (uint64_t)addr + len > mem.size())
+    {
+        return false;
+    }
+
+    std::fill(perms.begin() + addr / page_size, perms.begin() + (addr + len - 1) / page_size + 1, perm);
+    rw_all = std::all_of(perms.begin(), perms.end(), [](uint8_t p) { return (p & (perm_r | perm_w)) == (perm_r | perm_w); });
+    return true;
+}
+
+
+
+/**
+ * This function checks that every RAM page a range touches has the given
+ * permission. Anything above the RAM is left to the memory map, where ROM
+ * ignores stores.
+ *
+ * @param addr unsigned 32 bit integer address of the first byte.
+ * @param len number of bytes.
+ * @param perm perm_r, perm_w or perm_x.
+ *
+ * @return true if the access is allowed.
+ ********************************************************************************/
+bool memory::check_perm(uint32_t addr, uint32_t len, uint8_t perm) const
+{
+    uint64_t end = std::min<uint64_t>((uint64_t)addr + len, mem.size());
+    for (uint64_t page = addr / page_size; addr < end && page * page_size < end; page++)
+    {
+        if (!(perms[page] & perm))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+/**
+ * This function marks every page as clean. Called after a checkpoint has
+ * saved the pages.
+ ********************************************************************************/
+void memory::clear_dirty()
+{
+    std::fill(dirty.begin(), dirty.end(), 0);
+}
+
+
+
 /**
  * This function dumps the entire contents of the simulated memory using proper
  * formatting and outputting an ASCII box that corresponds to each byte in 
@@ -367,6 +889,8 @@ void memory::dump() const
  * This function checks to see if a file can be opened. If it can be opened then
  * the contents of the file are read into simulated memory. If it cannot be opened
  * then the function returns to caller.
+ * The pages of the image stay executable and the rest of the RAM is
+ * made read/write only.
  *
  * @param fname name of file to be checked if it can be opened and read.
  *
@@ -388,7 +912,8 @@ bool memory::load_file(const std::string &fname)
         infile >> std::noskipws;
 
         //read the file contents
-        for (uint32_t addr = 0; infile >> i; ++addr)
+        uint32_t addr = 0;
+        for (; infile >> i; ++addr)
         {
             //check that the file can fit into memory and return status
             if(check_illegal(addr))
@@ -407,6 +932,9 @@ bool memory::load_file(const std::string &fname)
             mem.at(addr) = i;
         }
 
+        //remember where the program ends
+        set_image_size(addr);
+
         //disassociate file from is_open() call by calling close
         infile.close();
 
@@ -0,0 +1,392 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#include "rv32c.h"
+#include <vector>
+
+/**
+ * Returns the expansion table, building it the first time it is needed.
+ *
+ * @return pointer to 65536 expanded instructions indexed by parcel.
+ ********************************************************************************/
+const uint32_t *rv32c::get_table()
+{
+    static const std::vector<uint32_t> table = []()
+    {
+        std::vector<uint32_t> t(0x10000);
+        for (uint32_t parcel = 0; parcel < t.size(); parcel++)
+        {
+            t[parcel] = expand(parcel);
+        }
+        return t;
+    }();
+
+    return table.data();
+}
+
+/**
+ * Expands one compressed instruction.
+ *
+ * @param parcel 16-bit compressed instruction.
+ * @param mnemonic if not null, set to the compressed mnemonic.
+ *
+ * @return the equivalent 32-bit instruction or illegal_insn.
+ ********************************************************************************/
+uint32_t rv32c::expand(uint16_t parcel, const char **mnemonic)
+{
+    const char *m = "c.illegal";
+    uint32_t insn = illegal_insn;
+
+    //full register numbers and the x8-x15 registers of the 3-bit fields
+    uint32_t rd = bits(parcel, 11, 7);
+    uint32_t rs2 = bits(parcel, 6, 2);
+    uint32_t rd_p = bits(parcel, 4, 2) + 8;
+    uint32_t rs1_p = bits(parcel, 9, 7) + 8;
+
+    //6-bit immediate used by c.addi, c.li, c.andi and the shifts
+    int32_t imm6 = sign_extend(bits(parcel, 12, 12) << 5 | bits(parcel, 6, 2), 5);
+    uint32_t shamt = bits(parcel, 12, 12) << 5 | bits(parcel, 6, 2);
+
+    switch ((bits(parcel, 15, 13) << 2) | bits(parcel, 1, 0))
+    {
+        //QUADRANT 0
+        case 0b00000:
+        {
+            //nzuimm[5:4|9:6|2|3]
+            uint32_t imm = bits(parcel, 12, 11) << 4 | bits(parcel, 10, 7) << 6 | bits(parcel, 6, 6) << 2 | bits(parcel, 5, 5) << 3;
+            if (imm != 0)
+            {
+                m = "c.addi4spn";
+                insn = enc_i(imm, 2, 0b000, rd_p, 0b0010011);
+            }
+            break;
+        }
+        case 0b01000:
+        {
+            //uimm[5:3|2|6]
+            uint32_t imm = bits(parcel, 12, 10) << 3 | bits(parcel, 6, 6) << 2 | bits(parcel, 5, 5) << 6;
+            m = "c.lw";
+            insn = enc_i(imm, rs1_p, 0b010, rd_p, 0b0000011);
+            break;
+        }
+        case 0b11000:
+        {
+            uint32_t imm = bits(parcel, 12, 10) << 3 | bits(parcel, 6, 6) << 2 | bits(parcel, 5, 5) << 6;
+            m = "c.sw";
+            insn = enc_s(imm, rd_p, rs1_p, 0b010, 0b0100011);
+            break;
+        }
+        case 0b00100:
+        case 0b10100:
+        {
+            //uimm[5:3|7:6]
+            uint32_t imm = bits(parcel, 12, 10) << 3 | bits(parcel, 6, 5) << 6;
+            bool load = bits(parcel, 15, 13) == 0b001;
+            m = load ? "c.fld" : "c.fsd";
+            insn = load ? enc_i(imm, rs1_p, 0b011, rd_p, 0b0000111) : enc_s(imm, rd_p, rs1_p, 0b011, 0b0100111);
+            break;
+        }
+        case 0b01100:
+        case 0b11100:
+        {
+            //uimm[5:3|2|6]
+            uint32_t imm = bits(parcel, 12, 10) << 3 | bits(parcel, 6, 6) << 2 | bits(parcel, 5, 5) << 6;
+            bool load = bits(parcel, 15, 13) == 0b011;
+            m = load ? "c.flw" : "c.fsw";
+            insn = load ? enc_i(imm, rs1_p, 0b010, rd_p, 0b0000111) : enc_s(imm, rd_p, rs1_p, 0b010, 0b0100111);
+            break;
+        }
+
+        //QUADRANT 1
+        case 0b00001:
+            m = (rd == 0) ? "c.nop" : "c.addi";
+            insn = enc_i(imm6, rd, 0b000, rd, 0b0010011);
+            break;
+
+        case 0b00101:
+        case 0b10101:
+        {
+            //imm[11|4|9:8|10|6|7|3:1|5]
+            uint32_t imm = bits(parcel, 12, 12) << 11 | bits(parcel, 11, 11) << 4 | bits(parcel, 10, 9) << 8
+                | bits(parcel, 8, 8) << 10 | bits(parcel, 7, 7) << 6 | bits(parcel, 6, 6) << 7
+                | bits(parcel, 5, 3) << 1 | bits(parcel, 2, 2) << 5;
+            bool link = bits(parcel, 15, 13) == 0b001;
+            m = link ? "c.jal" : "c.j";
+            insn = enc_j(sign_extend(imm, 11), link ? 1 : 0);
+            break;
+        }
+
+        case 0b01001:
+            m = "c.li";
+            insn = enc_i(imm6, 0, 0b000, rd, 0b0010011);
+            break;
+
+        case 0b01101:
+            if (rd == 2)
+            {
+                //nzimm[9|4|6|8:7|5]
+                uint32_t imm = bits(parcel, 12, 12) << 9 | bits(parcel, 6, 6) << 4 | bits(parcel, 5, 5) << 6
+                    | bits(parcel, 4, 3) << 7 | bits(parcel, 2, 2) << 5;
+                if (imm != 0)
+                {
+                    m = "c.addi16sp";
+                    insn = enc_i(sign_extend(imm, 9), 2, 0b000, 2, 0b0010011);
+                }
+            }
+            else if (imm6 != 0)
+            {
+                m = "c.lui";
+                insn = enc_u(imm6 << 12, rd);
+            }
+            break;
+
+        case 0b10001:
+            switch (bits(parcel, 11, 10))
+            {
+                case 0b00:
+                    //shamt[5] must be zero on RV32
+                    if (shamt < 32)
+                    {
+                        m = "c.srli";
+                        insn = enc_i(shamt, rs1_p, 0b101, rs1_p, 0b0010011);
+                    }
+                    break;
+                case 0b01:
+                    if (shamt < 32)
+                    {
+                        m = "c.srai";
+                        insn = enc_i(0x400 | shamt, rs1_p, 0b101, rs1_p, 0b0010011);
+                    }
+                    break;
+                case 0b10:
+                    m = "c.andi";
+                    insn = enc_i(imm6, rs1_p, 0b111, rs1_p, 0b0010011);
+                    break;
+                case 0b11:
+                    //bit 12 set is subw/addw which are RV64 only
+                    if (bits(parcel, 12, 12) == 0)
+                    {
+                        switch (bits(parcel, 6, 5))
+                        {
+                            case 0b00: m = "c.sub"; insn = enc_r(0b0100000, rd_p, rs1_p, 0b000, rs1_p, 0b0110011); break;
+                            case 0b01: m = "c.xor"; insn = enc_r(0b0000000, rd_p, rs1_p, 0b100, rs1_p, 0b0110011); break;
+                            case 0b10: m = "c.or"; insn = enc_r(0b0000000, rd_p, rs1_p, 0b110, rs1_p, 0b0110011); break;
+                            case 0b11: m = "c.and"; insn = enc_r(0b0000000, rd_p, rs1_p, 0b111, rs1_p, 0b0110011); break;
+                        }
+                    }
+                    break;
+            }
+            break;
+
+        case 0b11001:
+        case 0b11101:
+        {
+            //offset[8|4:3|7:6|2:1|5]
+            uint32_t imm = bits(parcel, 12, 12) << 8 | bits(parcel, 11, 10) << 3 | bits(parcel, 6, 5) << 6
+                | bits(parcel, 4, 3) << 1 | bits(parcel, 2, 2) << 5;
+            bool bnez = bits(parcel, 15, 13) == 0b111;
+            m = bnez ? "c.bnez" : "c.beqz";
+            insn = enc_b(sign_extend(imm, 8), 0, rs1_p, bnez ? 0b001 : 0b000);
+            break;
+        }
+
+        //QUADRANT 2
+        case 0b00010:
+            if (shamt < 32)
+            {
+                m = "c.slli";
+                insn = enc_i(shamt, rd, 0b001, rd, 0b0010011);
+            }
+            break;
+
+        case 0b01010:
+        {
+            //uimm[5|4:2|7:6]
+            uint32_t imm = bits(parcel, 12, 12) << 5 | bits(parcel, 6, 4) << 2 | bits(parcel, 3, 2) << 6;
+            if (rd != 0)
+            {
+                m = "c.lwsp";
+                insn = enc_i(imm, 2, 0b010, rd, 0b0000011);
+            }
+            break;
+        }
+
+        case 0b10010:
+            if (bits(parcel, 12, 12) == 0)
+            {
+                if (rs2 == 0 && rd != 0)
+                {
+                    m = "c.jr";
+                    insn = enc_i(0, rd, 0b000, 0, 0b1100111);
+                }
+                else if (rs2 != 0)
+                {
+                    m = "c.mv";
+                    insn = enc_r(0, rs2, 0, 0b000, rd, 0b0110011);
+                }
+            }
+            else
+            {
+                if (rs2 == 0 && rd == 0)
+                {
+                    m = "c.ebreak";
+                    insn = 0x00100073;
+                }
+                else if (rs2 == 0)
+                {
+                    m = "c.jalr";
+                    insn = enc_i(0, rd, 0b000, 1, 0b1100111);
+                }
+                else
+                {
+                    m = "c.add";
+                    insn = enc_r(0, rs2, rd, 0b000, rd, 0b0110011);
+                }
+            }
+            break;
+
+        case 0b11010:
+        {
+            //uimm[5:2|7:6]
+            uint32_t imm = bits(parcel, 12, 9) << 2 | bits(parcel, 8, 7) << 6;
+            m = "c.swsp";
+            insn = enc_s(imm, rs2, 2, 0b010, 0b0100011);
+            break;
+        }
+
+        case 0b00110:
+        {
+            //uimm[5|4:3|8:6]
+            uint32_t imm = bits(parcel, 12, 12) << 5 | bits(parcel, 6, 5) << 3 | bits(parcel, 4, 2) << 6;
+            m = "c.fldsp";
+            insn = enc_i(imm, 2, 0b011, rd, 0b0000111);
+            break;
+        }
+        case 0b01110:
+        {
+            //uimm[5|4:2|7:6]
+            uint32_t imm = bits(parcel, 12, 12) << 5 | bits(parcel, 6, 4) << 2 | bits(parcel, 3, 2) << 6;
+            m = "c.flwsp";
+            insn = enc_i(imm, 2, 0b010, rd, 0b0000111);
+            break;
+        }
+        case 0b10110:
+        {
+            //uimm[5:3|8:6]
+            uint32_t imm = bits(parcel, 12, 10) << 3 | bits(parcel, 9, 7) << 6;
+            m = "c.fsdsp";
+            insn = enc_s(imm, rs2, 2, 0b011, 0b0100111);
+            break;
+        }
+        case 0b11110:
+        {
+            //uimm[5:2|7:6]
+            uint32_t imm = bits(parcel, 12, 9) << 2 | bits(parcel, 8, 7) << 6;
+            m = "c.fswsp";
+            insn = enc_s(imm, rs2, 2, 0b010, 0b0100111);
+            break;
+        }
+
+        //reserved encodings and 32-bit instructions are left as illegal
+        default:
+            break;
+    }
+
+    if (insn == illegal_insn)
+    {
+        m = "c.illegal";
+    }
+    if (mnemonic)
+    {
+        *mnemonic = m;
+    }
+    return insn;
+}
+
+/**
+ * Extracts bits hi through lo of the parcel shifted down to bit 0.
+ *
+ * @param parcel compressed instruction.
+ * @param hi most significant bit of the field.
+ * @param lo least significant bit of the field.
+ *
+ * @return the field value.
+ ********************************************************************************/
+uint32_t rv32c::bits(uint32_t parcel, uint32_t hi, uint32_t lo)
+{
+    return (parcel >> lo) & ((1u << (hi - lo + 1)) - 1);
+}
+
+/**
+ * Sign extends a value whose sign is in the given bit.
+ *
+ * @param val value to extend.
+ * @param bit position of the sign bit.
+ *
+ * @return signed 32 bit value.
+ ********************************************************************************/
+int32_t rv32c::sign_extend(uint32_t val, uint32_t bit)
+{
+    return (val & (1u << bit)) ? static_cast<int32_t>(val | (0xffffffffu << bit)) : static_cast<int32_t>(val);
+}
+
+/**
+ * Encodes an R-type instruction.
+ ********************************************************************************/
+uint32_t rv32c::enc_r(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode)
+{
+    return funct7 << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | opcode;
+}
+
+/**
+ * Encodes an I-type instruction.
+ ********************************************************************************/
+uint32_t rv32c::enc_i(int32_t imm, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode)
+{
+    return (static_cast<uint32_t>(imm) & 0xfff) << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | opcode;
+}
+
+/**
+ * Encodes an S-type store instruction.
+ ********************************************************************************/
+uint32_t rv32c::enc_s(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t opcode)
+{
+    uint32_t u = static_cast<uint32_t>(imm);
+    return ((u >> 5) & 0x7f) << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | (u & 0x1f) << 7 | opcode;
+}
+
+/**
+ * Encodes a B-type branch instruction.
+ ********************************************************************************/
+uint32_t rv32c::enc_b(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3)
+{
+    uint32_t u = static_cast<uint32_t>(imm);
+    return ((u >> 12) & 1) << 31 | ((u >> 5) & 0x3f) << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12
+        | ((u >> 1) & 0xf) << 8 | ((u >> 11) & 1) << 7 | 0b1100011;
+}
+
+/**
+ * Encodes a lui instruction.
+ ********************************************************************************/
+uint32_t rv32c::enc_u(int32_t imm, uint32_t rd)
+{
+    return (static_cast<uint32_t>(imm) & 0xfffff000) | rd << 7 | 0b0110111;
+}
+
+/**
+ * Encodes a jal instruction.
+ ********************************************************************************/
+uint32_t rv32c::enc_j(int32_t imm, uint32_t rd)
+{
+    uint32_t u = static_cast<uint32_t>(imm);
+    return ((u >> 20) & 1) << 31 | ((u >> 1) & 0x3ff) << 21 | ((u >> 11) & 1) << 20 | ((u >> 12) & 0xff) << 12
+        | rd << 7 | 0b1101111;
+}
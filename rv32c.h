@@ -0,0 +1,47 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+#ifndef RV32C_H
+#define RV32C_H
+
+#include <cstdint>
+
+/**
+ * Expands RV32C compressed instructions into their 32-bit RV32I, RV32M,
+ * RV32F and RV32D equivalents. Every possible 16-bit parcel is expanded
+ * once into a 65536 entry table so that executing a compressed instruction
+ * costs one load.
+ * Illegal and reserved parcels expand to illegal_insn.
+ ********************************************************************************/
+class rv32c
+{
+public:
+    static uint32_t expand(uint16_t parcel, const char **mnemonic = nullptr);
+    static const uint32_t *get_table();
+
+    /// true if the parcel is the first half of a 32-bit instruction
+    static bool is_32bit(uint16_t parcel) { return (parcel & 0x3) == 0x3; }
+
+    static constexpr uint32_t illegal_insn = 0;
+
+private:
+    static uint32_t bits(uint32_t parcel, uint32_t hi, uint32_t lo);
+    static int32_t sign_extend(uint32_t val, uint32_t bit);
+
+    static uint32_t enc_r(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode);
+    static uint32_t enc_i(int32_t imm, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode);
+    static uint32_t enc_s(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t opcode);
+    static uint32_t enc_b(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3);
+    static uint32_t enc_u(int32_t imm, uint32_t rd);
+    static uint32_t enc_j(int32_t imm, uint32_t rd);
+};
+
+#endif
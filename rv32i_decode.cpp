@@ -10,6 +10,7 @@
 //***************************************************************************
 
 #include "rv32i_decode.h"
+#include "rv32c.h"
 #include <sstream>      // std::ostringstream
 #include <iomanip> //setw
 #include <cassert>//assert()
@@ -96,7 +97,30 @@ std::string rv32i_decode::decode(uint32_t addr, uint32_t insn)
             {
                 default: return render_illegal_insn(insn);
                 case funct3_add: return render_itype_alu(insn, "addi", get_imm_i(insn));
-                case funct3_sll: return render_itype_alu(insn, "slli", get_imm_i(insn)%XLEN);
+                case funct3_sll:
+                    switch(funct7)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct7_sll: return render_itype_alu(insn, "slli", get_imm_i(insn)%XLEN);
+                        case funct7_bclr: return render_itype_alu(insn, "bclri", get_imm_i(insn)%XLEN);
+                        case funct7_binv: return render_itype_alu(insn, "binvi", get_imm_i(insn)%XLEN);
+                        case funct7_bset: return render_itype_alu(insn, "bseti", get_imm_i(insn)%XLEN);
+
+                        //Zbb unary instructions select the operation with the rs2 field
+                        case funct7_rot:
+                            switch(get_rs2(insn))
+                            {
+                                default: return render_illegal_insn(insn);
+                                case rs2_clz: return render_rtype_unary(insn, "clz");
+                                case rs2_ctz: return render_rtype_unary(insn, "ctz");
+                                case rs2_cpop: return render_rtype_unary(insn, "cpop");
+                                case rs2_sext_b: return render_rtype_unary(insn, "sext.b");
+                                case rs2_sext_h: return render_rtype_unary(insn, "sext.h");
+                            }
+                            assert(0 && "unrecognized rs2"); // impossible
+                    }
+                    assert(0 && "unrecognized funct7"); // impossible
+
                 case funct3_slt: return render_itype_alu(insn, "slti", get_imm_i(insn));
                 case funct3_sltu: return render_itype_alu(insn, "sltiu", get_imm_i(insn));
                 case funct3_xor: return render_itype_alu(insn, "xori", get_imm_i(insn));
@@ -109,6 +133,14 @@ std::string rv32i_decode::decode(uint32_t addr, uint32_t insn)
                         default: return render_illegal_insn(insn);
                         case funct7_sra: return render_itype_alu(insn, "srai", get_imm_i(insn)%XLEN);
                         case funct7_srl: return render_itype_alu(insn, "srli", get_imm_i(insn)%XLEN);
+                        case funct7_rot: return render_itype_alu(insn, "rori", get_imm_i(insn)%XLEN);
+                        case funct7_bclr: return render_itype_alu(insn, "bexti", get_imm_i(insn)%XLEN);
+                        case funct7_binv:
+                            if (get_rs2(insn) == rs2_rev8) { return render_rtype_unary(insn, "rev8"); }
+                            return render_illegal_insn(insn);
+                        case funct7_bset:
+                            if (get_rs2(insn) == rs2_orc_b) { return render_rtype_unary(insn, "orc.b"); }
+                            return render_illegal_insn(insn);
                     }
                     assert(0 && "unrecognized funct7"); // impossible
             }
@@ -117,6 +149,79 @@ std::string rv32i_decode::decode(uint32_t addr, uint32_t insn)
         
         //R-TYPE INSTRUCTIONS
         case opcode_rtype:
+            //RV32M multiply and divide instructions
+            if (funct7 == funct7_mul)
+            {
+                switch (funct3)
+                {
+                    default: return render_illegal_insn(insn);
+                    case funct3_mul: return render_rtype(insn, "mul");
+                    case funct3_mulh: return render_rtype(insn, "mulh");
+                    case funct3_mulhsu: return render_rtype(insn, "mulhsu");
+                    case funct3_mulhu: return render_rtype(insn, "mulhu");
+                    case funct3_div: return render_rtype(insn, "div");
+                    case funct3_divu: return render_rtype(insn, "divu");
+                    case funct3_rem: return render_rtype(insn, "rem");
+                    case funct3_remu: return render_rtype(insn, "remu");
+                }
+                assert(0 && "unrecognized funct3"); // impossible
+            }
+
+            //Zba, Zbb and Zbs instructions that do not share a funct7 with RV32I
+            switch (funct7)
+            {
+                case funct7_zba:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_sh1add: return render_rtype(insn, "sh1add");
+                        case funct3_sh2add: return render_rtype(insn, "sh2add");
+                        case funct3_sh3add: return render_rtype(insn, "sh3add");
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_minmax:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_min: return render_rtype(insn, "min");
+                        case funct3_minu: return render_rtype(insn, "minu");
+                        case funct3_max: return render_rtype(insn, "max");
+                        case funct3_maxu: return render_rtype(insn, "maxu");
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_rot:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_sll: return render_rtype(insn, "rol");
+                        case funct3_srx: return render_rtype(insn, "ror");
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_zexth:
+                    if (funct3 == funct3_xor && get_rs2(insn) == 0) { return render_rtype_unary(insn, "zext.h"); }
+                    return render_illegal_insn(insn);
+
+                case funct7_bclr:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_sll: return render_rtype(insn, "bclr");
+                        case funct3_srx: return render_rtype(insn, "bext");
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_binv:
+                    if (funct3 == funct3_sll) { return render_rtype(insn, "binv"); }
+                    return render_illegal_insn(insn);
+
+                case funct7_bset:
+                    if (funct3 == funct3_sll) { return render_rtype(insn, "bset"); }
+                    return render_illegal_insn(insn);
+            }
+
             switch (funct3)
             {
                 default: return render_illegal_insn(insn);
@@ -133,9 +238,32 @@ std::string rv32i_decode::decode(uint32_t addr, uint32_t insn)
                 case funct3_sll: return render_rtype(insn, "sll");
                 case funct3_slt: return render_rtype(insn, "slt");
                 case funct3_sltu: return render_rtype(insn, "sltu");
-                case funct3_xor: return render_rtype(insn, "xor");
-                case funct3_or: return render_rtype(insn, "or");
-                case funct3_and: return render_rtype(insn, "and");  
+                case funct3_xor:
+                    switch(funct7)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct7_add: return render_rtype(insn, "xor");
+                        case funct7_sub: return render_rtype(insn, "xnor");
+                    }
+                    assert(0 && "unrecognized funct7"); // impossible
+
+                case funct3_or:
+                    switch(funct7)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct7_add: return render_rtype(insn, "or");
+                        case funct7_sub: return render_rtype(insn, "orn");
+                    }
+                    assert(0 && "unrecognized funct7"); // impossible
+
+                case funct3_and:
+                    switch(funct7)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct7_add: return render_rtype(insn, "and");
+                        case funct7_sub: return render_rtype(insn, "andn");
+                    }
+                    assert(0 && "unrecognized funct7"); // impossible
 
                 case funct3_srx:
                     switch(funct7)
@@ -149,12 +277,280 @@ std::string rv32i_decode::decode(uint32_t addr, uint32_t insn)
             assert(0 && "unrecognized funct3"); // impossible
 
 
+        //FLOATING POINT AND VECTOR LOADS AND STORES
+        case opcode_load_fp:
+            switch (funct3)
+            {
+                default: return render_illegal_insn(insn);
+                case funct3_flw: return render_fp_load(insn, "flw");
+                case funct3_fld: return render_fp_load(insn, "fld");
+                case funct3_vle8:
+                case funct3_vle16:
+                case funct3_vle32:
+                case funct3_vle64: return render_vmem(insn, false);
+            }
+            assert(0 && "unrecognized funct3"); // impossible
+
+        case opcode_store_fp:
+            switch (funct3)
+            {
+                default: return render_illegal_insn(insn);
+                case funct3_fsw: return render_fp_stype(insn, "fsw");
+                case funct3_fsd: return render_fp_stype(insn, "fsd");
+                case funct3_vle8:
+                case funct3_vle16:
+                case funct3_vle32:
+                case funct3_vle64: return render_vmem(insn, true);
+            }
+            assert(0 && "unrecognized funct3"); // impossible
+
+
+        //RV32F AND RV32D FUSED MULTIPLY-ADD INSTRUCTIONS
+        case opcode_fmadd:
+            switch (get_fmt(insn))
+            {
+                default: return render_illegal_insn(insn);
+                case fmt_s: return render_fp_r4type(insn, "fmadd.s");
+                case fmt_d: return render_fp_r4type(insn, "fmadd.d");
+            }
+            assert(0 && "unrecognized fmt"); // impossible
+
+        case opcode_fmsub:
+            switch (get_fmt(insn))
+            {
+                default: return render_illegal_insn(insn);
+                case fmt_s: return render_fp_r4type(insn, "fmsub.s");
+                case fmt_d: return render_fp_r4type(insn, "fmsub.d");
+            }
+            assert(0 && "unrecognized fmt"); // impossible
+
+        case opcode_fnmsub:
+            switch (get_fmt(insn))
+            {
+                default: return render_illegal_insn(insn);
+                case fmt_s: return render_fp_r4type(insn, "fnmsub.s");
+                case fmt_d: return render_fp_r4type(insn, "fnmsub.d");
+            }
+            assert(0 && "unrecognized fmt"); // impossible
+
+        case opcode_fnmadd:
+            switch (get_fmt(insn))
+            {
+                default: return render_illegal_insn(insn);
+                case fmt_s: return render_fp_r4type(insn, "fnmadd.s");
+                case fmt_d: return render_fp_r4type(insn, "fnmadd.d");
+            }
+            assert(0 && "unrecognized fmt"); // impossible
+
+
+        //RV32F AND RV32D COMPUTATIONAL INSTRUCTIONS
+        case opcode_op_fp:
+            switch (funct7)
+            {
+                default: return render_illegal_insn(insn);
+                case funct7_fadd_s: return render_fp_rtype(insn, "fadd.s", true);
+                case funct7_fadd_d: return render_fp_rtype(insn, "fadd.d", true);
+                case funct7_fsub_s: return render_fp_rtype(insn, "fsub.s", true);
+                case funct7_fsub_d: return render_fp_rtype(insn, "fsub.d", true);
+                case funct7_fmul_s: return render_fp_rtype(insn, "fmul.s", true);
+                case funct7_fmul_d: return render_fp_rtype(insn, "fmul.d", true);
+                case funct7_fdiv_s: return render_fp_rtype(insn, "fdiv.s", true);
+                case funct7_fdiv_d: return render_fp_rtype(insn, "fdiv.d", true);
+
+                case funct7_fsqrt_s:
+                    switch (get_rs2(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case 0: return render_fp_cvt(insn, "fsqrt.s", 'f', 'f', true);
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fsqrt_d:
+                    switch (get_rs2(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case 0: return render_fp_cvt(insn, "fsqrt.d", 'f', 'f', true);
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fsgnj_s:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_fsgnj: return render_fp_rtype(insn, "fsgnj.s", false);
+                        case funct3_fsgnjn: return render_fp_rtype(insn, "fsgnjn.s", false);
+                        case funct3_fsgnjx: return render_fp_rtype(insn, "fsgnjx.s", false);
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fsgnj_d:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_fsgnj: return render_fp_rtype(insn, "fsgnj.d", false);
+                        case funct3_fsgnjn: return render_fp_rtype(insn, "fsgnjn.d", false);
+                        case funct3_fsgnjx: return render_fp_rtype(insn, "fsgnjx.d", false);
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fminmax_s:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_fmin: return render_fp_rtype(insn, "fmin.s", false);
+                        case funct3_fmax: return render_fp_rtype(insn, "fmax.s", false);
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fminmax_d:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_fmin: return render_fp_rtype(insn, "fmin.d", false);
+                        case funct3_fmax: return render_fp_rtype(insn, "fmax.d", false);
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fcmp_s:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_feq: return render_fp_compare(insn, "feq.s");
+                        case funct3_flt: return render_fp_compare(insn, "flt.s");
+                        case funct3_fle: return render_fp_compare(insn, "fle.s");
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fcmp_d:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_feq: return render_fp_compare(insn, "feq.d");
+                        case funct3_flt: return render_fp_compare(insn, "flt.d");
+                        case funct3_fle: return render_fp_compare(insn, "fle.d");
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fcvt_s_d:
+                    switch (get_rs2(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case fmt_d: return render_fp_cvt(insn, "fcvt.s.d", 'f', 'f', true);
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fcvt_d_s:
+                    switch (get_rs2(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case fmt_s: return render_fp_cvt(insn, "fcvt.d.s", 'f', 'f', false);
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fcvt_w_s:
+                    switch (get_rs2(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case rs2_fcvt_w: return render_fp_cvt(insn, "fcvt.w.s", 'x', 'f', true);
+                        case rs2_fcvt_wu: return render_fp_cvt(insn, "fcvt.wu.s", 'x', 'f', true);
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fcvt_w_d:
+                    switch (get_rs2(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case rs2_fcvt_w: return render_fp_cvt(insn, "fcvt.w.d", 'x', 'f', true);
+                        case rs2_fcvt_wu: return render_fp_cvt(insn, "fcvt.wu.d", 'x', 'f', true);
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fcvt_s_w:
+                    switch (get_rs2(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case rs2_fcvt_w: return render_fp_cvt(insn, "fcvt.s.w", 'f', 'x', true);
+                        case rs2_fcvt_wu: return render_fp_cvt(insn, "fcvt.s.wu", 'f', 'x', true);
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fcvt_d_w:
+                    switch (get_rs2(insn))
+                    {
+                        default: return render_illegal_insn(insn);
+                        case rs2_fcvt_w: return render_fp_cvt(insn, "fcvt.d.w", 'f', 'x', false);
+                        case rs2_fcvt_wu: return render_fp_cvt(insn, "fcvt.d.wu", 'f', 'x', false);
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fmv_x_w:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_fmv: return render_fp_cvt(insn, "fmv.x.w", 'x', 'f', false);
+                        case funct3_fclass: return render_fp_cvt(insn, "fclass.s", 'x', 'f', false);
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fclass_d:
+                    switch (funct3)
+                    {
+                        default: return render_illegal_insn(insn);
+                        case funct3_fclass: return render_fp_cvt(insn, "fclass.d", 'x', 'f', false);
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fmv_w_x:
+                    if (funct3 == funct3_fmv && get_rs2(insn) == 0) { return render_fp_cvt(insn, "fmv.w.x", 'f', 'x', false); }
+                    return render_illegal_insn(insn);
+            }
+            assert(0 && "unrecognized funct7"); // impossible
+
+
+        //RVV INSTRUCTIONS
+        case opcode_op_v:
+            switch (funct3)
+            {
+                default: return render_illegal_insn(insn);
+                case funct3_opcfg: return render_vsetvl(insn);
+                case funct3_opivv:
+                case funct3_opivx:
+                case funct3_opivi: return render_vopi(insn);
+                case funct3_opmvv:
+                case funct3_opmvx: return render_vopm(insn);
+            }
+            assert(0 && "unrecognized funct3"); // impossible
+
+        //HOST BULK MEMORY SERVICE
+        case opcode_custom_0:
+            //the operands are always a0-a2 so every other field is zero
+            if (insn & ~0x0000707f)
+            {
+                return render_illegal_insn(insn);
+            }
+
+            switch(funct3)
+            {
+                default: return render_illegal_insn(insn);
+                case funct3_bulk_cpy: return render_bulk(insn, "bulk.cpy");
+                case funct3_bulk_set: return render_bulk(insn, "bulk.set");
+                case funct3_bulk_cmp: return render_bulk(insn, "bulk.cmp");
+            }
+            assert(0 && "unrecognized funct3"); // impossible
+
         case opcode_system:
             //EBBREAK AND ECALL
             switch(insn)
             {
                 case insn_ebreak: return render_ebreak(insn);
                 case insn_ecall: return render_ecall(insn);
+                case insn_mret: return render_mret(insn);
+                case insn_wfi: return render_wfi(insn);
+            }
+
+            if (funct3 == 0 && funct7 == funct7_sfence_vma && get_rd(insn) == 0)
+            {
+                return render_sfence_vma(insn);
             }
 
             switch(funct3)
@@ -178,6 +574,61 @@ std::string rv32i_decode::decode(uint32_t addr, uint32_t insn)
 
 }//end decode
 
+/**
+ * Decodes a 16-bit compressed instruction. The instruction is expanded to
+ * its 32-bit form and rendered with the compressed mnemonic in front of
+ * the operands of the expanded form, less the ones the compressed encoding
+ * implies (c.li x5,5 rather than c.li x5,x0,5).
+ *
+ * @param addr unsigned 32 bit integer that contains the memory address from 
+ * which the instruction has been fetched.
+ * @param parcel the 16-bit compressed instruction.
+ *
+ * @return string containing the disassembled instruction text
+ ********************************************************************************/
+std::string rv32i_decode::decode_compressed(uint32_t addr, uint16_t parcel)
+{
+    const char *mnemonic;
+    uint32_t insn = rv32c::expand(parcel, &mnemonic);
+
+    if (insn == rv32c::illegal_insn)
+    {
+        return render_illegal_insn(parcel);
+    }
+
+    //swap the expanded mnemonic for the compressed one
+    std::string expanded = decode(addr, insn);
+    std::string m = mnemonic;
+    if (expanded.size() <= static_cast<size_t>(mnemonic_width) || m == "c.nop")
+    {
+        return mnemonic;
+    }
+    std::string ops = expanded.substr(mnemonic_width);
+    size_t first = ops.find(',');
+    size_t second = ops.find(',', first + 1);
+
+    if (m == "c.j" || m == "c.jal")
+    {
+        //jal x0/x1,target
+        ops = ops.substr(first + 1);
+    }
+    else if (m == "c.jr" || m == "c.jalr")
+    {
+        //jalr x0/x1,0(rs1)
+        size_t open = ops.find('(');
+        ops = ops.substr(open + 1, ops.find(')') - open - 1);
+    }
+    else if (second != std::string::npos && (m == "c.li" || m == "c.addi" || m == "c.addi16sp"
+        || m == "c.slli" || m == "c.srli" || m == "c.srai" || m == "c.andi" || m == "c.mv"
+        || m == "c.add" || m == "c.sub" || m == "c.xor" || m == "c.or" || m == "c.and"
+        || m == "c.beqz" || m == "c.bnez"))
+    {
+        //the second operand is rd again, x0 or x2
+        ops.erase(first, second - first);
+    }
+    return render_mnemonic(mnemonic) + ops;
+}
+
 
 
 /*
@@ -264,6 +715,179 @@ uint32_t rv32i_decode::get_funct7(uint32_t insn)
     return ((insn & 0xfe000000) >> (25-0));
 }
 
+/**
+ * Extracts the rs3 field of the R4-type fused multiply-add instructions.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to extract.
+ *
+ * @return unsigned integer rs3 field
+ ********************************************************************************/
+uint32_t rv32i_decode::get_rs3(uint32_t insn)
+{
+    //extract 5 bits at 31->27 and shift to 0th bit
+    return ((insn & 0xf8000000) >> (27-0));
+}
+
+/**
+ * Extracts the fmt field of the floating point instructions that selects
+ * single (fmt_s) or double (fmt_d) precision.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to extract.
+ *
+ * @return unsigned integer fmt field
+ ********************************************************************************/
+uint32_t rv32i_decode::get_fmt(uint32_t insn)
+{
+    //extract 2 bits at 26->25 and shift to 0th bit
+    return ((insn & 0x06000000) >> (25-0));
+}
+
+/**
+ * Extracts the funct6 field of the vector arithmetic instructions.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to extract.
+ *
+ * @return unsigned integer funct6 field
+ ********************************************************************************/
+uint32_t rv32i_decode::get_funct6(uint32_t insn)
+{
+    //extract 6 bits at 31->26 and shift to 0th bit
+    return ((insn & 0xfc000000) >> (26-0));
+}
+
+/**
+ * Extracts the vm field of the vector instructions. It is 0 when the
+ * instruction is masked by v0.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to extract.
+ *
+ * @return unsigned integer vm field
+ ********************************************************************************/
+uint32_t rv32i_decode::get_vm(uint32_t insn)
+{
+    //extract bit 25 and shift to 0th bit
+    return ((insn & 0x02000000) >> (25-0));
+}
+
+/**
+ * Extracts the signed 5-bit immediate of the vector .vi instructions, which
+ * is held in the rs1 field.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to extract.
+ *
+ * @return signed integer immediate value
+ ********************************************************************************/
+int32_t rv32i_decode::get_simm5(uint32_t insn)
+{
+    //extract 5 bits at 19->15 and sign extend from bit 4
+    int32_t simm5 = (insn & 0x000f8000) >> (15-0);
+    return (simm5 & 0x10) ? simm5 - 0x20 : simm5;
+}
+
+/**
+ * Returns the element width of a vector load or store.
+ *
+ * @param width the width (funct3) field of the load or store.
+ *
+ * @return element width in bits, or 0 if width is not a vector width.
+ ********************************************************************************/
+uint32_t rv32i_decode::get_veew(uint32_t width)
+{
+    switch (width)
+    {
+        default: return 0;
+        case funct3_vle8: return 8;
+        case funct3_vle16: return 16;
+        case funct3_vle32: return 32;
+        case funct3_vle64: return 64;
+    }
+}
+
+/**
+ * Returns the mnemonic (without the operand suffix) of an OPIVV, OPIVX or
+ * OPIVI vector integer instruction.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction.
+ *
+ * @return the mnemonic, or nullptr if the instruction is not implemented.
+ ********************************************************************************/
+const char *rv32i_decode::get_vopi_name(uint32_t insn)
+{
+    uint32_t funct3 = get_funct3(insn);
+    bool vv = funct3 == funct3_opivv;
+    bool vi = funct3 == funct3_opivi;
+
+    switch (get_funct6(insn))
+    {
+        default: return nullptr;
+        case funct6_vadd: return "vadd";
+        case funct6_vsub: return vi ? nullptr : "vsub";
+        case funct6_vrsub: return vv ? nullptr : "vrsub";
+        case funct6_vminu: return vi ? nullptr : "vminu";
+        case funct6_vmin: return vi ? nullptr : "vmin";
+        case funct6_vmaxu: return vi ? nullptr : "vmaxu";
+        case funct6_vmax: return vi ? nullptr : "vmax";
+        case funct6_vand: return "vand";
+        case funct6_vor: return "vor";
+        case funct6_vxor: return "vxor";
+        case funct6_vmseq: return "vmseq";
+        case funct6_vmsne: return "vmsne";
+        case funct6_vmsltu: return vi ? nullptr : "vmsltu";
+        case funct6_vmslt: return vi ? nullptr : "vmslt";
+        case funct6_vmsleu: return "vmsleu";
+        case funct6_vmsle: return "vmsle";
+        case funct6_vmsgtu: return vv ? nullptr : "vmsgtu";
+        case funct6_vmsgt: return vv ? nullptr : "vmsgt";
+        case funct6_vsll: return "vsll";
+        case funct6_vsrl: return "vsrl";
+        case funct6_vsra: return "vsra";
+
+        //vmv.v.* is the unmasked form of vmerge and has no vs2
+        case funct6_vmerge:
+            if (!get_vm(insn))
+                return "vmerge";
+            return (get_rs2(insn) == 0) ? "vmv.v" : nullptr;
+    }
+}
+
+/**
+ * Returns the mnemonic (without the operand suffix) of an OPMVV or OPMVX
+ * vector instruction.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction.
+ *
+ * @return the mnemonic, or nullptr if the instruction is not implemented.
+ ********************************************************************************/
+const char *rv32i_decode::get_vopm_name(uint32_t insn)
+{
+    bool vv = get_funct3(insn) == funct3_opmvv;
+
+    switch (get_funct6(insn))
+    {
+        default: return nullptr;
+        case funct6_vredsum: return vv ? "vredsum" : nullptr;
+        case funct6_vredand: return vv ? "vredand" : nullptr;
+        case funct6_vredor: return vv ? "vredor" : nullptr;
+        case funct6_vredxor: return vv ? "vredxor" : nullptr;
+        case funct6_vredminu: return vv ? "vredminu" : nullptr;
+        case funct6_vredmin: return vv ? "vredmin" : nullptr;
+        case funct6_vredmaxu: return vv ? "vredmaxu" : nullptr;
+        case funct6_vredmax: return vv ? "vredmax" : nullptr;
+        case funct6_vmulhu: return "vmulhu";
+        case funct6_vmul: return "vmul";
+        case funct6_vmulh: return "vmulh";
+        case funct6_vmacc: return "vmacc";
+
+        //vmv.x.s and vmv.s.x are unmasked and use only one vector register
+        case funct6_vwxunary0:
+            if (!get_vm(insn))
+                return nullptr;
+            if (vv)
+                return (get_rs1(insn) == 0) ? "vmv.x.s" : nullptr;
+            return (get_rs2(insn) == 0) ? "vmv.s.x" : nullptr;
+    }
+}
+
 /**
  * Extracts the immediate value for i-type instructions.
  *
@@ -645,6 +1269,33 @@ std::string rv32i_decode::render_rtype(uint32_t insn, const char *mnemonic)
     return os.str();           
 }
 
+/**
+ * Renders the single source r-type instructions of the Zbb extension
+ * (clz, ctz, cpop, sext.b, sext.h, zext.h, orc.b and rev8) whose rs2
+ * field selects the operation rather than naming a register.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ * @param mnemonic the mnemonic for that instruction.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_rtype_unary(uint32_t insn, const char *mnemonic)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+
+    //          mnemonic                        rd        ,         rs1
+    os << render_mnemonic(mnemonic) << render_reg(rd) << "," << render_reg(rs1);
+
+    return os.str();
+}
+
 /**
  * Renders the ecall instruction.
  *
@@ -677,6 +1328,78 @@ std::string rv32i_decode::render_ebreak(uint32_t insn)
     return os.str();     
 }
 
+/**
+ * Renders the host bulk memory instructions. They have no operand fields
+ * because they always work on a0, a1 and a2.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ * @param mnemonic the mnemonic for that bulk memory instruction.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_bulk(uint32_t insn, const char *mnemonic)
+{
+    (void)insn;
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+    os << mnemonic;
+
+    return os.str();
+}
+
+/**
+ * Renders the mret instruction.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_mret(uint32_t insn)
+{
+    (void)insn;
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+    os << "mret";
+
+    return os.str();
+}
+
+/**
+ * Renders the wfi instruction.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_wfi(uint32_t insn)
+{
+    (void)insn;
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+    os << "wfi";
+
+    return os.str();
+}
+
+/**
+ * Renders the sfence.vma instruction.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_sfence_vma(uint32_t insn)
+{
+    //render the instruction with proper formatting
+    std::ostringstream os;
+    os << render_mnemonic("sfence.vma") << render_reg(get_rs1(insn)) << "," << render_reg(get_rs2(insn));
+
+    return os.str();
+}
+
 /**
  * Renders the csrrx-type instructions.
  *
@@ -735,6 +1458,437 @@ std::string rv32i_decode::render_csrrxi(uint32_t insn, const char *mnemonic)
 }
 
 
+/**
+ * Renders the floating point load instructions.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ * @param mnemonic the mnemonic for that load instruction.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_fp_load(uint32_t insn, const char *mnemonic)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+
+    //      load mnemonic                        rd        ,         imm(rs1)
+    os << render_mnemonic(mnemonic) << render_freg(rd) << "," << render_base_disp(rs1, imm_i);
+
+    return os.str();
+}
+
+/**
+ * Renders the floating point store instructions.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ * @param mnemonic the mnemonic for that store instruction.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_fp_stype(uint32_t insn, const char *mnemonic)
+{
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for s-type instruction
+    int32_t imm_s = get_imm_s(insn);
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+
+    //      store mnemonic                      rs2         ,         imm(rs1)
+    os << render_mnemonic(mnemonic) << render_freg(rs2) << "," << render_base_disp(rs1, imm_s);
+
+    return os.str();
+}
+
+/**
+ * Renders the floating point instructions with two source registers.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ * @param mnemonic the mnemonic for that instruction.
+ * @param rm true if funct3 is a rounding mode that should be shown.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_fp_rtype(uint32_t insn, const char *mnemonic, bool rm)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+
+    //          mnemonic                         rd         ,         rs1             ,           rs2
+    os << render_mnemonic(mnemonic) << render_freg(rd) << "," << render_freg(rs1) << "," << render_freg(rs2);
+    if (rm)
+    {
+        os << render_rm(get_funct3(insn));
+    }
+
+    return os.str();
+}
+
+/**
+ * Renders the R4-type fused multiply-add instructions.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ * @param mnemonic the mnemonic for that instruction.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_fp_r4type(uint32_t insn, const char *mnemonic)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get the three source operands
+    uint32_t rs1 = get_rs1(insn);
+    uint32_t rs2 = get_rs2(insn);
+    uint32_t rs3 = get_rs3(insn);
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+
+    //          mnemonic                         rd         ,         rs1             ,           rs2           ,           rs3
+    os << render_mnemonic(mnemonic) << render_freg(rd) << "," << render_freg(rs1) << "," << render_freg(rs2) << "," << render_freg(rs3);
+    os << render_rm(get_funct3(insn));
+
+    return os.str();
+}
+
+/**
+ * Renders the floating point instructions with a single source register,
+ * including the moves and conversions between the x and f registers.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ * @param mnemonic the mnemonic for that instruction.
+ * @param rd_file 'x' or 'f', the register file rd belongs to.
+ * @param rs1_file 'x' or 'f', the register file rs1 belongs to.
+ * @param rm true if funct3 is a rounding mode that should be shown.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_fp_cvt(uint32_t insn, const char *mnemonic, char rd_file, char rs1_file, bool rm)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+
+    //          mnemonic                                                rd                         ,
+    os << render_mnemonic(mnemonic) << (rd_file == 'f' ? render_freg(rd) : render_reg(rd)) << ",";
+
+    //                      rs1
+    os << (rs1_file == 'f' ? render_freg(rs1) : render_reg(rs1));
+    if (rm)
+    {
+        os << render_rm(get_funct3(insn));
+    }
+
+    return os.str();
+}
+
+/**
+ * Renders the floating point compare instructions, which write an x
+ * register.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ * @param mnemonic the mnemonic for that instruction.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_fp_compare(uint32_t insn, const char *mnemonic)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+
+    //          mnemonic                        rd        ,         rs1              ,           rs2
+    os << render_mnemonic(mnemonic) << render_reg(rd) << "," << render_freg(rs1) << "," << render_freg(rs2);
+
+    return os.str();
+}
+
+/**
+ * Renders the vsetvli, vsetivli and vsetvl instructions.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_vsetvl(uint32_t insn)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand (the AVL register or immediate)
+    uint32_t rs1 = get_rs1(insn);
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+
+    if (!(insn & 0x80000000))
+    {
+        //          vsetvli                          rd        ,         rs1             ,           vtype
+        os << render_mnemonic("vsetvli") << render_reg(rd) << "," << render_reg(rs1) << "," << render_vtype((insn >> 20) & 0x7ff);
+    }
+    else if ((insn & 0xc0000000) == 0xc0000000)
+    {
+        //          vsetivli                          rd        ,   uimm ,           vtype
+        os << render_mnemonic("vsetivli") << render_reg(rd) << "," << rs1 << "," << render_vtype((insn >> 20) & 0x3ff);
+    }
+    else if (get_funct7(insn) == funct7_vsetvl)
+    {
+        //          vsetvl                          rd        ,         rs1             ,           rs2
+        os << render_mnemonic("vsetvl") << render_reg(rd) << "," << render_reg(rs1) << "," << render_reg(get_rs2(insn));
+    }
+    else
+    {
+        return render_illegal_insn(insn);
+    }
+
+    return os.str();
+}
+
+/**
+ * Renders the vector loads and stores.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ * @param store true for the store opcode.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_vmem(uint32_t insn, bool store)
+{
+    //get the vector data register
+    uint32_t vd = get_rd(insn);
+
+    //get the base address register
+    uint32_t rs1 = get_rs1(insn);
+
+    //number of fields, addressing mode and element width
+    uint32_t nf = (insn >> 29) & 0x7;
+    uint32_t mop = (insn >> 26) & 0x3;
+    uint32_t eew = get_veew(get_funct3(insn));
+    bool vm = get_vm(insn);
+
+    if ((insn & 0x10000000) || eew == 0)
+    {
+        return render_illegal_insn(insn);
+    }
+
+    std::ostringstream m;
+    std::string stride;
+
+    switch (mop)
+    {
+        default:
+            return render_illegal_insn(insn);
+
+        case mop_unit:
+            switch (get_rs2(insn))
+            {
+                default:
+                    return render_illegal_insn(insn);
+
+                case umop_unit:
+                    if (nf != 0)
+                        return render_illegal_insn(insn);
+                    m << (store ? "vse" : "vle") << eew << ".v";
+                    break;
+
+                case umop_whole:
+                    //1, 2, 4 or 8 registers, stores only have the 8-bit form
+                    if (!vm || (nf & (nf + 1)) != 0 || (store && eew != 8))
+                        return render_illegal_insn(insn);
+                    if (store)
+                        m << "vs" << nf + 1 << "r.v";
+                    else
+                        m << "vl" << nf + 1 << "re" << eew << ".v";
+                    break;
+
+                case umop_mask:
+                    if (!vm || nf != 0 || eew != 8)
+                        return render_illegal_insn(insn);
+                    m << (store ? "vsm.v" : "vlm.v");
+                    break;
+            }
+            break;
+
+        case mop_strided:
+            if (nf != 0)
+                return render_illegal_insn(insn);
+            m << (store ? "vsse" : "vlse") << eew << ".v";
+            stride = "," + render_reg(get_rs2(insn));
+            break;
+    }
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+
+    //          mnemonic                     vd       ,   (     rs1          )    [,rs2]
+    os << render_mnemonic(m.str()) << render_vreg(vd) << ",(" << render_reg(rs1) << ")" << stride;
+    if (!vm)
+    {
+        os << ",v0.t";
+    }
+
+    return os.str();
+}
+
+/**
+ * Renders the OPIVV, OPIVX and OPIVI vector integer instructions.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_vopi(uint32_t insn)
+{
+    const char *name = get_vopi_name(insn);
+    if (!name)
+    {
+        return render_illegal_insn(insn);
+    }
+
+    uint32_t funct3 = get_funct3(insn);
+    uint32_t funct6 = get_funct6(insn);
+    uint32_t vd = get_rd(insn);
+    uint32_t vs2 = get_rs2(insn);
+    uint32_t rs1 = get_rs1(insn);
+
+    //the last operand is a vector register, a scalar register or an
+    //immediate, which is unsigned for the shifts
+    std::string src;
+    char form;
+    if (funct3 == funct3_opivv)
+    {
+        src = render_vreg(rs1);
+        form = 'v';
+    }
+    else if (funct3 == funct3_opivx)
+    {
+        src = render_reg(rs1);
+        form = 'x';
+    }
+    else
+    {
+        bool shift = funct6 == funct6_vsll || funct6 == funct6_vsrl || funct6 == funct6_vsra;
+        src = shift ? std::to_string(rs1) : std::to_string(get_simm5(insn));
+        form = 'i';
+    }
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+
+    if (funct6 == funct6_vmerge && get_vm(insn))
+    {
+        //          vmv.v.x                                                vd         ,    src
+        os << render_mnemonic(std::string(name) + "." + form) << render_vreg(vd) << "," << src;
+    }
+    else if (funct6 == funct6_vmerge)
+    {
+        //          vmerge.vxm                                                    vd         ,           vs2          ,     src  ,v0
+        os << render_mnemonic(std::string(name) + ".v" + form + "m") << render_vreg(vd) << "," << render_vreg(vs2) << "," << src << ",v0";
+    }
+    else
+    {
+        //          vadd.vx                                                  vd         ,           vs2          ,     src
+        os << render_mnemonic(std::string(name) + ".v" + form) << render_vreg(vd) << "," << render_vreg(vs2) << "," << src;
+        if (!get_vm(insn))
+        {
+            os << ",v0.t";
+        }
+    }
+
+    return os.str();
+}
+
+/**
+ * Renders the OPMVV and OPMVX vector instructions.
+ *
+ * @param insn unsigned 32 bit integer that contains the instruction to render.
+ *
+ * @return string with rendered instruction.
+ ********************************************************************************/
+std::string rv32i_decode::render_vopm(uint32_t insn)
+{
+    const char *name = get_vopm_name(insn);
+    if (!name)
+    {
+        return render_illegal_insn(insn);
+    }
+
+    bool vv = get_funct3(insn) == funct3_opmvv;
+    uint32_t funct6 = get_funct6(insn);
+    uint32_t vd = get_rd(insn);
+    uint32_t vs2 = get_rs2(insn);
+    uint32_t rs1 = get_rs1(insn);
+    std::string src = vv ? render_vreg(rs1) : render_reg(rs1);
+
+    //render the instruction with proper formatting
+    std::ostringstream os;
+
+    if (funct6 == funct6_vwxunary0 && vv)
+    {
+        //          vmv.x.s                   rd        ,           vs2
+        os << render_mnemonic(name) << render_reg(vd) << "," << render_vreg(vs2);
+    }
+    else if (funct6 == funct6_vwxunary0)
+    {
+        //          vmv.s.x                    vd        ,     rs1
+        os << render_mnemonic(name) << render_vreg(vd) << "," << src;
+    }
+    else if (funct6 == funct6_vmacc)
+    {
+        //the multiply-add instructions list the multiplier before vs2
+        os << render_mnemonic(std::string(name) + (vv ? ".vv" : ".vx")) << render_vreg(vd) << "," << src << "," << render_vreg(vs2);
+    }
+    else
+    {
+        //          vredsum.vs / vmul.vx                                                     vd        ,           vs2          ,     src
+        os << render_mnemonic(std::string(name) + (funct6 <= funct6_vredmax ? ".vs" : vv ? ".vv" : ".vx")) << render_vreg(vd) << "," << render_vreg(vs2) << "," << src;
+    }
+
+    if (!get_vm(insn))
+    {
+        os << ",v0.t";
+    }
+
+    return os.str();
+}
+
 /*
     INSTRUCTION HELPER FUNCTIONS
 */
@@ -754,6 +1908,74 @@ std::string rv32i_decode::render_reg(int r)
     return os.str();
 }
 
+/**
+ * Render the name of the given floating point register.
+ *
+ * @param r integer that holds the number of the register to be rendered.
+ *
+ * @return string with the name of the register.
+ ********************************************************************************/
+std::string rv32i_decode::render_freg(int r)
+{
+    //render register with proper format
+    std::ostringstream os;
+    os << "f" << r;
+    return os.str();
+}
+
+/**
+ * Render the rounding mode operand of a floating point instruction. The
+ * dynamic rounding mode is the default and is not shown.
+ *
+ * @param rm the rounding mode field.
+ *
+ * @return string with the rounding mode preceded by a comma, or an empty
+ * string for the dynamic rounding mode.
+ ********************************************************************************/
+std::string rv32i_decode::render_rm(uint32_t rm)
+{
+    static const char *names[] = { "rne", "rtz", "rdn", "rup", "rmm", "5", "6", "dyn" };
+
+    if (rm == rm_dyn)
+    {
+        return "";
+    }
+    return std::string(",") + names[rm & 0x7];
+}
+
+/**
+ * Render the name of the given vector register.
+ *
+ * @param r integer that holds the number of the register to be rendered.
+ *
+ * @return string with the name of the register.
+ ********************************************************************************/
+std::string rv32i_decode::render_vreg(int r)
+{
+    //render register with proper format
+    std::ostringstream os;
+    os << "v" << r;
+    return os.str();
+}
+
+/**
+ * Render a vtype value the way vsetvli writes it, for example
+ * "e32,m1,ta,ma".
+ *
+ * @param vtype the vtype value.
+ *
+ * @return string with the element width, LMUL and tail and mask policies.
+ ********************************************************************************/
+std::string rv32i_decode::render_vtype(uint32_t vtype)
+{
+    static const char *lmul[] = { "m1", "m2", "m4", "m8", "m?", "mf8", "mf4", "mf2" };
+
+    std::ostringstream os;
+    os << "e" << (8 << ((vtype >> 3) & 0x7)) << "," << lmul[vtype & 0x7];
+    os << ((vtype & vtype_vta) ? ",ta" : ",tu") << ((vtype & vtype_vma) ? ",ma" : ",mu");
+    return os.str();
+}
+
 /**
  * Render the operands in the format "disp(base)" for the s-type and i-type
  * instructions.
@@ -780,8 +2002,9 @@ std::string rv32i_decode::render_base_disp(uint32_t base, int32_t disp)
  ********************************************************************************/
 std::string rv32i_decode::render_mnemonic(const std::string &m)
 {
-    //render mnemonic with proper format
+    //render mnemonic with proper format, mnemonics that fill the whole
+    //width still get a space before the operands
     std::ostringstream os;
-    os << std::setw(mnemonic_width) << std::left << m;
+    os << std::setw(mnemonic_width - 1) << std::left << m << " ";
     return os.str();
 }
\ No newline at end of file
@@ -11,6 +11,15 @@
 
 #include "rv32i_hart.h"
 #include "rv32i_decode.h"
+#include "bbv_profiler.h"
+#include "rv32c.h"
+#include "syscall_proxy.h"
+#include <algorithm>    //min
+#include <cstring>      //strnlen, memcpy
+#include <cstdint>      //INT32_MIN
+#include <cmath>        //fma, sqrt, rint
+#include <cfenv>        //fesetround, fetestexcept
+#include <type_traits>  //make_unsigned
 
 using std::cout;
 using std::endl;
@@ -30,25 +39,68 @@ void rv32i_hart::tick(const std::string& hdr)
         dump(hdr);
     }
 
-    //set flags and return from function if pc reg is not multiple of 4
-    if ((pc & 3) != 0)
+    //take an enabled interrupt at the instruction boundary, pending is
+    //only non-zero when one can be taken. Without a trap vector that
+    //halts the hart, and nothing more may run
+    if (pending)
     {
-        halt = true;
-        halt_reason = "PC alignment error";
+        take_interrupt();
+        if (halt)
+        {
+            return;
+        }
+    }
+
+    //trap and return from function if pc reg is not multiple of 2
+    if ((pc & 1) != 0)
+    {
+        trap(cause_insn_misaligned, pc, "PC alignment error");
         return;
     }
 
     //increment the instruction counter
     insn_counter++;
 
-    //fetch an instruction from the memory at the address in the pc register
-    uint32_t insn = mem.get32(pc);
+    //fetch the instruction at the address in the pc register. Inside the
+    //cached executable page it is read straight from the host, anything
+    //else goes through fetch_insn() where a fault traps before anything
+    //executes
+    uint32_t insn;
+    uint32_t offset = pc & (memory::page_size - 1);
+    if (pc - offset == fetch_page && offset <= memory::page_size - 4)
+    {
+        const uint8_t *p = fetch_host + offset;
+        insn = p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+    }
+    else if (!fetch_insn(insn))
+    {
+        return;
+    }
+    uint16_t parcel = insn;
+
+    //expand a compressed instruction with one table lookup
+    if (rv32c::is_32bit(parcel))
+    {
+        insn_length = 4;
+    }
+    else
+    {
+        insn = rvc_table[parcel];
+        insn_length = 2;
+    }
 
     //print and execute the instruction
     if(show_instructions)
     {
         //print the hdr, pc register, and fetched instructions
-        cout << hdr << to_hex32(pc) << ": " << to_hex32(insn) << "  ";
+        if (insn_length == 2)
+        {
+            cout << hdr << to_hex32(pc) << ": " << to_hex16(parcel) << "      ";
+        }
+        else
+        {
+            cout << hdr << to_hex32(pc) << ": " << to_hex32(insn) << "  ";
+        }
 
         //execute and render the instruction and simulation details
         exec(insn, &std::cout);
@@ -72,10 +124,19 @@ void rv32i_hart::dump(const std::string& hdr) const
 {
     //dump the entire state of the hart prefixed with hdr string
     regs.dump(hdr);
+    fregs.dump(hdr);
 
     //dump the pc register
     cout << hdr << " pc " << to_hex32(pc) << endl;
 
+    //dump the floating point control and status register
+    cout << hdr << "fcsr " << to_hex32(fcsr) << endl;
+
+    //dump the vector registers and configuration
+    vregs.dump(hdr);
+    cout << hdr << "  vl " << to_hex32(vl) << endl;
+    cout << hdr << "vtype " << to_hex32(vtype) << endl;
+
 }
 
 /**
@@ -85,302 +146,6603 @@ void rv32i_hart::dump(const std::string& hdr) const
 void rv32i_hart::reset()
 {
     //reset a hart
-    pc = 0;
+    pc = reset_pc;
     regs.reset();
+    fregs.reset();
+    fcsr = 0;
+    vregs.reset();
+    vl = 0;
+    vtype = vtype_vill;
+    cycle_base = 0;
+    instret_base = 0;
+    mcountinhibit = 0;
+    mstatus = mstatus_mpp;
+    mie = 0;
+    mip = 0;
+    mtvec = 0;
+    mscratch = 0;
+    mepc = 0;
+    mcause = 0;
+    mtval = 0;
+    pending = 0;
+    priv = priv_m;
+    satp = 0;
+    mcounteren = 0;
+    scounteren = 0;
+    flush_tlb();
     insn_counter = 0;
     halt = false;
     halt_reason = "none";
 }
 
 /**
- * @brief Method will execute the given RV32I instruction by
- * making use of the get_xxx() methods to extract the needed
- * instruction fields to decode the instruction and invoke the
- * associated exec_xxx() helper function.
+ * @brief Method that copies the state of the hart into a hart_state.
  * 
- * @param insn RV32I instruction to be executed.
- * @param pos flag to determine instructions need to print.
+ * @param s hart_state that receives the pc, registers, instruction
+ * counter and halt status.
  */
-void rv32i_hart::exec(uint32_t insn, std::ostream* pos)
+void rv32i_hart::get_state(hart_state &s) const
 {
-    //get funct3
-    uint32_t funct3 = get_funct3(insn);
-
-    //get funct7
-    uint32_t funct7 = get_funct7(insn);
+    s.pc = pc;
+    s.halt = halt;
+    s.insn_counter = insn_counter;
 
-    switch(get_opcode(insn))
+    for (uint32_t r = 0; r < 32; r++)
     {
-        default:  exec_illegal_insn(insn, pos); return;
-
-        //U-TYPE INSTRUCTIONS
-        case opcode_lui:   exec_lui(insn, pos); return;
-        case opcode_auipc:  exec_auipc(insn, pos); return;
+        s.regs[r] = regs.get(r);
+        s.fregs[r] = fregs.get(r);
+    }
+    s.fcsr = fcsr;
+
+    //the vector registers are saved at the width they were configured with
+    s.vlen = vregs.get_vlen();
+    s.vl = vl;
+    s.vtype = vtype;
+    memcpy(s.vregs, vregs.get(0), 32 * vregs.get_vlenb());
+
+    s.cycle_base = cycle_base;
+    s.instret_base = instret_base;
+    s.mcountinhibit = mcountinhibit;
+
+    s.mstatus = mstatus;
+    s.mie = mie;
+    s.mip = mip;
+    s.mtvec = mtvec;
+    s.mscratch = mscratch;
+    s.mepc = mepc;
+    s.mcause = mcause;
+    s.mtval = mtval;
+
+    s.priv = priv;
+    s.satp = satp;
+    s.mcounteren = mcounteren;
+    s.scounteren = scounteren;
+
+    //copy the halt reason and keep it terminated
+    halt_reason.copy(s.halt_reason, sizeof(s.halt_reason) - 1);
+    s.halt_reason[std::min(halt_reason.size(), sizeof(s.halt_reason) - 1)] = '\0';
+}
 
-        //J-TYPE INSTRUCTIONS
-        // case opcode_jal:  exec_jal(pc, insn, pos); return;
-        case opcode_jal:  exec_jal(insn, pos); return;
+/**
+ * @brief Method that resumes the hart from a hart_state.
+ * 
+ * @param s hart_state saved by get_state().
+ */
+void rv32i_hart::set_state(const hart_state &s)
+{
+    pc = s.pc;
+    halt = s.halt;
+    insn_counter = s.insn_counter;
 
+    for (uint32_t r = 0; r < 32; r++)
+    {
+        regs.set(r, s.regs[r]);
+        fregs.set(r, s.fregs[r]);
+    }
+    fcsr = s.fcsr;
+
+    set_vlen(s.vlen);
+    vl = s.vl;
+    vtype = s.vtype;
+    memcpy(vregs.get(0), s.vregs, 32 * vregs.get_vlenb());
+
+    cycle_base = s.cycle_base;
+    instret_base = s.instret_base;
+    mcountinhibit = s.mcountinhibit;
+
+    mstatus = s.mstatus;
+    mie = s.mie;
+    mip = s.mip;
+    mtvec = s.mtvec;
+    mscratch = s.mscratch;
+    mepc = s.mepc;
+    mcause = s.mcause;
+    mtval = s.mtval;
+
+    priv = s.priv;
+    satp = s.satp;
+    mcounteren = s.mcounteren;
+    scounteren = s.scounteren;
+    flush_tlb();
+    update_pending();
+
+    halt_reason.assign(s.halt_reason, strnlen(s.halt_reason, sizeof(s.halt_reason)));
+}
 
-        //I-TYPE INSTRUCTIONS
-        case opcode_jalr:  exec_jalr(insn, pos);  return;
+/**
+ * @brief Method that returns the rounding mode an F or D instruction
+ * uses. The dynamic rounding mode selects the one in fcsr.frm.
+ * 
+ * @param insn RV32F/D instruction with a rounding mode field.
+ * @return uint32_t rounding mode rm_rne to rm_rmm, or an invalid one.
+ */
+uint32_t rv32i_hart::fp_rm(uint32_t insn) const
+{
+    uint32_t rm = get_funct3(insn);
+    return (rm == rm_dyn) ? (fcsr >> 5) & 0x7 : rm;
+}
 
-        //B-TYPE INSTRUCTIONS
-        case opcode_btype:
-            switch (funct3)
-            {
-                default:  exec_illegal_insn(insn, pos);
-                case funct3_beq:  exec_beq(insn, pos); return;
-                case funct3_bne:  exec_bne(insn, pos); return;
-                case funct3_blt:  exec_blt(insn, pos); return;
-                case funct3_bge:  exec_bge(insn, pos);  return;
-                case funct3_bltu:  exec_bltu(insn, pos); return;
-                case funct3_bgeu:  exec_bgeu(insn, pos); return;                    
-            }
+/**
+ * @brief Method that prepares the host FPU to run an F or D instruction.
+ * It clears the host exception flags and sets the host rounding mode.
+ * Round to nearest even is the host default, so the common case does
+ * not touch the rounding mode at all. The host has no round to nearest
+ * max magnitude mode, so rmm arithmetic rounds to nearest even.
+ * 
+ * @param insn RV32F/D instruction with a rounding mode field.
+ * @return true if the rounding mode is valid.
+ */
+bool rv32i_hart::fp_begin(uint32_t insn)
+{
+    //clear the flags so fp_end() sees only the ones this instruction raises
+    feclearexcept(FE_ALL_EXCEPT);
 
-            assert(0 && "unrecognized funct3"); // impossible
+    switch (fp_rm(insn))
+    {
+        default:  return false;
+        case rm_rne:
+        case rm_rmm:  return true;
+        case rm_rtz:  fesetround(FE_TOWARDZERO); break;
+        case rm_rdn:  fesetround(FE_DOWNWARD); break;
+        case rm_rup:  fesetround(FE_UPWARD); break;
+    }
+    fp_round = true;
+    return true;
+}
 
+/**
+ * @brief Method that accumulates the host exception flags raised since
+ * fp_begin() into fcsr.fflags and puts back the default rounding mode.
+ * 
+ */
+void rv32i_hart::fp_end()
+{
+    int flags = fetestexcept(FE_ALL_EXCEPT);
 
-        //I-TYPE INSTRUCTIONS
-        case opcode_load_imm:
-            switch (funct3)
-            {
-                default:  exec_illegal_insn(insn, pos); return;
-                case funct3_lb:  exec_lb(insn, pos); return;
-                case funct3_lh:  exec_lh(insn, pos); return;
-                case funct3_lw:  exec_lw(insn, pos); return;
-                case funct3_lbu:  exec_lbu(insn, pos); return; 
-                case funct3_lhu:  exec_lhu(insn, pos); return;
-            }
-            assert(0 && "unrecognized funct3"); // impossible   
+    if (flags)
+    {
+        fcsr |= ((flags & FE_INVALID) ? fflags_nv : 0)
+            | ((flags & FE_DIVBYZERO) ? fflags_dz : 0)
+            | ((flags & FE_OVERFLOW) ? fflags_of : 0)
+            | ((flags & FE_UNDERFLOW) ? fflags_uf : 0)
+            | ((flags & FE_INEXACT) ? fflags_nx : 0);
+    }
 
+    if (fp_round)
+    {
+        fesetround(FE_TONEAREST);
+        fp_round = false;
+    }
+}
 
-        //S-TYPE INSTRUCTIONS
-        case opcode_stype:
-            switch (funct3)
-            {
-                default:  exec_illegal_insn(insn, pos); return;
-                case funct3_sb:  exec_sb(insn, pos); return;
-                case funct3_sh:  exec_sh(insn, pos); return;
-                case funct3_sw:  exec_sw(insn, pos); return;
-            }
-            assert(0 && "unrecognized funct3"); // impossible   
+/**
+ * @brief Method that builds the fclass result mask.
+ * 
+ * @param cls value returned by std::fpclassify().
+ * @param neg true if the sign bit is set.
+ * @param snan true if the value is a signaling NaN.
+ * @return uint32_t mask with the single bit for the class set.
+ */
+uint32_t rv32i_hart::fp_classify(int cls, bool neg, bool snan)
+{
+    switch (cls)
+    {
+        case FP_INFINITE:  return neg ? 0x001 : 0x080;
+        case FP_NORMAL:  return neg ? 0x002 : 0x040;
+        case FP_SUBNORMAL:  return neg ? 0x004 : 0x020;
+        case FP_ZERO:  return neg ? 0x008 : 0x010;
+    }
+    return snan ? 0x100 : 0x200;
+}
 
-        
-        //I-TYPE INSTRUCTIONS
-        case opcode_alu_imm:
-            switch (funct3)
-            {
-                default:  exec_illegal_insn(insn, pos); return;
-                case funct3_add:  exec_addi(insn, pos); return;
-                case funct3_sll:  exec_slli(insn, pos); return;
-                case funct3_slt:  exec_slti(insn, pos); return;
-                case funct3_sltu:  exec_sltiu(insn, pos); return;
-                case funct3_xor:  exec_xori(insn, pos); return;
-                case funct3_or:  exec_ori(insn, pos); return;
-                case funct3_and:  exec_andi(insn, pos); return;
+/**
+ * @brief Method that raises an exception or takes an interrupt. The
+ * trapped pc goes to mepc and execution continues at mtvec with interrupts
+ * disabled. Interrupts go to mtvec + 4 * cause in vectored mode. A guest
+ * that has not set mtvec has no handler, so the trap halts the simulation
+ * the way every fault did before there was a trap model.
+ * 
+ * @param cause mcause value, with bit 31 set for interrupts.
+ * @param tval mtval value, the faulting address or instruction.
+ * @param reason halt reason if there is no handler.
+ */
+void rv32i_hart::trap(uint32_t cause, uint32_t tval, const char *reason)
+{
+    if (mtvec == 0)
+    {
+        halt = true;
+        halt_reason = reason;
+        return;
+    }
 
-                case funct3_srx:
-                    switch(funct7)
-                    {
-                        default:  exec_illegal_insn(insn, pos); return;
-                        case funct7_srl:  exec_srli(insn, pos); return;
-                        case funct7_sra:  exec_srai(insn, pos); return;
-                    }
-                    assert(0 && "unrecognized funct7"); // impossible
-            }
-            assert(0 && "unrecognized funct3"); // impossible
+    mepc = pc;
+    mcause = cause;
+    mtval = tval;
 
-        
-        //R-TYPE INSTRUCTIONS
-        case opcode_rtype:
-            switch (funct3)
-            {
-                default:  exec_illegal_insn(insn, pos); return;
-                case funct3_add: 
-                        switch(funct7)
-                        {
-                            default:  exec_illegal_insn(insn, pos); return;
-                            case funct7_add:  exec_add(insn, pos); return;
-                            case funct7_sub:  exec_sub(insn, pos); return;
-                        }
-                        assert(0 && "unrecognized funct7"); // impossible
+    //MPIE = MIE, MIE = 0, MPP = the mode the trap came from
+    mstatus = (mstatus & ~mstatus_mpie) | ((mstatus & mstatus_mie) ? mstatus_mpie : 0);
+    mstatus &= ~mstatus_mie;
+    mstatus = (mstatus & ~mstatus_mpp) | priv << mstatus_mpp_shift;
 
+    //every trap is taken in M-mode, nothing is delegated
+    priv = priv_m;
+    update_vm();
+    update_pending();
 
-                case funct3_sll:  exec_sll(insn, pos); return;
-                case funct3_slt:  exec_slt(insn, pos); return;
-                case funct3_sltu:  exec_sltu(insn, pos); return;
-                case funct3_xor:  exec_xor(insn, pos); return;
-                case funct3_or:  exec_or(insn, pos);  return;
-                case funct3_and:  exec_and(insn, pos); return;
+    uint32_t base = mtvec & ~0x3u;
+    bool vectored = (mtvec & 0x1) && (cause & cause_interrupt);
+    pc = vectored ? base + 4 * (cause & ~cause_interrupt) : base;
+}
 
-                case funct3_srx:
-                    switch(funct7)
-                    {
-                        default:  exec_illegal_insn(insn, pos); return;
-                        case funct7_sra:  exec_sra(insn, pos); return;
-                        case funct7_srl:  exec_srl(insn, pos); return;
-                    }
-                    assert(0 && "unrecognized funct7"); // impossible
-            }
-            assert(0 && "unrecognized funct3"); // impossible
+/**
+ * @brief Method that takes the highest priority pending interrupt,
+ * external first, then software, then timer.
+ * 
+ */
+void rv32i_hart::take_interrupt()
+{
+    uint32_t code;
+    if (pending & mip_meip)
+        code = 11;
+    else if (pending & mip_msip)
+        code = 3;
+    else
+        code = 7;
 
+    trap(cause_interrupt | code, 0, "Interrupt");
+}
 
-        case opcode_system:
-            //EBBREAK
-            switch(insn)
-            {
-                case insn_ebreak:  exec_ebreak(insn, pos); return;
-            }
+/**
+ * @brief Method that recomputes the pending word tick() checks. It is
+ * non-zero only if an enabled interrupt is pending and mstatus.MIE is set
+ * or the hart is below M-mode, so the common case costs one branch.
+ * 
+ */
+void rv32i_hart::update_pending()
+{
+    //M-mode interrupts are always enabled in the lower modes
+    pending = (priv != priv_m || (mstatus & mstatus_mie)) ? (mip & mie) : 0;
+}
 
-            switch(funct3)
-            {
-                default:  exec_illegal_insn(insn, pos); return;
-                case funct3_csrrs:  exec_csrrs(insn, pos); return;
-            }
-            assert(0 && "unrecognized funct3"); // impossible      
-    }
-    assert(0 && "unrecognized opcode"); // It should be impossible to ever get here!
+/**
+ * @brief Method that devices use to raise or lower their interrupt line,
+ * one of the mip_msip, mip_mtip and mip_meip bits.
+ * 
+ * @param bit mip bit of the interrupt.
+ * @param level true while the interrupt is requested.
+ */
+void rv32i_hart::set_mip(uint32_t bit, bool level)
+{
+    mip = level ? (mip | bit) : (mip & ~bit);
+    update_pending();
 }
 
 /**
- * @brief Method to halt execution when encountering an illegal
- * instruction.
+ * @brief Method that works out which accesses are translated and the TLB
+ * keys for them. It is called whenever satp, mstatus or the privilege
+ * mode changes. A key holds the TLB epoch, the effective privilege and
+ * the SUM and MXR bits above the virtual page number, so an entry filled
+ * in one mode is never hit in another and a mode change needs no flush.
  * 
- * @param insn RV32I instruction to be executed.
- * @param pos flag that determines when to render error message.
  */
-void rv32i_hart::exec_illegal_insn(uint32_t insn, std::ostream* pos)
+void rv32i_hart::update_vm()
 {
-    (void)insn;
+    //MPRV makes loads and stores act as if the hart were in the MPP mode
+    data_priv = (mstatus & mstatus_mprv) ? (mstatus & mstatus_mpp) >> mstatus_mpp_shift : priv;
 
-    //render proper error message by writing it to the ostream
-    if(pos)
-    {
-        *pos << render_illegal_insn(insn);
-    }
+    //M-mode accesses are never translated
+    bool sv32 = satp & satp_mode;
+    vm_fetch = sv32 && priv != priv_m;
+    vm_data = sv32 && data_priv != priv_m;
 
-    //set flag to true to halt execution
-    halt = true;
+    uint64_t bits = ((mstatus & mstatus_sum) ? 0x4 : 0) | ((mstatus & mstatus_mxr) ? 0x8 : 0);
+    fetch_key = tlb_epoch << 32 | (uint64_t)priv << 20;
+    data_key = tlb_epoch << 32 | (bits | data_priv) << 20;
 
-    //set string to explain why execution halted
-    halt_reason = "Illegal instruction";
+    //the cached fetch page may have been translated in the old context
+    fetch_page = 1;
 }
 
 /**
- * @brief Method to execute the lui instruction.
+ * @brief Method that empties the TLBs by moving to a new epoch, which no
+ * existing entry can match. The entries are only cleared when the epoch
+ * runs out of bits.
  * 
- * @param insn RV32I instruction to be executed.
- * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_lui(uint32_t insn, std::ostream* pos)
+void rv32i_hart::flush_tlb()
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
-
-    //get immediate value for u-type instruction
-    int32_t imm_u = get_imm_u(insn);
-
-    //render the simulation summary comment that shows the values of all the registers
-    //involved before and after the instruction simulation (rd ← imm u, pc ← pc+4)
-    if(pos)
+    if (++tlb_epoch == (uint64_t)1 << 32)
     {
-        std::string s = render_lui(insn);
-        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
-
-        //                          rd       =          immu
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(imm_u);
+        for (uint32_t i = 0; i < tlb_size; i++)
+        {
+            itlb[i].key = rtlb[i].key = wtlb[i].key = 0;
+        }
+        tlb_epoch = 1;
     }
-
-    //set rd register to immediate value of instruction (rd <- imm_u)
-    regs.set(rd, imm_u);
-
-    //increment the pc register (pc <- pc + 4)
-    pc += 4;
+    update_vm();
 }
 
 /**
- * @brief Method to execute the auipc instruction.
+ * @brief Method that walks the Sv32 page table for a TLB miss and fills
+ * the entry. The accessed bit, and the dirty bit for a store, are set in
+ * the PTE on the way. A walk that fails traps with nothing else changed.
  * 
- * @param insn RV32I instruction to be executed.
- * @param pos ostream used to print comment column.
+ * @param e TLB entry to fill.
+ * @param key TLB key of the context, without the page number.
+ * @param addr virtual address being accessed.
+ * @param access access_fetch, access_load or access_store.
+ * @return true if the entry was filled, false if the hart trapped.
  */
-void rv32i_hart::exec_auipc(uint32_t insn, std::ostream* pos)
+bool rv32i_hart::tlb_fill(tlb_entry &e, uint64_t key, uint32_t addr, uint32_t access)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
+    static const uint32_t page_fault[] = { cause_insn_page_fault, cause_load_page_fault, cause_store_page_fault };
+    static const uint32_t access_fault[] = { cause_insn_access_fault, cause_load_fault, cause_store_fault };
+    uint32_t mode = (access == access_fetch) ? priv : data_priv;
+
+    //walk down from the root table in satp until a leaf
+    uint64_t table = (uint64_t)(satp & satp_ppn) << 12;
+    uint32_t pte = 0;
+    uint32_t pte_addr = 0;
+    int level;
+    for (level = 1; level >= 0; level--)
+    {
+        uint64_t a = table + ((addr >> (12 + 10 * level)) & 0x3ff) * 4;
+        if (a >> 32)
+        {
+            trap(access_fault[access], addr, "Page table access fault");
+            return false;
+        }
+
+        pte_addr = a;
+        pte = mem.get32(pte_addr);
+
+        //invalid, or writable without being readable
+        if (!(pte & pte_v) || ((pte & pte_w) && !(pte & pte_r)))
+        {
+            level = -1;
+            break;
+        }
+
+        if (pte & (pte_r | pte_x))
+        {
+            break;
+        }
+        table = (uint64_t)(pte >> 10) << 12;
+    }
 
-    //get immediate value for u-type instruction
-    int32_t imm_u = get_imm_u(insn);
+    //no leaf, or a superpage that is not aligned
+    bool ok = level >= 0 && !(level == 1 && ((pte >> 10) & 0x3ff));
 
-    //calculate value for this instruction's pc register
-    int32_t sum = pc + imm_u;
+    //the permission the access needs, MXR lets loads read executable pages
+    if (access == access_fetch)
+        ok = ok && (pte & pte_x);
+    else if (access == access_load)
+        ok = ok && ((pte & pte_r) || ((mstatus & mstatus_mxr) && (pte & pte_x)));
+    else
+        ok = ok && (pte & pte_w);
 
-    //render the simulation summary comment that shows the values of all the registers
-    //involved before and after the instruction simulation (rd ← pc + imm u, pc ← pc+4)
-    if(pos)
+    //U pages are for U-mode, and for S-mode loads and stores with SUM
+    if (pte & pte_u)
+        ok = ok && (mode == priv_u || (access != access_fetch && (mstatus & mstatus_sum)));
+    else
+        ok = ok && mode != priv_u;
+
+    if (!ok)
     {
-        std::string s = render_auipc(insn);
-        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+        trap(page_fault[access], addr, "Page fault");
+        return false;
+    }
 
-        //                      rd           =              pc          +               imm_u         =         val
+    uint64_t page = (uint64_t)(pte >> 10) << 12;
+    if (level == 1)
+    {
+        page |= addr & 0x003ff000;
+    }
+
+    //Sv32 reaches 34 bit physical addresses, memory only 32
+    if (page >> 32)
+    {
+        trap(access_fault[access], addr, "Access fault");
+        return false;
+    }
+
+    //the physical page has its own permissions, checked once here for
+    //every access that will hit this entry
+    if (!check_perm(page, memory::page_size, access, addr))
+    {
+        return false;
+    }
+
+    uint32_t ad = pte_a | ((access == access_store) ? pte_d : 0);
+    if ((pte & ad) != ad)
+    {
+        mem.set32(pte_addr, pte | ad);
+    }
+
+    //RAM pages are accessed through a host pointer, anything else goes
+    //through memory so the devices still see it
+    e.key = key | addr >> 12;
+    e.page = page;
+    e.host = nullptr;
+    if (page + memory::page_size <= mem.get_size())
+    {
+        //a load entry is only ever read through, and a store entry marks
+        //the page dirty now and on every store
+        e.host = (access == access_store) ? mem.get_write_ptr(page, memory::page_size) : const_cast<uint8_t*>(mem.get_read_ptr(page, memory::page_size));
+    }
+    return true;
+}
+
+/**
+ * @brief Method that looks a virtual address up in a TLB and walks the
+ * page table on a miss. The TLBs are direct-mapped on the low bits of the
+ * virtual page number.
+ * 
+ * @param tlb itlb, rtlb or wtlb.
+ * @param key TLB key of the context, without the page number.
+ * @param addr virtual address being accessed.
+ * @param access access_fetch, access_load or access_store.
+ * @return tlb_entry* the entry for the page, nullptr if the hart trapped.
+ */
+rv32i_hart::tlb_entry *rv32i_hart::translate(tlb_entry *tlb, uint64_t key, uint32_t addr, uint32_t access)
+{
+    tlb_entry &e = tlb[(addr >> 12) % tlb_size];
+    return (e.key == (key | addr >> 12) || tlb_fill(e, key, addr, access)) ? &e : nullptr;
+}
+
+/**
+ * @brief Method that does a translated access of 1, 2 or 4 bytes in
+ * little endian order.
+ * 
+ * @param tlb itlb, rtlb or wtlb.
+ * @param key TLB key of the context, without the page number.
+ * @param addr virtual address of the first byte.
+ * @param len number of bytes.
+ * @param val value loaded, or the value to store.
+ * @param access access_fetch, access_load or access_store.
+ * @return true if the access was done, false if the hart trapped.
+ */
+bool rv32i_hart::vm_access(tlb_entry *tlb, uint64_t key, uint32_t addr, uint32_t len, uint32_t &val, uint32_t access)
+{
+    uint32_t offset = addr & (memory::page_size - 1);
+
+    //an access that runs into the next page translates both pages before
+    //any byte moves, so a fault on the second one is still precise
+    if (offset + len > memory::page_size)
+    {
+        if (!translate(tlb, key, addr, access) || !translate(tlb, key, addr + len - 1, access))
+        {
+            return false;
+        }
+
+        uint32_t v = 0;
+        for (uint32_t i = 0; i < len; i++)
+        {
+            uint32_t b = (val >> (8 * i)) & 0xff;
+            vm_access(tlb, key, addr + i, 1, b, access);
+            v |= b << (8 * i);
+        }
+        val = v;
+        return true;
+    }
+
+    tlb_entry *e = translate(tlb, key, addr, access);
+    if (!e)
+    {
+        return false;
+    }
+
+    //pages outside of the RAM
+    if (!e->host)
+    {
+        uint32_t paddr = e->page | offset;
+        if (access == access_store)
+        {
+            if (len == 1)
+                mem.set8(paddr, val);
+            else if (len == 2)
+                mem.set16(paddr, val);
+            else
+                mem.set32(paddr, val);
+        }
+        else
+        {
+            val = (len == 1) ? mem.get8(paddr) : (len == 2) ? mem.get16(paddr) : mem.get32(paddr);
+        }
+        return true;
+    }
+
+    uint8_t *p = e->host + offset;
+    if (access == access_store)
+    {
+        for (uint32_t i = 0; i < len; i++)
+        {
+            p[i] = val >> (8 * i);
+        }
+        mem.mark_dirty(e->page);
+    }
+    else
+    {
+        uint32_t v = 0;
+        for (uint32_t i = 0; i < len; i++)
+        {
+            v |= p[i] << (8 * i);
+        }
+        val = v;
+    }
+    return true;
+}
+
+/**
+ * @brief Method that lets untranslated loads and stores use the guard
+ * page RAM in place with no range or permission checks. It only takes
+ * effect when the memory has guard pages, every RAM page is read/write
+ * and nothing is being printed, since a faulting instruction is run
+ * twice.
+ * 
+ * @param on true while a landing point for the faults is armed.
+ */
+void rv32i_hart::set_unchecked(bool on)
+{
+    direct = (on && !show_instructions && !show_registers && mem.all_rw()) ? mem.get_guard_base() : nullptr;
+}
+
+/**
+ * @brief Method to run an instruction again with the checks on after its
+ * unchecked access faulted on the host. The fault comes before the
+ * instruction changes anything but the instruction counter, so that is
+ * wound back first.
+ * 
+ */
+void rv32i_hart::retry_checked()
+{
+    uint8_t *d = direct;
+    direct = nullptr;
+    insn_counter--;
+    tick();
+    direct = d;
+}
+
+/**
+ * @brief Method that checks the memory permissions of a physical range and
+ * traps with an access fault when they do not allow the access. A program
+ * without a trap handler halts with the reason.
+ * 
+ * @param paddr physical address of the first byte.
+ * @param len number of bytes.
+ * @param access access_fetch, access_load or access_store.
+ * @param tval address reported in mtval.
+ * @return true if the access is allowed, false if the hart trapped.
+ */
+bool rv32i_hart::check_perm(uint32_t paddr, uint32_t len, uint32_t access, uint32_t tval)
+{
+    static const uint8_t perm[] = { memory::perm_x, memory::perm_r, memory::perm_w };
+    static const uint32_t cause[] = { cause_insn_access_fault, cause_load_fault, cause_store_fault };
+    static const char *const reason[] = { "Fetch from a non-executable page", "Load from an unreadable page", "Store to a read-only page" };
+
+    if (mem.check_perm(paddr, len, perm[access]))
+    {
+        return true;
+    }
+
+    trap(cause[access], tval, reason[access]);
+    return false;
+}
+
+/**
+ * @brief Method that fetches 16 bits of an instruction, translated when
+ * the hart is below M-mode and satp selects Sv32.
+ * 
+ * @param addr address of the parcel.
+ * @param val parcel fetched.
+ * @return true if the fetch was done, false if the hart trapped.
+ */
+bool rv32i_hart::fetch_mem(uint32_t addr, uint32_t &val)
+{
+    if (vm_fetch)
+    {
+        return vm_access(itlb, fetch_key, addr, 2, val, access_fetch);
+    }
+
+    if (!check_perm(addr, 2, access_fetch, addr))
+    {
+        return false;
+    }
+
+    val = mem.get16(addr);
+    return true;
+}
+
+/**
+ * @brief Method that fetches the instruction at the pc with every check,
+ * for when the pc is outside of the cached fetch page or the instruction
+ * runs into the next page. An executable RAM page that the fetch passes
+ * becomes the cached one, so the following fetches from it need no checks
+ * until the pc leaves it.
+ * 
+ * @param insn instruction fetched, a compressed one in the low 16 bits.
+ * @return true if the fetch was done, false if the hart trapped.
+ */
+bool rv32i_hart::fetch_insn(uint32_t &insn)
+{
+    if (!fetch_mem(pc, insn))
+    {
+        return false;
+    }
+
+    if (rv32c::is_32bit(insn))
+    {
+        uint32_t high;
+        if (!fetch_mem(pc + 2, high))
+        {
+            return false;
+        }
+        insn |= high << 16;
+    }
+
+    //cache the page of the pc, the TLB entry already holds its host
+    //pointer when the fetch was translated
+    uint32_t page = pc & ~(memory::page_size - 1);
+    if (vm_fetch)
+    {
+        const tlb_entry &e = itlb[(pc >> 12) % tlb_size];
+        if (e.key == (fetch_key | pc >> 12) && e.host)
+        {
+            fetch_host = e.host;
+            fetch_page = page;
+        }
+    }
+    else if (page + memory::page_size <= mem.get_size() && mem.check_perm(page, memory::page_size, memory::perm_x))
+    {
+        fetch_host = mem.get_read_ptr(page, memory::page_size);
+        fetch_page = page;
+    }
+    return true;
+}
+
+/**
+ * @brief Method that does the memory read of a load instruction,
+ * translated when needed.
+ * 
+ * @param addr address of the first byte.
+ * @param len number of bytes, 1, 2 or 4.
+ * @param val value loaded, zero extended.
+ * @return true if the load was done, false if the hart trapped.
+ */
+bool rv32i_hart::read_mem(uint32_t addr, uint32_t len, uint32_t &val)
+{
+    if (vm_data)
+    {
+        return vm_access(rtlb, data_key, addr, len, val, access_load);
+    }
+
+    //the guard page RAM is read in place, an address above it faults on
+    //the host and the instruction is retried through the checks below
+    if (direct)
+    {
+        const uint8_t *p = direct + addr;
+        val = (len == 1) ? p[0] : (len == 2) ? (p[0] | p[1] << 8) : (p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24);
+        return true;
+    }
+
+    if (!check_perm(addr, len, access_load, addr))
+    {
+        return false;
+    }
+
+    val = (len == 1) ? mem.get8(addr) : (len == 2) ? mem.get16(addr) : mem.get32(addr);
+    return true;
+}
+
+/**
+ * @brief Method that does the memory write of a store instruction,
+ * translated when needed.
+ * 
+ * @param addr address of the first byte.
+ * @param len number of bytes, 1, 2 or 4.
+ * @param val value to store in the low len bytes.
+ * @return true if the store was done, false if the hart trapped.
+ */
+bool rv32i_hart::write_mem(uint32_t addr, uint32_t len, uint32_t val)
+{
+    if (vm_data)
+    {
+        return vm_access(wtlb, data_key, addr, len, val, access_store);
+    }
+
+    if (direct)
+    {
+        uint8_t *p = direct + addr;
+        for (uint32_t i = 0; i < len; i++)
+        {
+            p[i] = val >> (8 * i);
+        }
+        mem.mark_dirty(addr);
+        mem.mark_dirty(addr + len - 1);
+        return true;
+    }
+
+    if (!check_perm(addr, len, access_store, addr))
+    {
+        return false;
+    }
+
+    if (len == 1)
+        mem.set8(addr, val);
+    else if (len == 2)
+        mem.set16(addr, val);
+    else
+        mem.set32(addr, val);
+    return true;
+}
+
+/**
+ * @brief Method that changes the width of the vector registers. The
+ * vector registers are reset and vtype is left invalid until the next
+ * vsetvli.
+ * 
+ * @param vlen width of each vector register in bits, see
+ * vregisterfile::is_valid_vlen().
+ */
+void rv32i_hart::set_vlen(uint32_t vlen)
+{
+    vregs.set_vlen(vlen);
+    vmask.resize(vlen / 8);
+    vcmp.resize(vlen);
+    vl = 0;
+    vtype = vtype_vill;
+}
+
+/**
+ * @brief Method that returns VLMAX, the number of elements of a register
+ * group, for a vtype.
+ * 
+ * @param vt vtype value.
+ * @return uint32_t VLMAX, or 0 if the vtype is not supported.
+ */
+uint32_t rv32i_hart::get_vlmax(uint32_t vt) const
+{
+    uint32_t sew = 8 << ((vt >> 3) & 0x7);
+    uint32_t vlmul = vt & 0x7;
+
+    //reserved bits, vill, element widths above 64 and the reserved LMUL
+    if ((vt & ~0xffu) || sew > 64 || vlmul == 4)
+    {
+        return 0;
+    }
+
+    if (vlmul < 4)
+    {
+        return (vregs.get_vlen() << vlmul) / sew;
+    }
+
+    //a fractional LMUL must still leave room for a 64-bit element's share
+    if (sew > (64u >> (8 - vlmul)))
+    {
+        return 0;
+    }
+    return (vregs.get_vlen() >> (8 - vlmul)) / sew;
+}
+
+/**
+ * @brief Method that returns how many registers a group of eew-bit
+ * elements spans under the current vtype, EMUL = EEW / SEW * LMUL.
+ * 
+ * @param eew element width in bits.
+ * @return uint32_t 1, 2, 4 or 8 registers, or 0 if EMUL is out of range.
+ */
+uint32_t rv32i_hart::get_vgroup(uint32_t eew) const
+{
+    uint32_t sew = 8 << ((vtype >> 3) & 0x7);
+    uint32_t vlmul = vtype & 0x7;
+
+    //LMUL and EMUL in eighths of a register
+    uint32_t lmul8 = (vlmul < 4) ? 8 << vlmul : 8 >> (8 - vlmul);
+    uint32_t emul8 = lmul8 * eew / sew;
+
+    if (emul8 == 0 || emul8 > 64)
+    {
+        return 0;
+    }
+    return (emul8 < 8) ? 1 : emul8 / 8;
+}
+
+/**
+ * @brief Method that expands the v0 mask into one all-ones or all-zeros
+ * element per body element, so masked kernels can blend without branches.
+ * 
+ * @param size element size in bytes.
+ * @return const uint8_t* the expanded mask, vl elements of size bytes.
+ */
+const uint8_t *rv32i_hart::get_vmask(uint32_t size)
+{
+    uint8_t *m = reinterpret_cast<uint8_t*>(vmask.data());
+
+    for (uint32_t i = 0; i < vl; i++)
+    {
+        memset(m + i * size, vregs.get_mask(0, i) ? 0xff : 0x00, size);
+    }
+    return m;
+}
+
+/**
+ * @brief Method that copies bytes between memory and a vector register
+ * with a single block copy. A range that is not entirely inside memory
+ * falls back to byte accesses, which warn like the scalar loads and stores.
+ * Under Sv32 the bytes are translated one at a time.
+ * 
+ * @param addr guest address of the first byte.
+ * @param v first byte in the vector register file.
+ * @param len number of bytes.
+ * @param store true to copy from the register to memory.
+ * @return true if the copy was done, false if the hart took a page or
+ * access fault.
+ */
+bool rv32i_hart::vec_transfer(uint32_t addr, uint8_t *v, uint32_t len, bool store)
+{
+    //translated accesses go a byte at a time through the TLB
+    if (vm_data)
+    {
+        for (uint32_t b = 0; b < len; b++)
+        {
+            uint32_t byte = v[b];
+            if (store ? !write_mem(addr + b, 1, byte) : !read_mem(addr + b, 1, byte))
+            {
+                return false;
+            }
+            v[b] = byte;
+        }
+        return true;
+    }
+
+    if (!check_perm(addr, len, store ? access_store : access_load, addr))
+    {
+        return false;
+    }
+
+    if (store ? mem.write_block(addr, v, len) : mem.read_block(addr, v, len))
+    {
+        return true;
+    }
+
+    for (uint32_t b = 0; b < len; b++)
+    {
+        if (store)
+            mem.set8(addr + b, v[b]);
+        else
+            v[b] = mem.get8(addr + b);
+    }
+    return true;
+}
+
+/**
+ * @brief Method that runs an element-wise operation over a register group.
+ * Unmasked instructions are plain loops over the elements and masked ones
+ * blend the results in through the expanded mask, so both vectorize on the
+ * host.
+ * 
+ * @param insn RVV instruction being executed.
+ * @param scalar x[rs1] or the immediate for the .vx and .vi forms.
+ * @param op operation applied to each element of vs2 and the other operand.
+ */
+template<typename T, typename OP>
+void rv32i_hart::vec_arith_kernel(uint32_t insn, T scalar, OP op)
+{
+    typedef typename vregisterfile::alias<T>::type VT;
+
+    //vd may be vs1 or vs2, so only the mask scratch is known not to alias
+    VT *d = reinterpret_cast<VT*>(vregs.get(get_rd(insn)));
+    const VT *a = reinterpret_cast<const VT*>(vregs.get(get_rs2(insn)));
+    const VT *b = reinterpret_cast<const VT*>(vregs.get(get_rs1(insn)));
+    bool vv = get_funct3(insn) == funct3_opivv || get_funct3(insn) == funct3_opmvv;
+    uint32_t n = vl;
+
+    if (get_vm(insn))
+    {
+        if (vv)
+        {
+            for (uint32_t i = 0; i < n; i++)
+                d[i] = op(a[i], b[i]);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < n; i++)
+                d[i] = op(a[i], scalar);
+        }
+        return;
+    }
+
+    const VT *__restrict__ m = reinterpret_cast<const VT*>(get_vmask(sizeof(T)));
+    for (uint32_t i = 0; i < n; i++)
+    {
+        T val = vv ? op(a[i], b[i]) : op(a[i], scalar);
+        d[i] = (val & m[i]) | (d[i] & ~m[i]);
+    }
+}
+
+/**
+ * @brief Method that runs vec_arith_kernel() for the current SEW.
+ * 
+ * @param insn RVV instruction being executed.
+ * @param scalar x[rs1] or the immediate for the .vx and .vi forms.
+ * @param op operation applied to each element.
+ */
+template<typename OP>
+void rv32i_hart::vec_arith(uint32_t insn, int64_t scalar, OP op)
+{
+    switch ((vtype >> 3) & 0x7)
+    {
+        case 0:  vec_arith_kernel<int8_t>(insn, scalar, op); return;
+        case 1:  vec_arith_kernel<int16_t>(insn, scalar, op); return;
+        case 2:  vec_arith_kernel<int32_t>(insn, scalar, op); return;
+        case 3:  vec_arith_kernel<int64_t>(insn, scalar, op); return;
+    }
+}
+
+/**
+ * @brief Method that runs an element-wise comparison over a register group
+ * and writes the results as a mask. The comparisons run as one loop into
+ * a byte per element and are then packed into mask bits.
+ * 
+ * @param insn RVV instruction being executed.
+ * @param scalar x[rs1] or the immediate for the .vx and .vi forms.
+ * @param op comparison applied to each element of vs2 and the other operand.
+ */
+template<typename T, typename OP>
+void rv32i_hart::vec_compare_kernel(uint32_t insn, T scalar, OP op)
+{
+    typedef typename vregisterfile::alias<T>::type VT;
+
+    const VT *__restrict__ a = reinterpret_cast<const VT*>(vregs.get(get_rs2(insn)));
+    const VT *__restrict__ b = reinterpret_cast<const VT*>(vregs.get(get_rs1(insn)));
+    uint8_t *__restrict__ res = vcmp.data();
+    bool vv = get_funct3(insn) == funct3_opivv;
+    uint32_t n = vl;
+
+    if (vv)
+    {
+        for (uint32_t i = 0; i < n; i++)
+            res[i] = op(a[i], b[i]);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < n; i++)
+            res[i] = op(a[i], scalar);
+    }
+
+    //pack the results, masked off bits keep their value
+    uint8_t *d = vregs.get(get_rd(insn));
+    bool masked = !get_vm(insn);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (!masked || vregs.get_mask(0, i))
+        {
+            d[i >> 3] = (d[i >> 3] & ~(1 << (i & 7))) | (res[i] << (i & 7));
+        }
+    }
+}
+
+/**
+ * @brief Method that runs vec_compare_kernel() for the current SEW.
+ * 
+ * @param insn RVV instruction being executed.
+ * @param scalar x[rs1] or the immediate for the .vx and .vi forms.
+ * @param op comparison applied to each element.
+ */
+template<typename OP>
+void rv32i_hart::vec_compare(uint32_t insn, int64_t scalar, OP op)
+{
+    switch ((vtype >> 3) & 0x7)
+    {
+        case 0:  vec_compare_kernel<int8_t>(insn, scalar, op); return;
+        case 1:  vec_compare_kernel<int16_t>(insn, scalar, op); return;
+        case 2:  vec_compare_kernel<int32_t>(insn, scalar, op); return;
+        case 3:  vec_compare_kernel<int64_t>(insn, scalar, op); return;
+    }
+}
+
+/**
+ * @brief Method that runs vmerge or vmv.v over a register group. vmerge
+ * picks vs1/x[rs1]/imm where the mask is set and vs2 elsewhere, and
+ * vmv.v copies vs1/x[rs1]/imm to every element.
+ * 
+ * @param insn RVV instruction being executed.
+ * @param scalar x[rs1] or the immediate for the .vx and .vi forms.
+ */
+template<typename T>
+void rv32i_hart::vec_merge_kernel(uint32_t insn, T scalar)
+{
+    typedef typename vregisterfile::alias<T>::type VT;
+
+    VT *d = reinterpret_cast<VT*>(vregs.get(get_rd(insn)));
+    const VT *a = reinterpret_cast<const VT*>(vregs.get(get_rs2(insn)));
+    const VT *b = reinterpret_cast<const VT*>(vregs.get(get_rs1(insn)));
+    bool vv = get_funct3(insn) == funct3_opivv;
+    uint32_t n = vl;
+
+    if (get_vm(insn))
+    {
+        for (uint32_t i = 0; i < n; i++)
+            d[i] = vv ? b[i] : scalar;
+        return;
+    }
+
+    const VT *__restrict__ m = reinterpret_cast<const VT*>(get_vmask(sizeof(T)));
+    for (uint32_t i = 0; i < n; i++)
+    {
+        T val = vv ? b[i] : scalar;
+        d[i] = (val & m[i]) | (a[i] & ~m[i]);
+    }
+}
+
+/**
+ * @brief Method that runs vec_merge_kernel() for the current SEW.
+ * 
+ * @param insn RVV instruction being executed.
+ * @param scalar x[rs1] or the immediate for the .vx and .vi forms.
+ */
+void rv32i_hart::vec_merge(uint32_t insn, int64_t scalar)
+{
+    switch ((vtype >> 3) & 0x7)
+    {
+        case 0:  vec_merge_kernel<int8_t>(insn, scalar); return;
+        case 1:  vec_merge_kernel<int16_t>(insn, scalar); return;
+        case 2:  vec_merge_kernel<int32_t>(insn, scalar); return;
+        case 3:  vec_merge_kernel<int64_t>(insn, scalar); return;
+    }
+}
+
+/**
+ * @brief Method that runs vmacc over a register group,
+ * vd[i] = vs1[i] * vs2[i] + vd[i] (or x[rs1] * vs2[i] + vd[i]).
+ * 
+ * @param insn RVV instruction being executed.
+ * @param scalar x[rs1] for the .vx form.
+ */
+template<typename T>
+void rv32i_hart::vec_macc_kernel(uint32_t insn, T scalar)
+{
+    typedef typename vregisterfile::alias<T>::type VT;
+    typedef typename std::make_unsigned<T>::type U;
+
+    VT *d = reinterpret_cast<VT*>(vregs.get(get_rd(insn)));
+    const VT *a = reinterpret_cast<const VT*>(vregs.get(get_rs2(insn)));
+    const VT *b = reinterpret_cast<const VT*>(vregs.get(get_rs1(insn)));
+    bool vv = get_funct3(insn) == funct3_opmvv;
+    uint32_t n = vl;
+
+    //unsigned arithmetic wraps the way the instruction does
+    if (get_vm(insn))
+    {
+        for (uint32_t i = 0; i < n; i++)
+            d[i] = (U)(vv ? b[i] : scalar) * (U)a[i] + (U)d[i];
+        return;
+    }
+
+    const VT *__restrict__ m = reinterpret_cast<const VT*>(get_vmask(sizeof(T)));
+    for (uint32_t i = 0; i < n; i++)
+    {
+        T val = (U)(vv ? b[i] : scalar) * (U)a[i] + (U)d[i];
+        d[i] = (val & m[i]) | (d[i] & ~m[i]);
+    }
+}
+
+/**
+ * @brief Method that runs vec_macc_kernel() for the current SEW.
+ * 
+ * @param insn RVV instruction being executed.
+ * @param scalar x[rs1] for the .vx form.
+ */
+void rv32i_hart::vec_macc(uint32_t insn, int64_t scalar)
+{
+    switch ((vtype >> 3) & 0x7)
+    {
+        case 0:  vec_macc_kernel<int8_t>(insn, scalar); return;
+        case 1:  vec_macc_kernel<int16_t>(insn, scalar); return;
+        case 2:  vec_macc_kernel<int32_t>(insn, scalar); return;
+        case 3:  vec_macc_kernel<int64_t>(insn, scalar); return;
+    }
+}
+
+/**
+ * @brief Method that runs a reduction, vd[0] = vs1[0] op vs2[0] op ...
+ * op vs2[vl-1] over the active elements of vs2.
+ * 
+ * @param insn RVV instruction being executed.
+ * @param op operation that combines the accumulator with an element.
+ */
+template<typename T, typename OP>
+void rv32i_hart::vec_reduce_kernel(uint32_t insn, OP op)
+{
+    typedef typename vregisterfile::alias<T>::type VT;
+
+    VT *d = reinterpret_cast<VT*>(vregs.get(get_rd(insn)));
+    const VT *__restrict__ a = reinterpret_cast<const VT*>(vregs.get(get_rs2(insn)));
+    const VT *__restrict__ b = reinterpret_cast<const VT*>(vregs.get(get_rs1(insn)));
+    uint32_t n = vl;
+    T acc = b[0];
+
+    if (get_vm(insn))
+    {
+        for (uint32_t i = 0; i < n; i++)
+            acc = op(acc, a[i]);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < n; i++)
+        {
+            if (vregs.get_mask(0, i))
+                acc = op(acc, a[i]);
+        }
+    }
+
+    //vd is left alone when vl is 0
+    if (n > 0)
+    {
+        d[0] = acc;
+    }
+}
+
+/**
+ * @brief Method that runs vec_reduce_kernel() for the current SEW.
+ * 
+ * @param insn RVV instruction being executed.
+ * @param op operation that combines the accumulator with an element.
+ */
+template<typename OP>
+void rv32i_hart::vec_reduce(uint32_t insn, OP op)
+{
+    switch ((vtype >> 3) & 0x7)
+    {
+        case 0:  vec_reduce_kernel<int8_t>(insn, op); return;
+        case 1:  vec_reduce_kernel<int16_t>(insn, op); return;
+        case 2:  vec_reduce_kernel<int32_t>(insn, op); return;
+        case 3:  vec_reduce_kernel<int64_t>(insn, op); return;
+    }
+}
+
+/**
+ * @brief Method will execute the given RV32I instruction by
+ * making use of the get_xxx() methods to extract the needed
+ * instruction fields to decode the instruction and invoke the
+ * associated exec_xxx() helper function.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos flag to determine instructions need to print.
+ */
+void rv32i_hart::exec(uint32_t insn, std::ostream* pos)
+{
+    //get funct3
+    uint32_t funct3 = get_funct3(insn);
+
+    //get funct7
+    uint32_t funct7 = get_funct7(insn);
+
+    switch(get_opcode(insn))
+    {
+        default:  exec_illegal_insn(insn, pos); return;
+
+        //U-TYPE INSTRUCTIONS
+        case opcode_lui:   exec_lui(insn, pos); return;
+        case opcode_auipc:  exec_auipc(insn, pos); return;
+
+        //J-TYPE INSTRUCTIONS
+        // case opcode_jal:  exec_jal(pc, insn, pos); return;
+        case opcode_jal:  exec_jal(insn, pos); return;
+
+
+        //I-TYPE INSTRUCTIONS
+        case opcode_jalr:  exec_jalr(insn, pos);  return;
+
+        //B-TYPE INSTRUCTIONS
+        case opcode_btype:
+            switch (funct3)
+            {
+                default:  exec_illegal_insn(insn, pos);
+                case funct3_beq:  exec_beq(insn, pos); return;
+                case funct3_bne:  exec_bne(insn, pos); return;
+                case funct3_blt:  exec_blt(insn, pos); return;
+                case funct3_bge:  exec_bge(insn, pos);  return;
+                case funct3_bltu:  exec_bltu(insn, pos); return;
+                case funct3_bgeu:  exec_bgeu(insn, pos); return;                    
+            }
+
+            assert(0 && "unrecognized funct3"); // impossible
+
+
+        //I-TYPE INSTRUCTIONS
+        case opcode_load_imm:
+            switch (funct3)
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case funct3_lb:  exec_lb(insn, pos); return;
+                case funct3_lh:  exec_lh(insn, pos); return;
+                case funct3_lw:  exec_lw(insn, pos); return;
+                case funct3_lbu:  exec_lbu(insn, pos); return; 
+                case funct3_lhu:  exec_lhu(insn, pos); return;
+            }
+            assert(0 && "unrecognized funct3"); // impossible   
+
+
+        //S-TYPE INSTRUCTIONS
+        case opcode_stype:
+            switch (funct3)
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case funct3_sb:  exec_sb(insn, pos); return;
+                case funct3_sh:  exec_sh(insn, pos); return;
+                case funct3_sw:  exec_sw(insn, pos); return;
+            }
+            assert(0 && "unrecognized funct3"); // impossible   
+
+        
+        //I-TYPE INSTRUCTIONS
+        case opcode_alu_imm:
+            switch (funct3)
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case funct3_add:  exec_addi(insn, pos); return;
+                case funct3_sll:
+                    switch(funct7)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct7_sll:  exec_slli(insn, pos); return;
+                        case funct7_bclr:  exec_bclri(insn, pos); return;
+                        case funct7_binv:  exec_binvi(insn, pos); return;
+                        case funct7_bset:  exec_bseti(insn, pos); return;
+
+                        //Zbb unary instructions select the operation with the rs2 field
+                        case funct7_rot:
+                            switch(get_rs2(insn))
+                            {
+                                default:  exec_illegal_insn(insn, pos); return;
+                                case rs2_clz:  exec_clz(insn, pos); return;
+                                case rs2_ctz:  exec_ctz(insn, pos); return;
+                                case rs2_cpop:  exec_cpop(insn, pos); return;
+                                case rs2_sext_b:  exec_sext_b(insn, pos); return;
+                                case rs2_sext_h:  exec_sext_h(insn, pos); return;
+                            }
+                            assert(0 && "unrecognized rs2"); // impossible
+                    }
+                    assert(0 && "unrecognized funct7"); // impossible
+
+                case funct3_slt:  exec_slti(insn, pos); return;
+                case funct3_sltu:  exec_sltiu(insn, pos); return;
+                case funct3_xor:  exec_xori(insn, pos); return;
+                case funct3_or:  exec_ori(insn, pos); return;
+                case funct3_and:  exec_andi(insn, pos); return;
+
+                case funct3_srx:
+                    switch(funct7)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct7_srl:  exec_srli(insn, pos); return;
+                        case funct7_sra:  exec_srai(insn, pos); return;
+                        case funct7_rot:  exec_rori(insn, pos); return;
+                        case funct7_bclr:  exec_bexti(insn, pos); return;
+                        case funct7_binv:
+                            if (get_rs2(insn) == rs2_rev8) { exec_rev8(insn, pos); return; }
+                            exec_illegal_insn(insn, pos); return;
+                        case funct7_bset:
+                            if (get_rs2(insn) == rs2_orc_b) { exec_orc_b(insn, pos); return; }
+                            exec_illegal_insn(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct7"); // impossible
+            }
+            assert(0 && "unrecognized funct3"); // impossible
+
+        
+        //R-TYPE INSTRUCTIONS
+        case opcode_rtype:
+            //RV32M multiply and divide instructions
+            if (funct7 == funct7_mul)
+            {
+                switch (funct3)
+                {
+                    default:  exec_illegal_insn(insn, pos); return;
+                    case funct3_mul:  exec_mul(insn, pos); return;
+                    case funct3_mulh:  exec_mulh(insn, pos); return;
+                    case funct3_mulhsu:  exec_mulhsu(insn, pos); return;
+                    case funct3_mulhu:  exec_mulhu(insn, pos); return;
+                    case funct3_div:  exec_div(insn, pos); return;
+                    case funct3_divu:  exec_divu(insn, pos); return;
+                    case funct3_rem:  exec_rem(insn, pos); return;
+                    case funct3_remu:  exec_remu(insn, pos); return;
+                }
+                assert(0 && "unrecognized funct3"); // impossible
+            }
+
+            //Zba, Zbb and Zbs instructions that do not share a funct7 with RV32I
+            switch (funct7)
+            {
+                case funct7_zba:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_sh1add:  exec_sh1add(insn, pos); return;
+                        case funct3_sh2add:  exec_sh2add(insn, pos); return;
+                        case funct3_sh3add:  exec_sh3add(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_minmax:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_min:  exec_min(insn, pos); return;
+                        case funct3_minu:  exec_minu(insn, pos); return;
+                        case funct3_max:  exec_max(insn, pos); return;
+                        case funct3_maxu:  exec_maxu(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_rot:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_sll:  exec_rol(insn, pos); return;
+                        case funct3_srx:  exec_ror(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_zexth:
+                    if (funct3 == funct3_xor && get_rs2(insn) == 0) { exec_zext_h(insn, pos); return; }
+                    exec_illegal_insn(insn, pos); return;
+
+                case funct7_bclr:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_sll:  exec_bclr(insn, pos); return;
+                        case funct3_srx:  exec_bext(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_binv:
+                    if (funct3 == funct3_sll) { exec_binv(insn, pos); return; }
+                    exec_illegal_insn(insn, pos); return;
+
+                case funct7_bset:
+                    if (funct3 == funct3_sll) { exec_bset(insn, pos); return; }
+                    exec_illegal_insn(insn, pos); return;
+            }
+
+            switch (funct3)
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case funct3_add: 
+                        switch(funct7)
+                        {
+                            default:  exec_illegal_insn(insn, pos); return;
+                            case funct7_add:  exec_add(insn, pos); return;
+                            case funct7_sub:  exec_sub(insn, pos); return;
+                        }
+                        assert(0 && "unrecognized funct7"); // impossible
+
+
+                case funct3_sll:  exec_sll(insn, pos); return;
+                case funct3_slt:  exec_slt(insn, pos); return;
+                case funct3_sltu:  exec_sltu(insn, pos); return;
+                case funct3_xor:
+                    switch(funct7)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct7_add:  exec_xor(insn, pos); return;
+                        case funct7_sub:  exec_xnor(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct7"); // impossible
+
+                case funct3_or:
+                    switch(funct7)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct7_add:  exec_or(insn, pos); return;
+                        case funct7_sub:  exec_orn(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct7"); // impossible
+
+                case funct3_and:
+                    switch(funct7)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct7_add:  exec_and(insn, pos); return;
+                        case funct7_sub:  exec_andn(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct7"); // impossible
+
+                case funct3_srx:
+                    switch(funct7)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct7_sra:  exec_sra(insn, pos); return;
+                        case funct7_srl:  exec_srl(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct7"); // impossible
+            }
+            assert(0 && "unrecognized funct3"); // impossible
+
+
+        //FLOATING POINT AND VECTOR LOADS AND STORES
+        case opcode_load_fp:
+            switch (funct3)
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case funct3_flw:  exec_flw(insn, pos); return;
+                case funct3_fld:  exec_fld(insn, pos); return;
+                case funct3_vle8:
+                case funct3_vle16:
+                case funct3_vle32:
+                case funct3_vle64:  exec_vmem(insn, pos); return;
+            }
+            assert(0 && "unrecognized funct3"); // impossible
+
+        case opcode_store_fp:
+            switch (funct3)
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case funct3_fsw:  exec_fsw(insn, pos); return;
+                case funct3_fsd:  exec_fsd(insn, pos); return;
+                case funct3_vle8:
+                case funct3_vle16:
+                case funct3_vle32:
+                case funct3_vle64:  exec_vmem(insn, pos); return;
+            }
+            assert(0 && "unrecognized funct3"); // impossible
+
+
+        //RV32F AND RV32D FUSED MULTIPLY-ADD INSTRUCTIONS
+        case opcode_fmadd:
+            switch (get_fmt(insn))
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case fmt_s:  exec_fmadd_s(insn, pos); return;
+                case fmt_d:  exec_fmadd_d(insn, pos); return;
+            }
+            assert(0 && "unrecognized fmt"); // impossible
+
+        case opcode_fmsub:
+            switch (get_fmt(insn))
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case fmt_s:  exec_fmsub_s(insn, pos); return;
+                case fmt_d:  exec_fmsub_d(insn, pos); return;
+            }
+            assert(0 && "unrecognized fmt"); // impossible
+
+        case opcode_fnmsub:
+            switch (get_fmt(insn))
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case fmt_s:  exec_fnmsub_s(insn, pos); return;
+                case fmt_d:  exec_fnmsub_d(insn, pos); return;
+            }
+            assert(0 && "unrecognized fmt"); // impossible
+
+        case opcode_fnmadd:
+            switch (get_fmt(insn))
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case fmt_s:  exec_fnmadd_s(insn, pos); return;
+                case fmt_d:  exec_fnmadd_d(insn, pos); return;
+            }
+            assert(0 && "unrecognized fmt"); // impossible
+
+
+        //RV32F AND RV32D COMPUTATIONAL INSTRUCTIONS
+        case opcode_op_fp:
+            switch (funct7)
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case funct7_fadd_s:  exec_fadd_s(insn, pos); return;
+                case funct7_fadd_d:  exec_fadd_d(insn, pos); return;
+                case funct7_fsub_s:  exec_fsub_s(insn, pos); return;
+                case funct7_fsub_d:  exec_fsub_d(insn, pos); return;
+                case funct7_fmul_s:  exec_fmul_s(insn, pos); return;
+                case funct7_fmul_d:  exec_fmul_d(insn, pos); return;
+                case funct7_fdiv_s:  exec_fdiv_s(insn, pos); return;
+                case funct7_fdiv_d:  exec_fdiv_d(insn, pos); return;
+
+                case funct7_fsqrt_s:
+                    switch (get_rs2(insn))
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case 0:  exec_fsqrt_s(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fsqrt_d:
+                    switch (get_rs2(insn))
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case 0:  exec_fsqrt_d(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fsgnj_s:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_fsgnj:  exec_fsgnj_s(insn, pos); return;
+                        case funct3_fsgnjn:  exec_fsgnjn_s(insn, pos); return;
+                        case funct3_fsgnjx:  exec_fsgnjx_s(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fsgnj_d:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_fsgnj:  exec_fsgnj_d(insn, pos); return;
+                        case funct3_fsgnjn:  exec_fsgnjn_d(insn, pos); return;
+                        case funct3_fsgnjx:  exec_fsgnjx_d(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fminmax_s:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_fmin:  exec_fmin_s(insn, pos); return;
+                        case funct3_fmax:  exec_fmax_s(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fminmax_d:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_fmin:  exec_fmin_d(insn, pos); return;
+                        case funct3_fmax:  exec_fmax_d(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fcmp_s:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_feq:  exec_feq_s(insn, pos); return;
+                        case funct3_flt:  exec_flt_s(insn, pos); return;
+                        case funct3_fle:  exec_fle_s(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fcmp_d:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_feq:  exec_feq_d(insn, pos); return;
+                        case funct3_flt:  exec_flt_d(insn, pos); return;
+                        case funct3_fle:  exec_fle_d(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fcvt_s_d:
+                    switch (get_rs2(insn))
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case fmt_d:  exec_fcvt_s_d(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fcvt_d_s:
+                    switch (get_rs2(insn))
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case fmt_s:  exec_fcvt_d_s(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fcvt_w_s:
+                    switch (get_rs2(insn))
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case rs2_fcvt_w:  exec_fcvt_w_s(insn, pos); return;
+                        case rs2_fcvt_wu:  exec_fcvt_wu_s(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fcvt_w_d:
+                    switch (get_rs2(insn))
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case rs2_fcvt_w:  exec_fcvt_w_d(insn, pos); return;
+                        case rs2_fcvt_wu:  exec_fcvt_wu_d(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fcvt_s_w:
+                    switch (get_rs2(insn))
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case rs2_fcvt_w:  exec_fcvt_s_w(insn, pos); return;
+                        case rs2_fcvt_wu:  exec_fcvt_s_wu(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fcvt_d_w:
+                    switch (get_rs2(insn))
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case rs2_fcvt_w:  exec_fcvt_d_w(insn, pos); return;
+                        case rs2_fcvt_wu:  exec_fcvt_d_wu(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized rs2"); // impossible
+
+                case funct7_fmv_x_w:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_fmv:  exec_fmv_x_w(insn, pos); return;
+                        case funct3_fclass:  exec_fclass_s(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fclass_d:
+                    switch (funct3)
+                    {
+                        default:  exec_illegal_insn(insn, pos); return;
+                        case funct3_fclass:  exec_fclass_d(insn, pos); return;
+                    }
+                    assert(0 && "unrecognized funct3"); // impossible
+
+                case funct7_fmv_w_x:
+                    if (funct3 == funct3_fmv && get_rs2(insn) == 0) { exec_fmv_w_x(insn, pos); return; }
+                    exec_illegal_insn(insn, pos); return;
+            }
+            assert(0 && "unrecognized funct7"); // impossible
+
+
+        //RVV VECTOR INSTRUCTIONS
+        case opcode_op_v:
+            switch (funct3)
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case funct3_opcfg:  exec_vsetvl(insn, pos); return;
+                case funct3_opivv:
+                case funct3_opivx:
+                case funct3_opivi:  exec_vopi(insn, pos); return;
+                case funct3_opmvv:
+                case funct3_opmvx:  exec_vopm(insn, pos); return;
+            }
+            assert(0 && "unrecognized funct3"); // impossible
+
+
+        //HOST BULK MEMORY SERVICE, only when enabled so instruction
+        //accurate runs see an illegal instruction
+        case opcode_custom_0:
+            if (!bulk_memory || (insn & ~0x0000707f))
+            {
+                exec_illegal_insn(insn, pos);
+                return;
+            }
+
+            switch (funct3)
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case funct3_bulk_cpy:  exec_bulk_cpy(insn, pos); return;
+                case funct3_bulk_set:  exec_bulk_set(insn, pos); return;
+                case funct3_bulk_cmp:  exec_bulk_cmp(insn, pos); return;
+            }
+            assert(0 && "unrecognized funct3"); // impossible
+
+
+        case opcode_system:
+            //EBBREAK
+            switch(insn)
+            {
+                case insn_ecall:  exec_ecall(insn, pos); return;
+                case insn_ebreak:  exec_ebreak(insn, pos); return;
+                case insn_mret:  exec_mret(insn, pos); return;
+                case insn_wfi:  exec_wfi(insn, pos); return;
+            }
+
+            if (funct3 == 0 && get_funct7(insn) == funct7_sfence_vma && get_rd(insn) == 0)
+            {
+                exec_sfence_vma(insn, pos);
+                return;
+            }
+
+            switch(funct3)
+            {
+                default:  exec_illegal_insn(insn, pos); return;
+                case funct3_csrrw:  exec_csrrw(insn, pos); return;
+                case funct3_csrrs:  exec_csrrs(insn, pos); return;
+                case funct3_csrrc:  exec_csrrc(insn, pos); return;
+                case funct3_csrrwi:  exec_csrrwi(insn, pos); return;
+                case funct3_csrrsi:  exec_csrrsi(insn, pos); return;
+                case funct3_csrrci:  exec_csrrci(insn, pos); return;
+            }
+            assert(0 && "unrecognized funct3"); // impossible      
+    }
+    assert(0 && "unrecognized opcode"); // It should be impossible to ever get here!
+}
+
+/**
+ * @brief Method to halt execution when encountering an illegal
+ * instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos flag that determines when to render error message.
+ */
+void rv32i_hart::exec_illegal_insn(uint32_t insn, std::ostream* pos)
+{
+    (void)insn;
+
+    //render proper error message by writing it to the ostream
+    if(pos)
+    {
+        *pos << render_illegal_insn(insn);
+    }
+
+    //trap, or halt execution if there is no handler
+    trap(cause_illegal_insn, insn, "Illegal instruction");
+}
+
+/**
+ * @brief Method to execute the lui instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_lui(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get immediate value for u-type instruction
+    int32_t imm_u = get_imm_u(insn);
+
+    //render the simulation summary comment that shows the values of all the registers
+    //involved before and after the instruction simulation (rd ← imm u, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_lui(insn);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                          rd       =          immu
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(imm_u);
+    }
+
+    //set rd register to immediate value of instruction (rd <- imm_u)
+    regs.set(rd, imm_u);
+
+    //increment the pc register (pc <- pc + 4)
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the auipc instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_auipc(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get immediate value for u-type instruction
+    int32_t imm_u = get_imm_u(insn);
+
+    //calculate value for this instruction's pc register
+    int32_t sum = pc + imm_u;
+
+    //render the simulation summary comment that shows the values of all the registers
+    //involved before and after the instruction simulation (rd ← pc + imm u, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_auipc(insn);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                      rd           =              pc          +               imm_u         =         val
         *pos << "// " << render_reg(rd) << " = " << to_hex0x32(pc) << " + " << to_hex0x32(imm_u) << " = " << to_hex0x32(sum);
     }
 
-    //store the calculated result for this instruction into rd (rd ← pc + imm u)
-    regs.set(rd, sum);
+    //store the calculated result for this instruction into rd (rd ← pc + imm u)
+    regs.set(rd, sum);
+
+    //increment the pc register (pc <- pc + 4)
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the jal instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */       
+// void rv32i_hart::exec_jal(uint32_t addr, uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_jal(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get immediate value for j-type instruction
+    int32_t imm_j = get_imm_j(insn);
+
+    //calculate address of the next instruction
+    int32_t next_insn = pc + insn_length;
+
+    //calculate the target address
+    int32_t target_addr = pc + imm_j;
+
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← pc+4, pc ← pc+imm j)
+    if(pos)
+    {
+        std::string s = render_jal(pc, insn);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                  rd              =           next instruction      , pc =                pc          +           imm_j             =             target_addr
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(next_insn) << ",  pc = " << to_hex0x32(pc) << " + " << to_hex0x32(imm_j) << " = " << to_hex0x32(target_addr);
+    }
+
+    //the jump ends a basic block
+    if (bbv)
+    {
+        bbv->end_block(pc, insn_counter);
+    }
+
+    //set register rd to the address of the next instruction (rd ← pc+4)
+    regs.set(rd, next_insn);
+
+    //jump to target address (pc ← pc+imm j)
+    pc = target_addr;
+
+    //a jump to itself is an idle loop
+    idle = (imm_j == 0);
+}
+
+/**
+ * @brief Method to execute the jalr instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */    
+void rv32i_hart::exec_jalr(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //calculate address of the next instruction
+    int32_t next_insn = pc + insn_length;
+
+    //get the signed register source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //calculate the target address and set the LSB to zero
+    int32_t target_addr = (imm_i + s_rs1) & 0xfffffffe;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← pc+4, pc ← (rs1+imm i)&~1)
+    if(pos)
+    {
+        std::string s = render_jalr(insn);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                  rd               =                  pc+4          ,  pc = (              imm_i         +                   rs1    ) & 0xfffffffe =             target address
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(next_insn) << ",  pc = (" << to_hex0x32(imm_i) << " + " << to_hex0x32(s_rs1) << ") & 0xfffffffe = " << to_hex0x32(target_addr);
+    }
+
+    //the jump ends a basic block
+    if (bbv)
+    {
+        bbv->end_block(pc, insn_counter);
+    }
+
+    //set register rd to the address of the next instruction (rd ← pc+4)
+    regs.set(rd, next_insn);
+
+    //jump to target address ((rs1+imm i)&~1)
+    pc = target_addr;
+}
+
+/**
+ * @brief Method to execute the beq instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_beq(uint32_t insn, std::ostream* pos)
+{
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for b-type instruction
+    int32_t imm_b = get_imm_b(insn);
+
+    //get signed source operands for calculation
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //set current instruction address
+    uint32_t addr = pc;
+
+    //the branch ends a basic block
+    if (bbv)
+    {
+        bbv->end_block(addr, insn_counter);
+    }
+
+    //If rs1 is equal to rs2 then add imm_b to the pc register. Else add 4.
+    pc += ((s_rs1 == s_rs2) ? imm_b : insn_length);
+
+    //a branch to itself is an idle loop
+    idle = (pc == addr);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (pc ← pc + ((rs1==rs2) ? imm b : 4))
+    if(pos)
+    {
+        std::string s = render_btype(addr, insn, "beq");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //           pc +=               (( rs1         ==                  rs2)       ?                  imm_b       : 4) =           pc
+        *pos << "// pc += (" << to_hex0x32(s_rs1) << " == " << to_hex0x32(s_rs2) << " ? " << to_hex0x32(imm_b) << " : " << insn_length << ") = " << to_hex0x32(pc);
+    }
+}
+
+/**
+ * @brief Method to execute the bne instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_bne(uint32_t insn, std::ostream* pos)
+{
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for b-type instruction
+    int32_t imm_b = get_imm_b(insn);
+
+    //get signed source operands for calculation
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //set current instruction address
+    uint32_t addr = pc;
+
+    //the branch ends a basic block
+    if (bbv)
+    {
+        bbv->end_block(addr, insn_counter);
+    }
+
+    //If rs1 is not equal to rs2 then add imm_b to the pc register. Else add 4.
+    pc += ((s_rs1 != s_rs2) ? imm_b : insn_length);
+
+    //a branch to itself is an idle loop
+    idle = (pc == addr);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (pc ← pc + ((rs1!=rs2) ? imm b : 4))
+    if(pos)
+    {
+        std::string s = render_btype(addr, insn, "bne");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //          pc    +=                (( rs1         !=                 rs2)       ?                  imm_b       : 4) =           pc
+        *pos << "// pc += (" << to_hex0x32(s_rs1) << " != " << to_hex0x32(s_rs2) << " ? " << to_hex0x32(imm_b) << " : " << insn_length << ") = " << to_hex0x32(pc);
+    }
+}
+
+/**
+ * @brief Method to execute the blt instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */        
+void rv32i_hart::exec_blt(uint32_t insn, std::ostream* pos)
+{
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for b-type instruction
+    int32_t imm_b = get_imm_b(insn);
+
+    //get signed source operands for calculation
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //set current instruction address
+    uint32_t addr = pc;
+
+    //the branch ends a basic block
+    if (bbv)
+    {
+        bbv->end_block(addr, insn_counter);
+    }
+
+    //If the signed value in rs1 is less than the signed
+    //value in rs2 then add imm_b to the pc register. Else add 4.
+    pc += ((s_rs1 < s_rs2) ? imm_b : insn_length);
+
+    //a branch to itself is an idle loop
+    idle = (pc == addr);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (pc ← pc + ((rs1<rs2) ? imm b : 4))
+    if(pos)
+    {
+        std::string s = render_btype(addr, insn, "blt");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //          pc +=               (( rs1         <                  rs2)       ?                  imm_b       : 4) =           pc
+        *pos << "// pc += (" << to_hex0x32(s_rs1) << " < " << to_hex0x32(s_rs2) << " ? " << to_hex0x32(imm_b) << " : " << insn_length << ") = " << to_hex0x32(pc);
+    }
+}
+
+/**
+ * @brief Method to execute the bge instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */                
+void rv32i_hart::exec_bge(uint32_t insn, std::ostream* pos)
+{
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for b-type instruction
+    int32_t imm_b = get_imm_b(insn);
+
+    //get signed source operands for calculation
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //set current instruction address
+    uint32_t addr = pc;
+
+    //the branch ends a basic block
+    if (bbv)
+    {
+        bbv->end_block(addr, insn_counter);
+    }
+
+    //If the signed value in rs1 is greater than or equal 
+    //to the signed value in rs2 then add imm_b to the pc register. Else add 4.
+    pc += ((s_rs1 >= s_rs2) ? imm_b : insn_length);
+
+    //a branch to itself is an idle loop
+    idle = (pc == addr);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (pc ← pc + ((rs1>=rs2) ? imm b : 4))
+    if(pos)
+    {
+        std::string s = render_btype(addr, insn, "bge");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //          pc +=               (( rs1         >=                  rs2)       ?                  imm_b       : 4) =           pc
+        *pos << "// pc += (" << to_hex0x32(s_rs1) << " >= " << to_hex0x32(s_rs2) << " ? " << to_hex0x32(imm_b) << " : " << insn_length << ") = " << to_hex0x32(pc);
+    }
+}
+
+/**
+ * @brief Method to execute the bltu instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */                
+void rv32i_hart::exec_bltu(uint32_t insn, std::ostream* pos)
+{
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for b-type instruction
+    int32_t imm_b = get_imm_b(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //set current instruction address
+    uint32_t addr = pc;
+
+    //the branch ends a basic block
+    if (bbv)
+    {
+        bbv->end_block(addr, insn_counter);
+    }
+
+    //If the unsigned value in rs1 is less than the
+    //unsigned value in rs2 then add imm_b to the pc1795 register. Else add 4.
+    pc += ((u_rs1 < u_rs2) ? imm_b : insn_length);
+
+    //a branch to itself is an idle loop
+    idle = (pc == addr);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (pc ← pc + ((rs1<rs2) ? imm b : 4))
+    if(pos)
+    {
+        std::string s = render_btype(addr, insn, "bltu");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //          pc +=               (( rs1         <U                  rs2)       ?                  imm_b       : 4) =           pc
+        *pos << "// pc += (" << to_hex0x32(u_rs1) << " <U " << to_hex0x32(u_rs2) << " ? " << to_hex0x32(imm_b) << " : " << insn_length << ") = " << to_hex0x32(pc);
+    }
+}
+
+/**
+ * @brief Method to execute the bgeu instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */   
+void rv32i_hart::exec_bgeu(uint32_t insn, std::ostream* pos)
+{
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for b-type instruction
+    int32_t imm_b = get_imm_b(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //set current instruction address
+    uint32_t addr = pc;
+
+    //the branch ends a basic block
+    if (bbv)
+    {
+        bbv->end_block(addr, insn_counter);
+    }
+
+    //If the unsigned value in rs1 is greater than or equal
+    //to the unsigned value in rs2 then add imm_b to the pc register. Else add 4.
+    pc += ((u_rs1 >= u_rs2) ? imm_b : insn_length);
+
+    //a branch to itself is an idle loop
+    idle = (pc == addr);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (pc ← pc + ((rs1>=rs2) ? imm b : 4))
+    if(pos)
+    {
+        std::string s = render_btype(addr, insn, "bgeu");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //           pc +=               (( rs1         >=U                  rs2)       ?                  imm_b       : 4) =           pc
+        *pos << "// pc += (" << to_hex0x32(u_rs1) << " >=U " << to_hex0x32(u_rs2) << " ? " << to_hex0x32(imm_b) << " : " << insn_length << ") = " << to_hex0x32(pc);
+    }
+}
+
+/**
+ * @brief Method to execute the lb instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */  
+void rv32i_hart::exec_lb(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //get signed source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //calculate the sum of rs1 and the immediate value
+    int32_t sum = s_rs1 + imm_i;
+
+    //fetch the byte from memory, a page fault traps and leaves rd alone
+    uint32_t loaded;
+    if (!read_mem(sum, 1, loaded))
+    {
+        return;
+    }
+    int32_t byte = (int8_t)loaded;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← sx(m8(rs1+imm i)), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_load(insn, "lb");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                          rd      = sx(m8(                rs1          +                 imm_i     )) =          byte
+        *pos << "// " << render_reg(rd) << " = sx(m8(" << to_hex0x32(s_rs1) << " + " << to_hex0x32(imm_i) << ")) = " << to_hex0x32(byte);
+    }
+
+    //set register rd to the value of the sign extended byte fetched from the
+    //memory address given by the sum of rs1 and imm_i
+    regs.set(rd, byte);
+
+    //increment the pc register (pc <- pc + 4)
+    pc += insn_length;    
+}
+
+/**
+ * @brief Method to execute the lh instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */         
+void rv32i_hart::exec_lh(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //get signed source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //calculate the sum of rs1 and the immediate value
+    int32_t sum = s_rs1 + imm_i;
+
+    //fetch the 16 bit value from memory, a page fault traps and leaves rd alone
+    uint32_t loaded;
+    if (!read_mem(sum, 2, loaded))
+    {
+        return;
+    }
+    int32_t halfword = (int16_t)loaded;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← sx(m16(rs1+imm i)), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_load(insn, "lh");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                          rd      = sx(m16(                rs1          +                  imm_i     )) =          halfword
+        *pos << "// " << render_reg(rd) << " = sx(m16(" << to_hex0x32(s_rs1) << " + " << to_hex0x32(imm_i) << ")) = " << to_hex0x32(halfword);
+    }
+
+    //set register rd to the value of the sign extended 16 bit little endian
+    //half-word value fetched from the memory address given by the sum of rs1 and imm_i
+    regs.set(rd, halfword);
+
+    //increment the pc register (pc <- pc + 4)
+    pc += insn_length;        
+}
+
+/**
+ * @brief Method to execute the lw instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */          
+void rv32i_hart::exec_lw(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //get signed source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //calculate the sum of rs1 and the immediate value
+    int32_t sum = s_rs1 + imm_i;
+
+    //fetch the 32 bit value from memory, a page fault traps and leaves rd alone
+    uint32_t loaded;
+    if (!read_mem(sum, 4, loaded))
+    {
+        return;
+    }
+    int32_t word = loaded;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← sx(m32(rs1+imm i)), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_load(insn, "lw");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                          rd      = sx(m32(                 rs1          +                imm_i     )) =          word
+        *pos << "// " << render_reg(rd) << " = sx(m32(" << to_hex0x32(s_rs1) << " + " << to_hex0x32(imm_i) << ")) = " << to_hex0x32(word);
+    }
+
+    //set register rd to the value of the sign extended 32 bit little endian
+    //word value fetched from the memory address given by the sum of rs1 and imm_i
+    regs.set(rd, word);
+
+    //increment the pc register (pc <- pc + 4)
+    pc += insn_length;      
+}
+
+/**
+ * @brief Method to execute the lbu instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */ 
+void rv32i_hart::exec_lbu(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //calculate the sum of rs1 and the immediate value
+    uint32_t sum = u_rs1 + imm_i;
+
+    //fetch the byte from memory, a page fault traps and leaves rd alone
+    uint32_t byte;
+    if (!read_mem(sum, 1, byte))
+    {
+        return;
+    }
+
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← zx(m8(rs1+imm i)), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_load(insn, "lbu");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                          rd      = zx(m8(                        rs1          +                  imm_i     )) =          byte
+        *pos << "// " << render_reg(rd) << " = zx(m8(" << to_hex0x32(u_rs1) << " + " << to_hex0x32(imm_i) << ")) = " << to_hex0x32(byte);
+    }
+
+    //set register rd to the value of the zero extended byte fetched from the
+    //memory address given by the sum of rs1 and imm_i
+    regs.set(rd, byte);
+
+    //increment the pc register (pc <- pc + 4)
+    pc += insn_length;     
+}
+
+/**
+ * @brief Method to execute the lhu instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */ 
+void rv32i_hart::exec_lhu(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //calculate the sum of rs1 and the immediate value
+    uint32_t sum = u_rs1 + imm_i;
+
+    //fetch the 16 bit value from memory, a page fault traps and leaves rd alone
+    uint32_t halfword;
+    if (!read_mem(sum, 2, halfword))
+    {
+        return;
+    }
+
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← zx(m16(rs1+imm i)), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_load(insn, "lhu");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                          rd      = zx(m16(                        rs1          +                  imm_i     )) =          halfword
+        *pos << "// " << render_reg(rd) << " = zx(m16(" << to_hex0x32(u_rs1) << " + " << to_hex0x32(imm_i) << ")) = " << to_hex0x32(halfword);
+    }
+
+    //set register rd to the value of the zero extended halfword fetched from the
+    //memory address given by the sum of rs1 and imm_i
+    regs.set(rd, halfword);
+
+    //increment the pc register (pc <- pc + 4)
+    pc += insn_length;     
+}
+
+/**
+ * @brief Method to execute the sb instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */         
+void rv32i_hart::exec_sb(uint32_t insn, std::ostream* pos)
+{
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for s-type instruction
+    uint32_t imm_s = get_imm_s(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate the sum of rs1 and the immediate value
+    uint32_t sum = u_rs1 + imm_s;
+
+    //extract bits 7->0 from the rs2
+    uint32_t byte = u_rs2 & 0x000000ff;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (m8(rs1+imm s) ← rs2[7:0], pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_stype(insn, "sb");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //          m8(                  rs1        +                imm_s     )) =          rs2[7:0]
+        *pos << "// m8(" << to_hex0x32(u_rs1) << " + " << to_hex0x32(imm_s) << ") = " << to_hex0x32(byte);
+    }
+
+    //set the byte of memory at the address given by the sum of rs1 and imm_s
+    if (!write_mem(sum, 1, byte))
+    {
+        return;
+    }
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the sh instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */         
+void rv32i_hart::exec_sh(uint32_t insn, std::ostream* pos)
+{
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for s-type instruction
+    uint32_t imm_s = get_imm_s(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate the sum of rs1 and the immediate value
+    uint32_t sum = u_rs1 + imm_s;
+
+    //extract bits 15->0 from the rs2
+    uint32_t halfword = u_rs2 & 0x0000ffff;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (m16(rs1+imm s) ← rs2[15:0], pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_stype(insn, "sh");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //          m16(                  rs1        +                imm_s     )) =          rs2[15:0]
+        *pos << "// m16(" << to_hex0x32(u_rs1) << " + " << to_hex0x32(imm_s) << ") = " << to_hex0x32(halfword);
+    }
+
+    //set the halfword of memory at the address given by the sum of rs1 and imm_s
+    if (!write_mem(sum, 2, halfword))
+    {
+        return;
+    }
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the sw instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */         
+void rv32i_hart::exec_sw(uint32_t insn, std::ostream* pos)
+{
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for s-type instruction
+    uint32_t imm_s = get_imm_s(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate the sum of rs1 and the immediate value
+    uint32_t sum = u_rs1 + imm_s;
+
+    //extract bits 32->0 from the rs2
+    uint32_t word = u_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (m32(rs1+imm s) ← rs2[31:0], pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_stype(insn, "sw");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //          m32(                  rs1        +                imm_s     )) =          rs2[31:0]
+        *pos << "// m32(" << to_hex0x32(u_rs1) << " + " << to_hex0x32(imm_s) << ") = " << to_hex0x32(word);
+    }
+
+    //set the word of memory at the address given by the sum of rs1 and imm_s
+    if (!write_mem(sum, 4, word))
+    {
+        return;
+    }
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the addi instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_addi(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //get the signed register source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //calculate the sum of rs1 and the immediate value
+    int32_t sum = s_rs1 + imm_i;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 + imm i, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "addi", imm_i);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1          +              imm_i          =            sum
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " + " << to_hex0x32(imm_i) << " = " << to_hex0x32(sum);
+    }
+
+    //set the rd to rs1 + imm_i
+    regs.set(rd, sum);
+
+    //increment the pc register
+    pc += insn_length;    
+}
+
+/**
+ * @brief Method to execute the slli instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_slli(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //get the signed register source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //Shift rs1 left by the number of bits specified in shamt_i
+    uint32_t shift = s_rs1 << imm_i;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 << shamt i, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "slli", imm_i);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1          <<      imm_i      =            shift
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " << " << imm_i << " = " << to_hex0x32(shift);
+    }
+
+    //set rd to the result of the shift
+    regs.set(rd, shift);
+
+    //increment the pc register
+    pc += insn_length;       
+}
+
+/**
+ * @brief Method to execute the slti instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_slti(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //get the signed register source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //If the signed integer value in rs1 is less than the signed integer value in imm_i then set rd to 1. Otherwise, set rd to 0.
+    int32_t val = ((s_rs1 < imm_i) ? 1 : 0);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 < imm i) ? 1 : 0, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "slti", imm_i);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1          <       imm_i          =            val
+        *pos << "// " << render_reg(rd) << " = (" << to_hex0x32(s_rs1) << " < " << imm_i << ") ? 1 : 0 = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the shift
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;   
+}
+
+/**
+ * @brief Method to execute sltiu instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column. 
+ */
+void rv32i_hart::exec_sltiu(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    uint32_t imm_i = get_imm_i(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //If the unsigned integer value in rs1 is less than the signed integer value in imm_i then set rd to 1. Otherwise, set rd to 0.
+    uint32_t val = ((u_rs1 < imm_i) ? 1 : 0);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 < imm i) ? 1 : 0, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "sltiu", imm_i);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1          <U              imm_i          =            val
+        *pos << "// " << render_reg(rd) << " = (" << to_hex0x32(u_rs1) << " <U " << imm_i << ") ? 1 : 0 = " << to_hex0x32(val);
+    }
+
+    //set rd to the designated value
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;       
+}
+
+/**
+ * @brief Method to execute the xori instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_xori(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //get the signed register source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //Set register rd to the bitwise xor of rs1 and imm_i.
+    int32_t val = s_rs1 ^ imm_i;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 ^ imm i, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "xori", imm_i);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1          ^              imm_i          =            val
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " ^ " << to_hex0x32(imm_i) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the bitwise operation
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;    
+}
+
+/**
+ * @brief Method to execute the ori instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_ori(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //get the signed register source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //Set register rd to the bitwise or of rs1 and imm_i.
+    uint32_t val = s_rs1 | imm_i;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 ^ imm i, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "ori", imm_i);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1          |              imm_i          =            val
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " | " << to_hex0x32(imm_i) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the bitwise operation
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;      
+}
+
+/**
+ * @brief Method to execute the andi instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_andi(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //get the signed register source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //Set register rd to the bitwise and of rs1 and imm_i.
+    uint32_t val = s_rs1 & imm_i;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 ^ imm i, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "andi", imm_i);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1          &              imm_i          =            val
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " & " << to_hex0x32(imm_i) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the bitwise operation
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the srli instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column. 
+ */
+void rv32i_hart::exec_srli(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    uint32_t imm_i = get_imm_i(insn);
+
+    //get the signed register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //Shift rs1 right by the number of bits specified in shamt_i
+    uint32_t shift = u_rs1 >> (imm_i & 0x0000001f);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 >> shamt i, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "srli", imm_i);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1          >>       imm_i          =            shift
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " >> " << imm_i << " = " << to_hex0x32(shift);
+    }
+
+    //set rd to the result of the shift
+    regs.set(rd, shift);
+
+    //increment the pc register
+    pc += insn_length;   
+}
+
+/**
+ * @brief Method to execute the srai instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column. 
+ */
+void rv32i_hart::exec_srai(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    uint32_t imm_i = get_imm_i(insn);
+
+    //get the signed register source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //extract shamt_i value from imm_i
+    int32_t shamt_i = (imm_i & 0x0000001f);
+
+    //Shift rs1 right by the number of bits specified in shamt_i
+    int32_t shift = s_rs1 >> shamt_i;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 >> shamt i, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "srai", shamt_i);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1          >>        shamt_i     =            shift
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " >> " << shamt_i << " = " << to_hex0x32(shift);
+    }
+
+    //set rd to the result of the shift
+    regs.set(rd, shift);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the add instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_add(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source register
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source register
+    uint32_t rs2 = get_rs2(insn);
+
+    //calculate sum of rs1 + rs2
+    int32_t val = regs.get(rs1) + regs.get(rs2);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 + rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "add");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1                  +                     rs2           =            val
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " + " << to_hex0x32(regs.get(rs2)) << " = " << to_hex0x32(val);
+    }
+
+    //Set register rd to rs1 + rs2.
+    regs.set(rd, val);
+
+    //increment pc register
+    pc += insn_length;
+
+}
+
+/**
+ * @brief Method to execute the sub instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_sub(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source register
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source register
+    uint32_t rs2 = get_rs2(insn);
+
+    //calculate difference of rs1 + rs2
+    int32_t val = regs.get(rs1) - regs.get(rs2);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 - rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "sub");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1                  -                     rs2           =            val
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " - " << to_hex0x32(regs.get(rs2)) << " = " << to_hex0x32(val);
+    }
+
+    //Set register rd to rs1 - rs2.
+    regs.set(rd, val);
+
+    //increment pc register
+    pc += insn_length;
+
+}
+
+/**
+ * @brief Method to execute the sll instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_sll(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source register
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source register
+    uint32_t rs2 = get_rs2(insn);
+
+    //extract the 5 LSB of rs2
+    int32_t shift = (regs.get(rs2) & 0x0000001f);
+
+    //shift left rs1 by the extracted 5 LSB of rs2
+    int32_t val = regs.get(rs1) << shift;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 << (rs2%XLEN), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "sll");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1                  <<      shift     =            val
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " << " << shift << " = " << to_hex0x32(val);
+    }
+
+    //Set register rd to rs1 << (rs2%XLEN)
+    regs.set(rd, val);
+
+    //increment pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the slt instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column. 
+ */
+void rv32i_hart::exec_slt(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source register
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source register
+    uint32_t rs2 = get_rs2(insn);
+
+    //If the signed integer value in rs1 is less than the signed integer value in rs2 then set rd to 1. Otherwise, set rd to 0.
+    int32_t val = (regs.get(rs1) < regs.get(rs2) ? 1 : 0);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 < rs2) ? 1 : 0, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "slt");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                (rs1                   <                     rs2          ) ? 1 : 0 =            val
+        *pos << "// " << render_reg(rd) << " = (" << to_hex0x32(regs.get(rs1)) << " < " << to_hex0x32(regs.get(rs2)) << ") ? 1 : 0 = " << to_hex0x32(val);
+    }
+
+    //set rd to value
+    regs.set(rd, val);
+
+    //increment pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the sltu instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column. 
+ */
+void rv32i_hart::exec_sltu(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source register
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source register
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //if the unsigned integer value in rs1 is less than the unsigned integer value in rs2 then set rd to 1. Otherwise, set rd to 0.
+    uint32_t val = (u_rs1 < u_rs2 ? 1 : 0);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 < rs2) ? 1 : 0, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "sltu");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                (rs1          <U                rs2          ) ? 1 : 0 =            val
+        *pos << "// " << render_reg(rd) << " = (" << to_hex0x32(u_rs1) << " <U " << to_hex0x32(u_rs2) << ") ? 1 : 0 = " << to_hex0x32(val);
+    }
+
+    //set rd to value
+    regs.set(rd, val);
+
+    //increment pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the xor instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column. 
+ */
+void rv32i_hart::exec_xor(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //Set register rd to the bitwise XOR of rs1 and rs2.
+    int32_t val = regs.get(rs1) ^ regs.get(rs2);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 ^ rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "xor");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1          ^              rs2          =            val
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " ^ " << to_hex0x32(regs.get(rs2)) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the bitwise operation
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;    
+
+}
+
+/**
+ * @brief Method to execute the or instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column. 
+ */
+void rv32i_hart::exec_or(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //Set register rd to the bitwise OR of rs1 and rs2.
+    uint32_t val = regs.get(rs1) | regs.get(rs2);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 | rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "or");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1                  |                        rs2          =            val
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " | " << to_hex0x32(regs.get(rs2)) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the bitwise operation
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;       
+}
+
+/**
+ * @brief Method to execute the and instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_and(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //Set register rd to the bitwise AND of rs1 and rs2.
+    uint32_t val = regs.get(rs1) & regs.get(rs2);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 & rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "and");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                rs1                  &                        rs2          =            val
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " & " << to_hex0x32(regs.get(rs2)) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the bitwise operation
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the sra instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_sra(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //extract the 5 LSB of rs2
+    int32_t shift = (regs.get(rs2) & 0x0000001f);
+
+    //shift right arithmetically rs1 by the extracted 5 LSB of rs2
+    int32_t val = regs.get(rs1) >> shift;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 >> (rs2%XLEN), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "sra");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                (rs1                   >>     shift      =            val
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " >> " << shift << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the bitwise operation
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the srl instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_srl(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //extract the 5 LSB of rs2
+    uint32_t shift = (regs.get(rs2) & 0x0000001f);
+
+    //shift right arithmetically rs1 by the extracted 5 LSB of rs2
+    uint32_t val = (uint32_t) regs.get(rs1) >> shift;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 >> (rs2%XLEN), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "srl");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        //                         rd        =                (rs1                   >>     shift      =            val
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " >> " << shift << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the bitwise operation
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;    
+}
+
+
+/**
+ * @brief Method to execute the mul instruction.
+ * 
+ * @param insn RV32M instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_mul(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the signed register source operands
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //multiply rs1 by rs2 and keep the lower 32 bits
+    uint32_t val = (uint32_t)s_rs1 * (uint32_t)s_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 * rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "mul");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " * " << to_hex0x32(s_rs2) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the lower 32 bits of rs1 * rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the mulh instruction.
+ * 
+ * @param insn RV32M instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_mulh(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the signed register source operands
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //multiply signed rs1 by signed rs2 and keep the upper 32 bits
+    uint32_t val = ((int64_t)s_rs1 * (int64_t)s_rs2) >> 32;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 * rs2) >> XLEN, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "mulh");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "(" << to_hex0x32(s_rs1) << " * " << to_hex0x32(s_rs2) << ") >> 32" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the upper 32 bits of the signed product of rs1 and rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the mulhsu instruction.
+ * 
+ * @param insn RV32M instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_mulhsu(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the signed register source operands
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //multiply signed rs1 by unsigned rs2 and keep the upper 32 bits
+    uint32_t val = ((int64_t)s_rs1 * (int64_t)(uint32_t)s_rs2) >> 32;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 * rs2) >> XLEN, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "mulhsu");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "(" << to_hex0x32(s_rs1) << " * " << to_hex0x32(s_rs2) << ") >> 32" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the upper 32 bits of the product of signed rs1 and unsigned rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the mulhu instruction.
+ * 
+ * @param insn RV32M instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_mulhu(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the signed register source operands
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //multiply unsigned rs1 by unsigned rs2 and keep the upper 32 bits
+    uint32_t val = ((uint64_t)(uint32_t)s_rs1 * (uint32_t)s_rs2) >> 32;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 * rs2) >> XLEN, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "mulhu");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "(" << to_hex0x32(s_rs1) << " * " << to_hex0x32(s_rs2) << ") >> 32" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the upper 32 bits of the unsigned product of rs1 and rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the div instruction.
+ * 
+ * @param insn RV32M instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_div(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the signed register source operands
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //divide signed rs1 by signed rs2. Division by zero gives -1 and the
+    //overflow case (-2^31 / -1) gives -2^31 as required by the spec
+    int32_t val;
+    if (s_rs2 == 0)
+    {
+        val = -1;
+    }
+    else if (s_rs1 == INT32_MIN && s_rs2 == -1)
+    {
+        val = INT32_MIN;
+    }
+    else
+    {
+        val = s_rs1 / s_rs2;
+    }
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 / rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "div");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " / " << to_hex0x32(s_rs2) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the signed quotient of rs1 / rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the divu instruction.
+ * 
+ * @param insn RV32M instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_divu(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the signed register source operands
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //divide unsigned rs1 by unsigned rs2. Division by zero gives 2^32-1
+    uint32_t val = (s_rs2 == 0) ? 0xffffffff : (uint32_t)s_rs1 / (uint32_t)s_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 / rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "divu");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " /U " << to_hex0x32(s_rs2) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the unsigned quotient of rs1 / rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the rem instruction.
+ * 
+ * @param insn RV32M instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_rem(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the signed register source operands
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //remainder of signed rs1 / signed rs2. Division by zero gives rs1 and
+    //the overflow case (-2^31 % -1) gives 0 as required by the spec
+    int32_t val;
+    if (s_rs2 == 0)
+    {
+        val = s_rs1;
+    }
+    else if (s_rs1 == INT32_MIN && s_rs2 == -1)
+    {
+        val = 0;
+    }
+    else
+    {
+        val = s_rs1 % s_rs2;
+    }
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 % rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "rem");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " % " << to_hex0x32(s_rs2) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the signed remainder of rs1 / rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the remu instruction.
+ * 
+ * @param insn RV32M instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_remu(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the signed register source operands
+    int32_t s_rs1 = regs.get(rs1);
+    int32_t s_rs2 = regs.get(rs2);
+
+    //remainder of unsigned rs1 / unsigned rs2. Division by zero gives rs1
+    uint32_t val = (s_rs2 == 0) ? (uint32_t)s_rs1 : (uint32_t)s_rs1 % (uint32_t)s_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 % rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "remu");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " %U " << to_hex0x32(s_rs2) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the unsigned remainder of rs1 / rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+
+/**
+ * @brief Method to execute the sh1add instruction.
+ * 
+ * @param insn Zba instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_sh1add(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate rs2 plus rs1 shifted left by 1
+    uint32_t val = (u_rs1 << 1) + u_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 << 1) + rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "sh1add");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "(" << to_hex0x32(u_rs1) << " << 1) + " << to_hex0x32(u_rs2) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs2 plus rs1 shifted left by 1
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the sh2add instruction.
+ * 
+ * @param insn Zba instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_sh2add(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate rs2 plus rs1 shifted left by 2
+    uint32_t val = (u_rs1 << 2) + u_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 << 2) + rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "sh2add");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "(" << to_hex0x32(u_rs1) << " << 2) + " << to_hex0x32(u_rs2) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs2 plus rs1 shifted left by 2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the sh3add instruction.
+ * 
+ * @param insn Zba instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_sh3add(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate rs2 plus rs1 shifted left by 3
+    uint32_t val = (u_rs1 << 3) + u_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 << 3) + rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "sh3add");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "(" << to_hex0x32(u_rs1) << " << 3) + " << to_hex0x32(u_rs2) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs2 plus rs1 shifted left by 3
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the andn instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_andn(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate rs1 AND the complement of rs2
+    uint32_t val = u_rs1 & ~u_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 & ~rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "andn");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " & ~" << to_hex0x32(u_rs2) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 AND the complement of rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the orn instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_orn(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate rs1 OR the complement of rs2
+    uint32_t val = u_rs1 | ~u_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 | ~rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "orn");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " | ~" << to_hex0x32(u_rs2) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 OR the complement of rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the xnor instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_xnor(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate the complement of rs1 XOR rs2
+    uint32_t val = ~(u_rs1 ^ u_rs2);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← ~(rs1 ^ rs2), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "xnor");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "~(" << to_hex0x32(u_rs1) << " ^ " << to_hex0x32(u_rs2) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the complement of rs1 XOR rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the min instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_min(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate the signed minimum of rs1 and rs2
+    uint32_t val = ((int32_t)u_rs1 < (int32_t)u_rs2) ? u_rs1 : u_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← min(rs1, rs2), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "min");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "min(" << to_hex0x32(u_rs1) << ", " << to_hex0x32(u_rs2) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the signed minimum of rs1 and rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the minu instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_minu(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate the unsigned minimum of rs1 and rs2
+    uint32_t val = (u_rs1 < u_rs2) ? u_rs1 : u_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← minu(rs1, rs2), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "minu");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "minu(" << to_hex0x32(u_rs1) << ", " << to_hex0x32(u_rs2) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the unsigned minimum of rs1 and rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the max instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_max(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate the signed maximum of rs1 and rs2
+    uint32_t val = ((int32_t)u_rs1 > (int32_t)u_rs2) ? u_rs1 : u_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← max(rs1, rs2), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "max");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "max(" << to_hex0x32(u_rs1) << ", " << to_hex0x32(u_rs2) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the signed maximum of rs1 and rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the maxu instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_maxu(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate the unsigned maximum of rs1 and rs2
+    uint32_t val = (u_rs1 > u_rs2) ? u_rs1 : u_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← maxu(rs1, rs2), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "maxu");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "maxu(" << to_hex0x32(u_rs1) << ", " << to_hex0x32(u_rs2) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the unsigned maximum of rs1 and rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the rol instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_rol(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate rs1 rotated left by rs2
+    uint32_t shamt = u_rs2 & 0x0000001f;
+    uint32_t val = (u_rs1 << shamt) | (u_rs1 >> ((32 - shamt) & 0x0000001f));
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 rol (rs2%XLEN), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "rol");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " rol " << shamt << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 rotated left by rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the ror instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_ror(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate rs1 rotated right by rs2
+    uint32_t shamt = u_rs2 & 0x0000001f;
+    uint32_t val = (u_rs1 >> shamt) | (u_rs1 << ((32 - shamt) & 0x0000001f));
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 ror (rs2%XLEN), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "ror");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " ror " << shamt << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 rotated right by rs2
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the rori instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_rori(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //extract shamt_i value from imm_i
+    uint32_t shamt = get_imm_i(insn) & 0x0000001f;
+
+    //calculate rs1 rotated right by shamt
+    uint32_t val = (u_rs1 >> shamt) | (u_rs1 << ((32 - shamt) & 0x0000001f));
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 ror shamt, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "rori", shamt);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " ror " << shamt << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 rotated right by shamt
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the clz instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_clz(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //calculate the number of leading zero bits in rs1
+    uint32_t val = (u_rs1 == 0) ? 32 : __builtin_clz(u_rs1);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← clz(rs1), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype_unary(insn, "clz");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "clz(" << to_hex0x32(u_rs1) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the number of leading zero bits in rs1
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the ctz instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_ctz(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //calculate the number of trailing zero bits in rs1
+    uint32_t val = (u_rs1 == 0) ? 32 : __builtin_ctz(u_rs1);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← ctz(rs1), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype_unary(insn, "ctz");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "ctz(" << to_hex0x32(u_rs1) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the number of trailing zero bits in rs1
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the cpop instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_cpop(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //calculate the number of set bits in rs1
+    uint32_t val = __builtin_popcount(u_rs1);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← cpop(rs1), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype_unary(insn, "cpop");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "cpop(" << to_hex0x32(u_rs1) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the number of set bits in rs1
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the sext.b instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_sext_b(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //calculate the sign extended low byte of rs1
+    uint32_t val = (int32_t)(int8_t)u_rs1;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← sx(rs1[7:0]), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype_unary(insn, "sext.b");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "sx(" << to_hex0x32(u_rs1 & 0x000000ff) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the sign extended low byte of rs1
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the sext.h instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_sext_h(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //calculate the sign extended low halfword of rs1
+    uint32_t val = (int32_t)(int16_t)u_rs1;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← sx(rs1[15:0]), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype_unary(insn, "sext.h");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "sx(" << to_hex0x32(u_rs1 & 0x0000ffff) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the sign extended low halfword of rs1
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the zext.h instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_zext_h(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //calculate the zero extended low halfword of rs1
+    uint32_t val = u_rs1 & 0x0000ffff;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← zx(rs1[15:0]), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype_unary(insn, "zext.h");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "zx(" << to_hex0x32(u_rs1 & 0x0000ffff) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the zero extended low halfword of rs1
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the orc.b instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_orc_b(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //calculate rs1 with every nonzero byte set to 0xff
+    uint32_t val = 0;
+    for (uint32_t byte = 0; byte < 32; byte += 8)
+    {
+        val |= ((u_rs1 >> byte) & 0x000000ff) ? (0x000000ffu << byte) : 0;
+    }
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← orc.b(rs1), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype_unary(insn, "orc.b");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "orc.b(" << to_hex0x32(u_rs1) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 with every nonzero byte set to 0xff
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the rev8 instruction.
+ * 
+ * @param insn Zbb instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_rev8(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //calculate rs1 with its bytes reversed
+    uint32_t val = __builtin_bswap32(u_rs1);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rev8(rs1), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype_unary(insn, "rev8");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "rev8(" << to_hex0x32(u_rs1) << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 with its bytes reversed
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the bclr instruction.
+ * 
+ * @param insn Zbs instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_bclr(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate rs1 with bit rs2 cleared
+    uint32_t shamt = u_rs2 & 0x0000001f;
+    uint32_t val = u_rs1 & ~(1u << shamt);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 & ~(1 << (rs2%XLEN)), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "bclr");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " & ~(1 << " << shamt << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 with bit rs2 cleared
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the bclri instruction.
+ * 
+ * @param insn Zbs instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_bclri(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //extract shamt_i value from imm_i
+    uint32_t shamt = get_imm_i(insn) & 0x0000001f;
+
+    //calculate rs1 with bit shamt cleared
+    uint32_t val = u_rs1 & ~(1u << shamt);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 & ~(1 << shamt), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "bclri", shamt);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " & ~(1 << " << shamt << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 with bit shamt cleared
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the bext instruction.
+ * 
+ * @param insn Zbs instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_bext(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate bit rs2 of rs1
+    uint32_t shamt = u_rs2 & 0x0000001f;
+    uint32_t val = (u_rs1 >> shamt) & 1;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 >> (rs2%XLEN)) & 1, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "bext");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "(" << to_hex0x32(u_rs1) << " >> " << shamt << ") & 1" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to bit rs2 of rs1
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the bexti instruction.
+ * 
+ * @param insn Zbs instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_bexti(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //extract shamt_i value from imm_i
+    uint32_t shamt = get_imm_i(insn) & 0x0000001f;
+
+    //calculate bit shamt of rs1
+    uint32_t val = (u_rs1 >> shamt) & 1;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 >> shamt) & 1, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "bexti", shamt);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << "(" << to_hex0x32(u_rs1) << " >> " << shamt << ") & 1" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to bit shamt of rs1
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the binv instruction.
+ * 
+ * @param insn Zbs instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_binv(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate rs1 with bit rs2 inverted
+    uint32_t shamt = u_rs2 & 0x0000001f;
+    uint32_t val = u_rs1 ^ (1u << shamt);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 ^ (1 << (rs2%XLEN)), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "binv");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " ^ (1 << " << shamt << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 with bit rs2 inverted
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the binvi instruction.
+ * 
+ * @param insn Zbs instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_binvi(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //extract shamt_i value from imm_i
+    uint32_t shamt = get_imm_i(insn) & 0x0000001f;
+
+    //calculate rs1 with bit shamt inverted
+    uint32_t val = u_rs1 ^ (1u << shamt);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 ^ (1 << shamt), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "binvi", shamt);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " ^ (1 << " << shamt << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 with bit shamt inverted
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the bset instruction.
+ * 
+ * @param insn Zbs instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_bset(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the unsigned register source operands
+    uint32_t u_rs1 = regs.get(rs1);
+    uint32_t u_rs2 = regs.get(rs2);
+
+    //calculate rs1 with bit rs2 set
+    uint32_t shamt = u_rs2 & 0x0000001f;
+    uint32_t val = u_rs1 | (1u << shamt);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 | (1 << (rs2%XLEN)), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_rtype(insn, "bset");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " | (1 << " << shamt << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 with bit rs2 set
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the bseti instruction.
+ * 
+ * @param insn Zbs instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_bseti(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //extract shamt_i value from imm_i
+    uint32_t shamt = get_imm_i(insn) & 0x0000001f;
+
+    //calculate rs1 with bit shamt set
+    uint32_t val = u_rs1 | (1u << shamt);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 | (1 << shamt), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_itype_alu(insn, "bseti", shamt);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " | (1 << " << shamt << ")" << " = " << to_hex0x32(val);
+    }
+
+    //set rd to rs1 with bit shamt set
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the flw instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_flw(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //calculate the sum of rs1 and the immediate value
+    uint32_t sum = regs.get(rs1) + imm_i;
+
+    //fetch the 32 bit value from memory, a page fault traps and leaves rd alone
+    uint32_t word;
+    if (!read_mem(sum, 4, word))
+    {
+        return;
+    }
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← m32(rs1+imm i), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_load(insn, "flw");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = m32(" << to_hex0x32(regs.get(rs1)) << " + " << to_hex0x32(imm_i) << ") = " << to_hex0x32(word);
+    }
+
+    //set rd to the NaN-boxed single precision value fetched from memory
+    fregs.set_bits_s(rd, word);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fsw instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fsw(uint32_t insn, std::ostream* pos)
+{
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for s-type instruction
+    int32_t imm_s = get_imm_s(insn);
+
+    //calculate the sum of rs1 and the immediate value
+    uint32_t sum = regs.get(rs1) + imm_s;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (m32(rs1+imm s) ← rs2[31:0], pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_stype(insn, "fsw");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << "m32(" << to_hex0x32(regs.get(rs1)) << " + " << to_hex0x32(imm_s) << ") = " << to_hex0x32(fregs.get(rs2) & 0xffffffff);
+    }
+
+    //set the word of memory to the low 32 bits of rs2
+    if (!write_mem(sum, 4, fregs.get(rs2) & 0xffffffff))
+    {
+        return;
+    }
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fmadd.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fmadd_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get third source operand
+    uint32_t rs3 = get_rs3(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+    float f_rs3 = fregs.get_s(rs3);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //fused multiply-add with a single rounding on the host FPU
+    float val = std::fma(f_rs1, f_rs2, f_rs3);
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 * rs2 + rs3, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_r4type(insn, "fmadd.s");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " * " << f_rs2 << " + " << f_rs3 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fmsub.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fmsub_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get third source operand
+    uint32_t rs3 = get_rs3(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+    float f_rs3 = fregs.get_s(rs3);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //fused multiply-add with a single rounding on the host FPU
+    float val = std::fma(f_rs1, f_rs2, -f_rs3);
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 * rs2 - rs3, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_r4type(insn, "fmsub.s");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " * " << f_rs2 << " - " << f_rs3 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fnmsub.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fnmsub_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get third source operand
+    uint32_t rs3 = get_rs3(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+    float f_rs3 = fregs.get_s(rs3);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //fused multiply-add with a single rounding on the host FPU
+    float val = std::fma(-f_rs1, f_rs2, f_rs3);
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← -(rs1 * rs2) + rs3, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_r4type(insn, "fnmsub.s");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = -(" << f_rs1 << " * " << f_rs2 << ") + " << f_rs3 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fnmadd.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fnmadd_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get third source operand
+    uint32_t rs3 = get_rs3(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+    float f_rs3 = fregs.get_s(rs3);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //fused multiply-add with a single rounding on the host FPU
+    float val = std::fma(-f_rs1, f_rs2, -f_rs3);
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← -(rs1 * rs2) - rs3, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_r4type(insn, "fnmadd.s");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = -(" << f_rs1 << " * " << f_rs2 << ") - " << f_rs3 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fadd.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fadd_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //add rs1 and rs2 on the host FPU and accumulate the exception flags
+    float val = f_rs1 + f_rs2;
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 + rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fadd.s", true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " + " << f_rs2 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fsub.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fsub_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //subtract rs2 from rs1 on the host FPU and accumulate the exception flags
+    float val = f_rs1 - f_rs2;
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 - rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fsub.s", true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " - " << f_rs2 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fmul.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fmul_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //multiply rs1 by rs2 on the host FPU and accumulate the exception flags
+    float val = f_rs1 * f_rs2;
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 * rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fmul.s", true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " * " << f_rs2 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fdiv.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fdiv_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //divide rs1 by rs2 on the host FPU and accumulate the exception flags
+    float val = f_rs1 / f_rs2;
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 / rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fdiv.s", true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " / " << f_rs2 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fsqrt.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fsqrt_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the single precision source operand
+    float f_rs1 = fregs.get_s(rs1);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //calculate the square root on the host FPU
+    float val = std::sqrt(f_rs1);
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← sqrt(rs1), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_cvt(insn, "fsqrt.s", 'f', 'f', true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = sqrt(" << f_rs1 << ") = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fsgnj.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fsgnj_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the bits of the single precision source operands
+    uint32_t b_rs1 = fregs.get_bits_s(rs1);
+    uint32_t b_rs2 = fregs.get_bits_s(rs2);
+    uint32_t sign = 0x80000000;
+
+    //take the magnitude of rs1 and the sign of rs2
+    uint32_t val = (b_rs1 & ~sign) | (b_rs2 & sign);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← {sign of rs2, rs1[30:0]}, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fsgnj.s", false);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the result
+    fregs.set_bits_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fsgnjn.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fsgnjn_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the bits of the single precision source operands
+    uint32_t b_rs1 = fregs.get_bits_s(rs1);
+    uint32_t b_rs2 = fregs.get_bits_s(rs2);
+    uint32_t sign = 0x80000000;
+
+    //take the magnitude of rs1 and the opposite of the sign of rs2
+    uint32_t val = (b_rs1 & ~sign) | (~b_rs2 & sign);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← {opposite of sign of rs2, rs1[30:0]}, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fsgnjn.s", false);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the result
+    fregs.set_bits_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fsgnjx.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fsgnjx_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the bits of the single precision source operands
+    uint32_t b_rs1 = fregs.get_bits_s(rs1);
+    uint32_t b_rs2 = fregs.get_bits_s(rs2);
+    uint32_t sign = 0x80000000;
+
+    //take the magnitude of rs1 and the sign of rs1 XOR the sign of rs2
+    uint32_t val = (b_rs1 & ~sign) | ((b_rs1 ^ b_rs2) & sign);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← {sign of rs1 XOR sign of rs2, rs1[30:0]}, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fsgnjx.s", false);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the result
+    fregs.set_bits_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fmin.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fmin_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+
+    //a signaling NaN input raises the invalid flag
+    if (fregisterfile::is_snan_s(fregs.get_bits_s(rs1)) || fregisterfile::is_snan_s(fregs.get_bits_s(rs2)))
+    {
+        fcsr |= fflags_nv;
+    }
+
+    //a NaN operand gives the other operand, two NaNs give the canonical NaN
+    //and -0.0 is treated as less than +0.0
+    float val;
+    if (std::isnan(f_rs1))
+        val = f_rs2;
+    else if (std::isnan(f_rs2))
+        val = f_rs1;
+    else if (f_rs1 == f_rs2)
+        val = std::signbit(f_rs1) ? f_rs1 : f_rs2;
+    else
+        val = (f_rs1 < f_rs2) ? f_rs1 : f_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← min(rs1, rs2), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fmin.s", false);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = min(" << f_rs1 << ", " << f_rs2 << ") = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fmax.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fmax_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+
+    //a signaling NaN input raises the invalid flag
+    if (fregisterfile::is_snan_s(fregs.get_bits_s(rs1)) || fregisterfile::is_snan_s(fregs.get_bits_s(rs2)))
+    {
+        fcsr |= fflags_nv;
+    }
+
+    //a NaN operand gives the other operand, two NaNs give the canonical NaN
+    //and -0.0 is treated as less than +0.0
+    float val;
+    if (std::isnan(f_rs1))
+        val = f_rs2;
+    else if (std::isnan(f_rs2))
+        val = f_rs1;
+    else if (f_rs1 == f_rs2)
+        val = std::signbit(f_rs1) ? f_rs2 : f_rs1;
+    else
+        val = (f_rs1 > f_rs2) ? f_rs1 : f_rs2;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← max(rs1, rs2), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fmax.s", false);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = max(" << f_rs1 << ", " << f_rs2 << ") = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the feq.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_feq_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+
+    //feq is a quiet comparison, only a signaling NaN raises the invalid flag
+    if (fregisterfile::is_snan_s(fregs.get_bits_s(rs1)) || fregisterfile::is_snan_s(fregs.get_bits_s(rs2)))
+    {
+        fcsr |= fflags_nv;
+    }
+
+    //compare the operands, any comparison with a NaN is false
+    uint32_t val = (f_rs1 == f_rs2) ? 1 : 0;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 == rs2) ? 1 : 0, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_compare(insn, "feq.s");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = (" << f_rs1 << " == " << f_rs2 << ") ? 1 : 0 = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the comparison
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the flt.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_flt_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+
+    //flt is a signaling comparison, any NaN raises the invalid flag
+    if (std::isnan(f_rs1) || std::isnan(f_rs2))
+    {
+        fcsr |= fflags_nv;
+    }
+
+    //compare the operands, any comparison with a NaN is false
+    uint32_t val = (f_rs1 < f_rs2) ? 1 : 0;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 < rs2) ? 1 : 0, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_compare(insn, "flt.s");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = (" << f_rs1 << " < " << f_rs2 << ") ? 1 : 0 = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the comparison
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fle.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fle_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the single precision source operands
+    float f_rs1 = fregs.get_s(rs1);
+    float f_rs2 = fregs.get_s(rs2);
+
+    //fle is a signaling comparison, any NaN raises the invalid flag
+    if (std::isnan(f_rs1) || std::isnan(f_rs2))
+    {
+        fcsr |= fflags_nv;
+    }
+
+    //compare the operands, any comparison with a NaN is false
+    uint32_t val = (f_rs1 <= f_rs2) ? 1 : 0;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← (rs1 <= rs2) ? 1 : 0, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_compare(insn, "fle.s");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = (" << f_rs1 << " <= " << f_rs2 << ") ? 1 : 0 = " << to_hex0x32(val);
+    }
+
+    //set rd to the result of the comparison
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fclass.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fclass_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the single precision source operand
+    float f_rs1 = fregs.get_s(rs1);
+
+    //set the single bit that classifies rs1
+    uint32_t val = fp_classify(std::fpclassify(f_rs1), std::signbit(f_rs1), fregisterfile::is_snan_s(fregs.get_bits_s(rs1)));
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← class(rs1), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_cvt(insn, "fclass.s", 'x', 'f', false);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = class(" << f_rs1 << ") = " << to_hex0x32(val);
+    }
+
+    //set rd to the classification mask
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fcvt.w.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fcvt_w_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the single precision source operand
+    float f_rs1 = fregs.get_s(rs1);
+
+    //remember the flags so that an invalid conversion raises only the invalid flag
+    uint32_t flags = fcsr;
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //round to an integer in the selected rounding mode, rint() cannot round
+    //ties away from zero so rmm uses round()
+    double r = (fp_rm(insn) == rm_rmm) ? std::round((double)f_rs1) : std::rint((double)f_rs1);
+    fp_end();
+
+    //out of range values and NaNs saturate and raise the invalid flag
+    uint32_t val;
+    if (std::isnan(r))
+    {
+        val = 0x7fffffff;
+        fcsr = flags | fflags_nv;
+    }
+    else if (r < -2147483648.0)
+    {
+        val = 0x80000000;
+        fcsr = flags | fflags_nv;
+    }
+    else if (r >= 2147483648.0)
+    {
+        val = 0x7fffffff;
+        fcsr = flags | fflags_nv;
+    }
+    else
+    {
+        val = (uint32_t)(int32_t)r;
+    }
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← s32(rs1), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_cvt(insn, "fcvt.w.s", 'x', 'f', true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = s32(" << f_rs1 << ") = " << to_hex0x32(val);
+    }
+
+    //set rd to the converted integer
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fcvt.wu.s instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fcvt_wu_s(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the single precision source operand
+    float f_rs1 = fregs.get_s(rs1);
+
+    //remember the flags so that an invalid conversion raises only the invalid flag
+    uint32_t flags = fcsr;
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //round to an integer in the selected rounding mode, rint() cannot round
+    //ties away from zero so rmm uses round()
+    double r = (fp_rm(insn) == rm_rmm) ? std::round((double)f_rs1) : std::rint((double)f_rs1);
+    fp_end();
+
+    //out of range values and NaNs saturate and raise the invalid flag
+    uint32_t val;
+    if (std::isnan(r))
+    {
+        val = 0xffffffff;
+        fcsr = flags | fflags_nv;
+    }
+    else if (r < 0.0)
+    {
+        val = 0;
+        fcsr = flags | fflags_nv;
+    }
+    else if (r >= 4294967296.0)
+    {
+        val = 0xffffffff;
+        fcsr = flags | fflags_nv;
+    }
+    else
+    {
+        val = (uint32_t)r;
+    }
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← u32(rs1), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_cvt(insn, "fcvt.wu.s", 'x', 'f', true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = u32(" << f_rs1 << ") = " << to_hex0x32(val);
+    }
+
+    //set rd to the converted integer
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fcvt.s.w instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fcvt_s_w(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the signed register source operand
+    int32_t s_rs1 = regs.get(rs1);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //convert on the host FPU, which rounds in the selected mode
+    float val = (float)s_rs1;
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← float(rs1), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_cvt(insn, "fcvt.s.w", 'f', 'x', true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << to_hex0x32(s_rs1) << " = " << val;
+    }
+
+    //set rd to the converted value
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fcvt.s.wu instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fcvt_s_wu(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the unsigned register source operand
+    uint32_t u_rs1 = regs.get(rs1);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //convert on the host FPU, which rounds in the selected mode
+    float val = (float)u_rs1;
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← float(rs1), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_cvt(insn, "fcvt.s.wu", 'f', 'x', true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << to_hex0x32(u_rs1) << " = " << val;
+    }
+
+    //set rd to the converted value
+    fregs.set_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fmv.x.w instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fmv_x_w(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the low 32 bits of rs1 without checking the NaN-boxing
+    uint32_t val = fregs.get(rs1) & 0xffffffff;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1[31:0], pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_cvt(insn, "fmv.x.w", 'x', 'f', false);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the bits of the single precision value
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fmv.w.x instruction.
+ * 
+ * @param insn RV32F instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fmv_w_x(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get the bits to move
+    uint32_t val = regs.get(rs1);
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_cvt(insn, "fmv.w.x", 'f', 'x', false);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << to_hex0x32(val);
+    }
+
+    //set rd to the NaN-boxed bits
+    fregs.set_bits_s(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fld instruction.
+ * 
+ * @param insn RV32D instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fld(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get immediate value for i-type instruction
+    int32_t imm_i = get_imm_i(insn);
+
+    //calculate the sum of rs1 and the immediate value
+    uint32_t sum = regs.get(rs1) + imm_i;
+
+    //fetch the 64 bit little endian value from memory, a page fault traps
+    //and leaves rd alone
+    uint32_t low, high;
+    if (!read_mem(sum, 4, low) || !read_mem(sum + 4, 4, high))
+    {
+        return;
+    }
+    uint64_t dword = low | (uint64_t)high << 32;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← m64(rs1+imm i), pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_load(insn, "fld");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = m64(" << to_hex0x32(regs.get(rs1)) << " + " << to_hex0x32(imm_i) << ") = " << to_hex32(dword >> 32) << to_hex32(dword & 0xffffffff);
+    }
+
+    //set rd to the double precision value fetched from memory
+    fregs.set(rd, dword);
 
-    //increment the pc register (pc <- pc + 4)
-    pc += 4;
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the jal instruction.
+ * @brief Method to execute the fsd instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */       
-// void rv32i_hart::exec_jal(uint32_t addr, uint32_t insn, std::ostream* pos)
-void rv32i_hart::exec_jal(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fsd(uint32_t insn, std::ostream* pos)
+{
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get immediate value for s-type instruction
+    int32_t imm_s = get_imm_s(insn);
+
+    //calculate the sum of rs1 and the immediate value
+    uint32_t sum = regs.get(rs1) + imm_s;
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (m64(rs1+imm s) ← rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_stype(insn, "fsd");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << "m64(" << to_hex0x32(regs.get(rs1)) << " + " << to_hex0x32(imm_s) << ") = " << to_hex32(fregs.get(rs2) >> 32) << to_hex32(fregs.get(rs2) & 0xffffffff);
+    }
+
+    //set the double word of memory to rs2, low word first
+    uint64_t dword = fregs.get(rs2);
+    if (!write_mem(sum, 4, dword & 0xffffffff) || !write_mem(sum + 4, 4, dword >> 32))
+    {
+        return;
+    }
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fmadd.d instruction.
+ * 
+ * @param insn RV32D instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fmadd_d(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
 
-    //get immediate value for j-type instruction
-    int32_t imm_j = get_imm_j(insn);
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
 
-    //calculate address of the next instruction
-    int32_t next_insn = pc + 0x00000004;
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
 
-    //calculate the target address
-    int32_t target_addr = pc + imm_j;
+    //get third source operand
+    uint32_t rs3 = get_rs3(insn);
+
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
+    double f_rs3 = fregs.get_d(rs3);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
+    //fused multiply-add with a single rounding on the host FPU
+    double val = std::fma(f_rs1, f_rs2, f_rs3);
+    fp_end();
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← pc+4, pc ← pc+imm j)
+    //involved before and after the instruction simulation (rd ← rs1 * rs2 + rs3, pc ← pc+4)
     if(pos)
     {
-        std::string s = render_jal(pc, insn);
+        std::string s = render_fp_r4type(insn, "fmadd.d");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                  rd              =           next instruction      , pc =                pc          +           imm_j             =             target_addr
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(next_insn) << ",  pc = " << to_hex0x32(pc) << " + " << to_hex0x32(imm_j) << " = " << to_hex0x32(target_addr);
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " * " << f_rs2 << " + " << f_rs3 << " = " << val;
     }
 
-    //set register rd to the address of the next instruction (rd ← pc+4)
-    regs.set(rd, next_insn);
+    //set rd to the result
+    fregs.set_d(rd, val);
 
-    //jump to target address (pc ← pc+imm j)
-    pc = target_addr;
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fmsub.d instruction.
+ * 
+ * @param insn RV32D instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fmsub_d(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get third source operand
+    uint32_t rs3 = get_rs3(insn);
+
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
+    double f_rs3 = fregs.get_d(rs3);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //fused multiply-add with a single rounding on the host FPU
+    double val = std::fma(f_rs1, f_rs2, -f_rs3);
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 * rs2 - rs3, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_r4type(insn, "fmsub.d");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " * " << f_rs2 << " - " << f_rs3 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_d(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fnmsub.d instruction.
+ * 
+ * @param insn RV32D instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fnmsub_d(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get third source operand
+    uint32_t rs3 = get_rs3(insn);
+
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
+    double f_rs3 = fregs.get_d(rs3);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //fused multiply-add with a single rounding on the host FPU
+    double val = std::fma(-f_rs1, f_rs2, f_rs3);
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← -(rs1 * rs2) + rs3, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_r4type(insn, "fnmsub.d");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = -(" << f_rs1 << " * " << f_rs2 << ") + " << f_rs3 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_d(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fnmadd.d instruction.
+ * 
+ * @param insn RV32D instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fnmadd_d(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get third source operand
+    uint32_t rs3 = get_rs3(insn);
+
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
+    double f_rs3 = fregs.get_d(rs3);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //fused multiply-add with a single rounding on the host FPU
+    double val = std::fma(-f_rs1, f_rs2, -f_rs3);
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← -(rs1 * rs2) - rs3, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_r4type(insn, "fnmadd.d");
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = -(" << f_rs1 << " * " << f_rs2 << ") - " << f_rs3 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_d(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fadd.d instruction.
+ * 
+ * @param insn RV32D instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fadd_d(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //add rs1 and rs2 on the host FPU and accumulate the exception flags
+    double val = f_rs1 + f_rs2;
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 + rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fadd.d", true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " + " << f_rs2 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_d(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fsub.d instruction.
+ * 
+ * @param insn RV32D instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fsub_d(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //subtract rs2 from rs1 on the host FPU and accumulate the exception flags
+    double val = f_rs1 - f_rs2;
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 - rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fsub.d", true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " - " << f_rs2 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_d(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
+
+/**
+ * @brief Method to execute the fmul.d instruction.
+ * 
+ * @param insn RV32D instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_fmul_d(uint32_t insn, std::ostream* pos)
+{
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get first source operand
+    uint32_t rs1 = get_rs1(insn);
+
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
+
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
+
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
+
+    //multiply rs1 by rs2 on the host FPU and accumulate the exception flags
+    double val = f_rs1 * f_rs2;
+    fp_end();
+
+    //render the simulation summary comment that shows the values of all the registers 
+    //involved before and after the instruction simulation (rd ← rs1 * rs2, pc ← pc+4)
+    if(pos)
+    {
+        std::string s = render_fp_rtype(insn, "fmul.d", true);
+        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " * " << f_rs2 << " = " << val;
+    }
+
+    //set rd to the result
+    fregs.set_d(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the jalr instruction.
+ * @brief Method to execute the fdiv.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */    
-void rv32i_hart::exec_jalr(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fdiv_d(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -388,281 +6750,331 @@ void rv32i_hart::exec_jalr(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
 
-    //calculate address of the next instruction
-    int32_t next_insn = pc + 0x00000004;
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
 
-    //get the signed register source operand
-    int32_t s_rs1 = regs.get(rs1);
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
-    //calculate the target address and set the LSB to zero
-    int32_t target_addr = (imm_i + s_rs1) & 0xfffffffe;
+    //divide rs1 by rs2 on the host FPU and accumulate the exception flags
+    double val = f_rs1 / f_rs2;
+    fp_end();
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← pc+4, pc ← (rs1+imm i)&~1)
+    //involved before and after the instruction simulation (rd ← rs1 / rs2, pc ← pc+4)
     if(pos)
     {
-        std::string s = render_jalr(insn);
+        std::string s = render_fp_rtype(insn, "fdiv.d", true);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                  rd               =                  pc+4          ,  pc = (              imm_i         +                   rs1    ) & 0xfffffffe =             target address
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(next_insn) << ",  pc = (" << to_hex0x32(imm_i) << " + " << to_hex0x32(s_rs1) << ") & 0xfffffffe = " << to_hex0x32(target_addr);
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " / " << f_rs2 << " = " << val;
     }
 
-    //set register rd to the address of the next instruction (rd ← pc+4)
-    regs.set(rd, next_insn);
+    //set rd to the result
+    fregs.set_d(rd, val);
 
-    //jump to target address ((rs1+imm i)&~1)
-    pc = target_addr;
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the beq instruction.
+ * @brief Method to execute the fsqrt.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_beq(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_fsqrt_d(uint32_t insn, std::ostream* pos)
 {
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get second source operand
-    uint32_t rs2 = get_rs2(insn);
-
-    //get immediate value for b-type instruction
-    int32_t imm_b = get_imm_b(insn);
-
-    //get signed source operands for calculation
-    int32_t s_rs1 = regs.get(rs1);
-    int32_t s_rs2 = regs.get(rs2);
+    //get the double precision source operand
+    double f_rs1 = fregs.get_d(rs1);
 
-    //set current instruction address
-    uint32_t addr = pc;
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
-    //If rs1 is equal to rs2 then add imm_b to the pc register. Else add 4.
-    pc += ((s_rs1 == s_rs2) ? imm_b : 4);
+    //calculate the square root on the host FPU
+    double val = std::sqrt(f_rs1);
+    fp_end();
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (pc ← pc + ((rs1==rs2) ? imm b : 4))
+    //involved before and after the instruction simulation (rd ← sqrt(rs1), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_btype(addr, insn, "beq");
+        std::string s = render_fp_cvt(insn, "fsqrt.d", 'f', 'f', true);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //           pc +=               (( rs1         ==                  rs2)       ?                  imm_b       : 4) =           pc
-        *pos << "// pc += (" << to_hex0x32(s_rs1) << " == " << to_hex0x32(s_rs2) << " ? " << to_hex0x32(imm_b) << " : 4) = " << to_hex0x32(pc);
+        *pos << "// " << render_freg(rd) << " = sqrt(" << f_rs1 << ") = " << val;
     }
+
+    //set rd to the result
+    fregs.set_d(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the bne instruction.
+ * @brief Method to execute the fsgnj.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_bne(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_fsgnj_d(uint32_t insn, std::ostream* pos)
 {
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
     //get second source operand
     uint32_t rs2 = get_rs2(insn);
 
-    //get immediate value for b-type instruction
-    int32_t imm_b = get_imm_b(insn);
-
-    //get signed source operands for calculation
-    int32_t s_rs1 = regs.get(rs1);
-    int32_t s_rs2 = regs.get(rs2);
-
-    //set current instruction address
-    uint32_t addr = pc;
+    //get the bits of the double precision source operands
+    uint64_t b_rs1 = fregs.get(rs1);
+    uint64_t b_rs2 = fregs.get(rs2);
+    uint64_t sign = 0x8000000000000000;
 
-    //If rs1 is not equal to rs2 then add imm_b to the pc register. Else add 4.
-    pc += ((s_rs1 != s_rs2) ? imm_b : 4);
+    //take the magnitude of rs1 and the sign of rs2
+    uint64_t val = (b_rs1 & ~sign) | (b_rs2 & sign);
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (pc ← pc + ((rs1!=rs2) ? imm b : 4))
+    //involved before and after the instruction simulation (rd ← {sign of rs2, rs1[62:0]}, pc ← pc+4)
     if(pos)
     {
-        std::string s = render_btype(addr, insn, "bne");
+        std::string s = render_fp_rtype(insn, "fsgnj.d", false);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //          pc    +=                (( rs1         !=                 rs2)       ?                  imm_b       : 4) =           pc
-        *pos << "// pc += (" << to_hex0x32(s_rs1) << " != " << to_hex0x32(s_rs2) << " ? " << to_hex0x32(imm_b) << " : 4) = " << to_hex0x32(pc);
+        *pos << "// " << render_freg(rd) << " = " << to_hex32(val >> 32) << to_hex32(val & 0xffffffff);
     }
+
+    //set rd to the result
+    fregs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the blt instruction.
+ * @brief Method to execute the fsgnjn.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */        
-void rv32i_hart::exec_blt(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fsgnjn_d(uint32_t insn, std::ostream* pos)
 {
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
     //get second source operand
     uint32_t rs2 = get_rs2(insn);
 
-    //get immediate value for b-type instruction
-    int32_t imm_b = get_imm_b(insn);
-
-    //get signed source operands for calculation
-    int32_t s_rs1 = regs.get(rs1);
-    int32_t s_rs2 = regs.get(rs2);
-
-    //set current instruction address
-    uint32_t addr = pc;
+    //get the bits of the double precision source operands
+    uint64_t b_rs1 = fregs.get(rs1);
+    uint64_t b_rs2 = fregs.get(rs2);
+    uint64_t sign = 0x8000000000000000;
 
-    //If the signed value in rs1 is less than the signed
-    //value in rs2 then add imm_b to the pc register. Else add 4.
-    pc += ((s_rs1 < s_rs2) ? imm_b : 4);
+    //take the magnitude of rs1 and the opposite of the sign of rs2
+    uint64_t val = (b_rs1 & ~sign) | (~b_rs2 & sign);
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (pc ← pc + ((rs1<rs2) ? imm b : 4))
+    //involved before and after the instruction simulation (rd ← {opposite of sign of rs2, rs1[62:0]}, pc ← pc+4)
     if(pos)
     {
-        std::string s = render_btype(addr, insn, "blt");
+        std::string s = render_fp_rtype(insn, "fsgnjn.d", false);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //          pc +=               (( rs1         <                  rs2)       ?                  imm_b       : 4) =           pc
-        *pos << "// pc += (" << to_hex0x32(s_rs1) << " < " << to_hex0x32(s_rs2) << " ? " << to_hex0x32(imm_b) << " : 4) = " << to_hex0x32(pc);
+        *pos << "// " << render_freg(rd) << " = " << to_hex32(val >> 32) << to_hex32(val & 0xffffffff);
     }
+
+    //set rd to the result
+    fregs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the bge instruction.
+ * @brief Method to execute the fsgnjx.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */                
-void rv32i_hart::exec_bge(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fsgnjx_d(uint32_t insn, std::ostream* pos)
 {
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
     //get second source operand
     uint32_t rs2 = get_rs2(insn);
 
-    //get immediate value for b-type instruction
-    int32_t imm_b = get_imm_b(insn);
-
-    //get signed source operands for calculation
-    int32_t s_rs1 = regs.get(rs1);
-    int32_t s_rs2 = regs.get(rs2);
-
-    //set current instruction address
-    uint32_t addr = pc;
+    //get the bits of the double precision source operands
+    uint64_t b_rs1 = fregs.get(rs1);
+    uint64_t b_rs2 = fregs.get(rs2);
+    uint64_t sign = 0x8000000000000000;
 
-    //If the signed value in rs1 is greater than or equal 
-    //to the signed value in rs2 then add imm_b to the pc register. Else add 4.
-    pc += ((s_rs1 >= s_rs2) ? imm_b : 4);
+    //take the magnitude of rs1 and the sign of rs1 XOR the sign of rs2
+    uint64_t val = (b_rs1 & ~sign) | ((b_rs1 ^ b_rs2) & sign);
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (pc ← pc + ((rs1>=rs2) ? imm b : 4))
+    //involved before and after the instruction simulation (rd ← {sign of rs1 XOR sign of rs2, rs1[62:0]}, pc ← pc+4)
     if(pos)
     {
-        std::string s = render_btype(addr, insn, "bge");
+        std::string s = render_fp_rtype(insn, "fsgnjx.d", false);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //          pc +=               (( rs1         >=                  rs2)       ?                  imm_b       : 4) =           pc
-        *pos << "// pc += (" << to_hex0x32(s_rs1) << " >= " << to_hex0x32(s_rs2) << " ? " << to_hex0x32(imm_b) << " : 4) = " << to_hex0x32(pc);
+        *pos << "// " << render_freg(rd) << " = " << to_hex32(val >> 32) << to_hex32(val & 0xffffffff);
     }
+
+    //set rd to the result
+    fregs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the bltu instruction.
+ * @brief Method to execute the fmin.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */                
-void rv32i_hart::exec_bltu(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fmin_d(uint32_t insn, std::ostream* pos)
 {
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
     //get second source operand
     uint32_t rs2 = get_rs2(insn);
 
-    //get immediate value for b-type instruction
-    int32_t imm_b = get_imm_b(insn);
-
-    //get the unsigned register source operand
-    uint32_t u_rs1 = regs.get(rs1);
-    uint32_t u_rs2 = regs.get(rs2);
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
 
-    //set current instruction address
-    uint32_t addr = pc;
+    //a signaling NaN input raises the invalid flag
+    if (fregisterfile::is_snan_d(fregs.get(rs1)) || fregisterfile::is_snan_d(fregs.get(rs2)))
+    {
+        fcsr |= fflags_nv;
+    }
 
-    //If the unsigned value in rs1 is less than the
-    //unsigned value in rs2 then add imm_b to the pc1795 register. Else add 4.
-    pc += ((u_rs1 < u_rs2) ? imm_b : 4);
+    //a NaN operand gives the other operand, two NaNs give the canonical NaN
+    //and -0.0 is treated as less than +0.0
+    double val;
+    if (std::isnan(f_rs1))
+        val = f_rs2;
+    else if (std::isnan(f_rs2))
+        val = f_rs1;
+    else if (f_rs1 == f_rs2)
+        val = std::signbit(f_rs1) ? f_rs1 : f_rs2;
+    else
+        val = (f_rs1 < f_rs2) ? f_rs1 : f_rs2;
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (pc ← pc + ((rs1<rs2) ? imm b : 4))
+    //involved before and after the instruction simulation (rd ← min(rs1, rs2), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_btype(addr, insn, "bltu");
+        std::string s = render_fp_rtype(insn, "fmin.d", false);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //          pc +=               (( rs1         <U                  rs2)       ?                  imm_b       : 4) =           pc
-        *pos << "// pc += (" << to_hex0x32(u_rs1) << " <U " << to_hex0x32(u_rs2) << " ? " << to_hex0x32(imm_b) << " : 4) = " << to_hex0x32(pc);
+        *pos << "// " << render_freg(rd) << " = min(" << f_rs1 << ", " << f_rs2 << ") = " << val;
     }
+
+    //set rd to the result
+    fregs.set_d(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the bgeu instruction.
+ * @brief Method to execute the fmax.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */   
-void rv32i_hart::exec_bgeu(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fmax_d(uint32_t insn, std::ostream* pos)
 {
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
     //get second source operand
     uint32_t rs2 = get_rs2(insn);
 
-    //get immediate value for b-type instruction
-    int32_t imm_b = get_imm_b(insn);
-
-    //get the unsigned register source operand
-    uint32_t u_rs1 = regs.get(rs1);
-    uint32_t u_rs2 = regs.get(rs2);
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
 
-    //set current instruction address
-    uint32_t addr = pc;
+    //a signaling NaN input raises the invalid flag
+    if (fregisterfile::is_snan_d(fregs.get(rs1)) || fregisterfile::is_snan_d(fregs.get(rs2)))
+    {
+        fcsr |= fflags_nv;
+    }
 
-    //If the unsigned value in rs1 is greater than or equal
-    //to the unsigned value in rs2 then add imm_b to the pc register. Else add 4.
-    pc += ((u_rs1 >= u_rs2) ? imm_b : 4);
+    //a NaN operand gives the other operand, two NaNs give the canonical NaN
+    //and -0.0 is treated as less than +0.0
+    double val;
+    if (std::isnan(f_rs1))
+        val = f_rs2;
+    else if (std::isnan(f_rs2))
+        val = f_rs1;
+    else if (f_rs1 == f_rs2)
+        val = std::signbit(f_rs1) ? f_rs2 : f_rs1;
+    else
+        val = (f_rs1 > f_rs2) ? f_rs1 : f_rs2;
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (pc ← pc + ((rs1>=rs2) ? imm b : 4))
+    //involved before and after the instruction simulation (rd ← max(rs1, rs2), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_btype(addr, insn, "bgeu");
+        std::string s = render_fp_rtype(insn, "fmax.d", false);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //           pc +=               (( rs1         >=U                  rs2)       ?                  imm_b       : 4) =           pc
-        *pos << "// pc += (" << to_hex0x32(u_rs1) << " >=U " << to_hex0x32(u_rs2) << " ? " << to_hex0x32(imm_b) << " : 4) = " << to_hex0x32(pc);
+        *pos << "// " << render_freg(rd) << " = max(" << f_rs1 << ", " << f_rs2 << ") = " << val;
     }
+
+    //set rd to the result
+    fregs.set_d(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the lb instruction.
+ * @brief Method to execute the feq.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */  
-void rv32i_hart::exec_lb(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_feq_d(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -670,44 +7082,46 @@ void rv32i_hart::exec_lb(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
 
-    //get signed source operand
-    int32_t s_rs1 = regs.get(rs1);
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
 
-    //calculate the sum of rs1 and the immediate value
-    int32_t sum = s_rs1 + imm_i;
+    //feq is a quiet comparison, only a signaling NaN raises the invalid flag
+    if (fregisterfile::is_snan_d(fregs.get(rs1)) || fregisterfile::is_snan_d(fregs.get(rs2)))
+    {
+        fcsr |= fflags_nv;
+    }
 
-    //fetch the byte from memory
-    int32_t byte = mem.get8_sx(sum);
+    //compare the operands, any comparison with a NaN is false
+    uint32_t val = (f_rs1 == f_rs2) ? 1 : 0;
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← sx(m8(rs1+imm i)), pc ← pc+4)
+    //involved before and after the instruction simulation (rd ← (rs1 == rs2) ? 1 : 0, pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_load(insn, "lb");
+        std::string s = render_fp_compare(insn, "feq.d");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                          rd      = sx(m8(                rs1          +                 imm_i     )) =          byte
-        *pos << "// " << render_reg(rd) << " = sx(m8(" << to_hex0x32(s_rs1) << " + " << to_hex0x32(imm_i) << ")) = " << to_hex0x32(byte);
+        *pos << "// " << render_reg(rd) << " = (" << f_rs1 << " == " << f_rs2 << ") ? 1 : 0 = " << to_hex0x32(val);
     }
 
-    //set register rd to the value of the sign extended byte fetched from the
-    //memory address given by the sum of rs1 and imm_i
-    regs.set(rd, byte);
+    //set rd to the result of the comparison
+    regs.set(rd, val);
 
-    //increment the pc register (pc <- pc + 4)
-    pc += 4;    
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the lh instruction.
+ * @brief Method to execute the flt.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */         
-void rv32i_hart::exec_lh(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_flt_d(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -715,44 +7129,46 @@ void rv32i_hart::exec_lh(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
 
-    //get signed source operand
-    int32_t s_rs1 = regs.get(rs1);
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
 
-    //calculate the sum of rs1 and the immediate value
-    int32_t sum = s_rs1 + imm_i;
+    //flt is a signaling comparison, any NaN raises the invalid flag
+    if (std::isnan(f_rs1) || std::isnan(f_rs2))
+    {
+        fcsr |= fflags_nv;
+    }
 
-    //fetch the 16 bit value from memory
-    int32_t halfword = mem.get16_sx(sum);
+    //compare the operands, any comparison with a NaN is false
+    uint32_t val = (f_rs1 < f_rs2) ? 1 : 0;
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← sx(m16(rs1+imm i)), pc ← pc+4)
+    //involved before and after the instruction simulation (rd ← (rs1 < rs2) ? 1 : 0, pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_load(insn, "lh");
+        std::string s = render_fp_compare(insn, "flt.d");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                          rd      = sx(m16(                rs1          +                  imm_i     )) =          halfword
-        *pos << "// " << render_reg(rd) << " = sx(m16(" << to_hex0x32(s_rs1) << " + " << to_hex0x32(imm_i) << ")) = " << to_hex0x32(halfword);
+        *pos << "// " << render_reg(rd) << " = (" << f_rs1 << " < " << f_rs2 << ") ? 1 : 0 = " << to_hex0x32(val);
     }
 
-    //set register rd to the value of the sign extended 16 bit little endian
-    //half-word value fetched from the memory address given by the sum of rs1 and imm_i
-    regs.set(rd, halfword);
+    //set rd to the result of the comparison
+    regs.set(rd, val);
 
-    //increment the pc register (pc <- pc + 4)
-    pc += 4;        
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the lw instruction.
+ * @brief Method to execute the fle.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */          
-void rv32i_hart::exec_lw(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fle_d(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -760,44 +7176,46 @@ void rv32i_hart::exec_lw(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
+    //get second source operand
+    uint32_t rs2 = get_rs2(insn);
 
-    //get signed source operand
-    int32_t s_rs1 = regs.get(rs1);
+    //get the double precision source operands
+    double f_rs1 = fregs.get_d(rs1);
+    double f_rs2 = fregs.get_d(rs2);
 
-    //calculate the sum of rs1 and the immediate value
-    int32_t sum = s_rs1 + imm_i;
+    //fle is a signaling comparison, any NaN raises the invalid flag
+    if (std::isnan(f_rs1) || std::isnan(f_rs2))
+    {
+        fcsr |= fflags_nv;
+    }
 
-    //fetch the 32 bit value from memory
-    int32_t word = mem.get32_sx(sum);
+    //compare the operands, any comparison with a NaN is false
+    uint32_t val = (f_rs1 <= f_rs2) ? 1 : 0;
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← sx(m32(rs1+imm i)), pc ← pc+4)
+    //involved before and after the instruction simulation (rd ← (rs1 <= rs2) ? 1 : 0, pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_load(insn, "lw");
+        std::string s = render_fp_compare(insn, "fle.d");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                          rd      = sx(m32(                 rs1          +                imm_i     )) =          word
-        *pos << "// " << render_reg(rd) << " = sx(m32(" << to_hex0x32(s_rs1) << " + " << to_hex0x32(imm_i) << ")) = " << to_hex0x32(word);
+        *pos << "// " << render_reg(rd) << " = (" << f_rs1 << " <= " << f_rs2 << ") ? 1 : 0 = " << to_hex0x32(val);
     }
 
-    //set register rd to the value of the sign extended 32 bit little endian
-    //word value fetched from the memory address given by the sum of rs1 and imm_i
-    regs.set(rd, word);
+    //set rd to the result of the comparison
+    regs.set(rd, val);
 
-    //increment the pc register (pc <- pc + 4)
-    pc += 4;      
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the lbu instruction.
+ * @brief Method to execute the fclass.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */ 
-void rv32i_hart::exec_lbu(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fclass_d(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -805,45 +7223,36 @@ void rv32i_hart::exec_lbu(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
-
-    //get the unsigned register source operand
-    uint32_t u_rs1 = regs.get(rs1);
-
-    //calculate the sum of rs1 and the immediate value
-    uint32_t sum = u_rs1 + imm_i;
-
-    //fetch the byte from memory
-    uint32_t byte = mem.get8(sum);
+    //get the double precision source operand
+    double f_rs1 = fregs.get_d(rs1);
 
+    //set the single bit that classifies rs1
+    uint32_t val = fp_classify(std::fpclassify(f_rs1), std::signbit(f_rs1), fregisterfile::is_snan_d(fregs.get(rs1)));
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← zx(m8(rs1+imm i)), pc ← pc+4)
+    //involved before and after the instruction simulation (rd ← class(rs1), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_load(insn, "lbu");
+        std::string s = render_fp_cvt(insn, "fclass.d", 'x', 'f', false);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                          rd      = zx(m8(                        rs1          +                  imm_i     )) =          byte
-        *pos << "// " << render_reg(rd) << " = zx(m8(" << to_hex0x32(u_rs1) << " + " << to_hex0x32(imm_i) << ")) = " << to_hex0x32(byte);
+        *pos << "// " << render_reg(rd) << " = class(" << f_rs1 << ") = " << to_hex0x32(val);
     }
 
-    //set register rd to the value of the zero extended byte fetched from the
-    //memory address given by the sum of rs1 and imm_i
-    regs.set(rd, byte);
+    //set rd to the classification mask
+    regs.set(rd, val);
 
-    //increment the pc register (pc <- pc + 4)
-    pc += 4;     
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the lhu instruction.
+ * @brief Method to execute the fcvt.w.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */ 
-void rv32i_hart::exec_lhu(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fcvt_w_d(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -851,181 +7260,231 @@ void rv32i_hart::exec_lhu(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
+    //get the double precision source operand
+    double f_rs1 = fregs.get_d(rs1);
 
-    //get the unsigned register source operand
-    uint32_t u_rs1 = regs.get(rs1);
+    //remember the flags so that an invalid conversion raises only the invalid flag
+    uint32_t flags = fcsr;
 
-    //calculate the sum of rs1 and the immediate value
-    uint32_t sum = u_rs1 + imm_i;
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
-    //fetch the byte from memory
-    uint32_t halfword = mem.get16(sum);
+    //round to an integer in the selected rounding mode, rint() cannot round
+    //ties away from zero so rmm uses round()
+    double r = (fp_rm(insn) == rm_rmm) ? std::round((double)f_rs1) : std::rint((double)f_rs1);
+    fp_end();
 
+    //out of range values and NaNs saturate and raise the invalid flag
+    uint32_t val;
+    if (std::isnan(r))
+    {
+        val = 0x7fffffff;
+        fcsr = flags | fflags_nv;
+    }
+    else if (r < -2147483648.0)
+    {
+        val = 0x80000000;
+        fcsr = flags | fflags_nv;
+    }
+    else if (r >= 2147483648.0)
+    {
+        val = 0x7fffffff;
+        fcsr = flags | fflags_nv;
+    }
+    else
+    {
+        val = (uint32_t)(int32_t)r;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← zx(m16(rs1+imm i)), pc ← pc+4)
+    //involved before and after the instruction simulation (rd ← s32(rs1), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_load(insn, "lhu");
+        std::string s = render_fp_cvt(insn, "fcvt.w.d", 'x', 'f', true);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                          rd      = zx(m16(                        rs1          +                  imm_i     )) =          halfword
-        *pos << "// " << render_reg(rd) << " = zx(m16(" << to_hex0x32(u_rs1) << " + " << to_hex0x32(imm_i) << ")) = " << to_hex0x32(halfword);
+        *pos << "// " << render_reg(rd) << " = s32(" << f_rs1 << ") = " << to_hex0x32(val);
     }
 
-    //set register rd to the value of the zero extended halfword fetched from the
-    //memory address given by the sum of rs1 and imm_i
-    regs.set(rd, halfword);
+    //set rd to the converted integer
+    regs.set(rd, val);
 
-    //increment the pc register (pc <- pc + 4)
-    pc += 4;     
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the sb instruction.
+ * @brief Method to execute the fcvt.wu.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */         
-void rv32i_hart::exec_sb(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fcvt_wu_d(uint32_t insn, std::ostream* pos)
 {
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get second source operand
-    uint32_t rs2 = get_rs2(insn);
+    //get the double precision source operand
+    double f_rs1 = fregs.get_d(rs1);
 
-    //get immediate value for s-type instruction
-    uint32_t imm_s = get_imm_s(insn);
+    //remember the flags so that an invalid conversion raises only the invalid flag
+    uint32_t flags = fcsr;
 
-    //get the unsigned register source operands
-    uint32_t u_rs1 = regs.get(rs1);
-    uint32_t u_rs2 = regs.get(rs2);
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
-    //calculate the sum of rs1 and the immediate value
-    uint32_t sum = u_rs1 + imm_s;
+    //round to an integer in the selected rounding mode, rint() cannot round
+    //ties away from zero so rmm uses round()
+    double r = (fp_rm(insn) == rm_rmm) ? std::round((double)f_rs1) : std::rint((double)f_rs1);
+    fp_end();
 
-    //extract bits 7->0 from the rs2
-    uint32_t byte = u_rs2 & 0x000000ff;
+    //out of range values and NaNs saturate and raise the invalid flag
+    uint32_t val;
+    if (std::isnan(r))
+    {
+        val = 0xffffffff;
+        fcsr = flags | fflags_nv;
+    }
+    else if (r < 0.0)
+    {
+        val = 0;
+        fcsr = flags | fflags_nv;
+    }
+    else if (r >= 4294967296.0)
+    {
+        val = 0xffffffff;
+        fcsr = flags | fflags_nv;
+    }
+    else
+    {
+        val = (uint32_t)r;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (m8(rs1+imm s) ← rs2[7:0], pc ← pc+4)
+    //involved before and after the instruction simulation (rd ← u32(rs1), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_stype(insn, "sb");
+        std::string s = render_fp_cvt(insn, "fcvt.wu.d", 'x', 'f', true);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //          m8(                  rs1        +                imm_s     )) =          rs2[7:0]
-        *pos << "// m8(" << to_hex0x32(u_rs1) << " + " << to_hex0x32(imm_s) << ") = " << to_hex0x32(byte);
+        *pos << "// " << render_reg(rd) << " = u32(" << f_rs1 << ") = " << to_hex0x32(val);
     }
 
-    //set the byte of memory at the address given by the sum of rs1 and imm_s
-    mem.set8(sum, byte);
+    //set rd to the converted integer
+    regs.set(rd, val);
 
     //increment the pc register
-    pc += 4;
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the sh instruction.
+ * @brief Method to execute the fcvt.d.w instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */         
-void rv32i_hart::exec_sh(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fcvt_d_w(uint32_t insn, std::ostream* pos)
 {
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get second source operand
-    uint32_t rs2 = get_rs2(insn);
-
-    //get immediate value for s-type instruction
-    uint32_t imm_s = get_imm_s(insn);
-
-    //get the unsigned register source operands
-    uint32_t u_rs1 = regs.get(rs1);
-    uint32_t u_rs2 = regs.get(rs2);
+    //get the signed register source operand
+    int32_t s_rs1 = regs.get(rs1);
 
-    //calculate the sum of rs1 and the immediate value
-    uint32_t sum = u_rs1 + imm_s;
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
-    //extract bits 15->0 from the rs2
-    uint32_t halfword = u_rs2 & 0x0000ffff;
+    //convert on the host FPU, which rounds in the selected mode
+    double val = (double)s_rs1;
+    fp_end();
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (m16(rs1+imm s) ← rs2[15:0], pc ← pc+4)
+    //involved before and after the instruction simulation (rd ← double(rs1), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_stype(insn, "sh");
+        std::string s = render_fp_cvt(insn, "fcvt.d.w", 'f', 'x', false);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //          m16(                  rs1        +                imm_s     )) =          rs2[15:0]
-        *pos << "// m16(" << to_hex0x32(u_rs1) << " + " << to_hex0x32(imm_s) << ") = " << to_hex0x32(halfword);
+        *pos << "// " << render_freg(rd) << " = " << to_hex0x32(s_rs1) << " = " << val;
     }
 
-    //set the halfword of memory at the address given by the sum of rs1 and imm_s
-    mem.set16(sum, halfword);
+    //set rd to the converted value
+    fregs.set_d(rd, val);
 
     //increment the pc register
-    pc += 4;
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the sw instruction.
+ * @brief Method to execute the fcvt.d.wu instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
- */         
-void rv32i_hart::exec_sw(uint32_t insn, std::ostream* pos)
+ */
+void rv32i_hart::exec_fcvt_d_wu(uint32_t insn, std::ostream* pos)
 {
+    //get register destination
+    uint32_t rd = get_rd(insn);
 
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get second source operand
-    uint32_t rs2 = get_rs2(insn);
-
-    //get immediate value for s-type instruction
-    uint32_t imm_s = get_imm_s(insn);
-
-    //get the unsigned register source operands
+    //get the unsigned register source operand
     uint32_t u_rs1 = regs.get(rs1);
-    uint32_t u_rs2 = regs.get(rs2);
 
-    //calculate the sum of rs1 and the immediate value
-    uint32_t sum = u_rs1 + imm_s;
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
-    //extract bits 32->0 from the rs2
-    uint32_t word = u_rs2;
+    //convert on the host FPU, which rounds in the selected mode
+    double val = (double)u_rs1;
+    fp_end();
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (m32(rs1+imm s) ← rs2[31:0], pc ← pc+4)
+    //involved before and after the instruction simulation (rd ← double(rs1), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_stype(insn, "sw");
+        std::string s = render_fp_cvt(insn, "fcvt.d.wu", 'f', 'x', false);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //          m32(                  rs1        +                imm_s     )) =          rs2[31:0]
-        *pos << "// m32(" << to_hex0x32(u_rs1) << " + " << to_hex0x32(imm_s) << ") = " << to_hex0x32(word);
+        *pos << "// " << render_freg(rd) << " = " << to_hex0x32(u_rs1) << " = " << val;
     }
 
-    //set the word of memory at the address given by the sum of rs1 and imm_s
-    mem.set32(sum, word);
+    //set rd to the converted value
+    fregs.set_d(rd, val);
 
     //increment the pc register
-    pc += 4;
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the addi instruction.
+ * @brief Method to execute the fcvt.s.d instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_addi(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_fcvt_s_d(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -1033,40 +7492,44 @@ void rv32i_hart::exec_addi(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
+    //get the double precision source operand
+    double f_rs1 = fregs.get_d(rs1);
 
-    //get the signed register source operand
-    int32_t s_rs1 = regs.get(rs1);
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
-    //calculate the sum of rs1 and the immediate value
-    int32_t sum = s_rs1 + imm_i;
+    //convert on the host FPU, which rounds in the selected mode
+    float val = (float)f_rs1;
+    fp_end();
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 + imm i, pc ← pc+4)
+    //involved before and after the instruction simulation (rd ← float(rs1), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_alu(insn, "addi", imm_i);
+        std::string s = render_fp_cvt(insn, "fcvt.s.d", 'f', 'f', true);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1          +              imm_i          =            sum
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " + " << to_hex0x32(imm_i) << " = " << to_hex0x32(sum);
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " = " << val;
     }
 
-    //set the rd to rs1 + imm_i
-    regs.set(rd, sum);
+    //set rd to the converted value
+    fregs.set_s(rd, val);
 
     //increment the pc register
-    pc += 4;    
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the slli instruction.
+ * @brief Method to execute the fcvt.d.s instruction.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RV32D instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_slli(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_fcvt_d_s(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -1074,40 +7537,44 @@ void rv32i_hart::exec_slli(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
+    //get the single precision source operand
+    float f_rs1 = fregs.get_s(rs1);
 
-    //get the signed register source operand
-    int32_t s_rs1 = regs.get(rs1);
+    //select the rounding mode, an invalid one makes the instruction illegal
+    if (!fp_begin(insn))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
-    //Shift rs1 left by the number of bits specified in shamt_i
-    uint32_t shift = s_rs1 << imm_i;
+    //convert on the host FPU, which rounds in the selected mode
+    double val = (double)f_rs1;
+    fp_end();
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 << shamt i, pc ← pc+4)
+    //involved before and after the instruction simulation (rd ← double(rs1), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_alu(insn, "slli", imm_i);
+        std::string s = render_fp_cvt(insn, "fcvt.d.s", 'f', 'f', false);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1          <<      imm_i      =            shift
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " << " << imm_i << " = " << to_hex0x32(shift);
+        *pos << "// " << render_freg(rd) << " = " << f_rs1 << " = " << val;
     }
 
-    //set rd to the result of the shift
-    regs.set(rd, shift);
+    //set rd to the converted value
+    fregs.set_d(rd, val);
 
     //increment the pc register
-    pc += 4;       
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the slti instruction.
+ * @brief Method to execute the vsetvli, vsetivli and vsetvl instructions.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RVV instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_slti(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_vsetvl(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -1115,527 +7582,1102 @@ void rv32i_hart::exec_slti(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
+    //vtype comes from the immediate or rs2, AVL from rs1 or the immediate
+    uint32_t new_vtype;
+    bool imm_avl = false;
+    if (!(insn & 0x80000000))
+    {
+        new_vtype = (insn >> 20) & 0x7ff;
+    }
+    else if ((insn & 0xc0000000) == 0xc0000000)
+    {
+        new_vtype = (insn >> 20) & 0x3ff;
+        imm_avl = true;
+    }
+    else if (get_funct7(insn) == funct7_vsetvl)
+    {
+        new_vtype = regs.get(get_rs2(insn));
+    }
+    else
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
-    //get the signed register source operand
-    int32_t s_rs1 = regs.get(rs1);
+    //rs1 = x0 asks for VLMAX, or keeps vl when rd is x0 as well
+    uint32_t avl;
+    if (imm_avl)
+        avl = rs1;
+    else if (rs1 != 0)
+        avl = regs.get(rs1);
+    else if (rd != 0)
+        avl = UINT32_MAX;
+    else
+        avl = vl;
 
-    //If the signed integer value in rs1 is less than the signed integer value in imm_i then set rd to 1. Otherwise, set rd to 0.
-    int32_t val = ((s_rs1 < imm_i) ? 1 : 0);
+    //an unsupported vtype sets vill and leaves no elements to process
+    uint32_t vlmax = get_vlmax(new_vtype);
+    if (vlmax == 0)
+    {
+        vtype = vtype_vill;
+        vl = 0;
+    }
+    else
+    {
+        vtype = new_vtype;
+        vl = std::min(avl, vlmax);
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← (rs1 < imm i) ? 1 : 0, pc ← pc+4)
+    //involved before and after the instruction simulation (rd ← vl ← min(AVL, VLMAX), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_alu(insn, "slti", imm_i);
+        std::string s = render_vsetvl(insn);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1          <       imm_i          =            val
-        *pos << "// " << render_reg(rd) << " = (" << to_hex0x32(s_rs1) << " < " << imm_i << ") ? 1 : 0 = " << to_hex0x32(val);
+        *pos << "// " << render_reg(rd) << " = vl = " << vl << ", vtype = " << ((vtype & vtype_vill) ? "vill" : render_vtype(vtype));
     }
 
-    //set rd to the result of the shift
-    regs.set(rd, val);
+    //set rd to the new vl
+    regs.set(rd, vl);
 
     //increment the pc register
-    pc += 4;   
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute sltiu instruction.
+ * @brief Method to execute the vector loads and stores. Unit-stride and
+ * whole register transfers are a single block copy between memory and the
+ * register file. Masked and strided transfers copy one element at a time.
  * 
- * @param insn RV32I instruction to be executed.
- * @param pos ostream used to print comment column. 
+ * @param insn RVV instruction to be executed.
+ * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_sltiu(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_vmem(uint32_t insn, std::ostream* pos)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
-
-    //get first source operand
-    uint32_t rs1 = get_rs1(insn);
-
-    //get immediate value for i-type instruction
-    uint32_t imm_i = get_imm_i(insn);
-
-    //get the unsigned register source operand
-    uint32_t u_rs1 = regs.get(rs1);
+    bool store = get_opcode(insn) == opcode_store_fp;
+
+    //get the vector data register
+    uint32_t vd = get_rd(insn);
+
+    //get the base address
+    uint32_t addr = regs.get(get_rs1(insn));
+
+    //number of fields, addressing mode and element width
+    uint32_t nf = (insn >> 29) & 0x7;
+    uint32_t mop = (insn >> 26) & 0x3;
+    uint32_t eew = get_veew(get_funct3(insn));
+    bool masked = !get_vm(insn);
+    bool vill = vtype & vtype_vill;
+
+    //number of elements, their size, the distance between them and the
+    //number of registers they fill
+    uint32_t count = vl;
+    uint32_t size = eew / 8;
+    int32_t stride = size;
+    uint32_t nregs = (eew != 0) ? get_vgroup(eew) : 0;
+    bool legal = !(insn & 0x10000000) && eew != 0;
+
+    if (mop == mop_unit && get_rs2(insn) == umop_unit)
+    {
+        legal = legal && nf == 0 && !vill;
+    }
+    else if (mop == mop_unit && get_rs2(insn) == umop_whole)
+    {
+        //whole registers ignore vtype and vl, stores only have the 8-bit form
+        legal = legal && !masked && (nf & (nf + 1)) == 0 && (!store || eew == 8);
+        nregs = nf + 1;
+        count = (size != 0) ? nregs * vregs.get_vlenb() / size : 0;
+    }
+    else if (mop == mop_unit && get_rs2(insn) == umop_mask)
+    {
+        //a mask is one bit per element, rounded up to whole bytes
+        legal = legal && !masked && nf == 0 && eew == 8 && !vill;
+        nregs = 1;
+        count = (vl + 7) / 8;
+    }
+    else if (mop == mop_strided)
+    {
+        legal = legal && nf == 0 && !vill;
+        stride = regs.get(get_rs2(insn));
+    }
+    else
+    {
+        legal = false;
+    }
 
-    //If the unsigned integer value in rs1 is less than the signed integer value in imm_i then set rd to 1. Otherwise, set rd to 0.
-    uint32_t val = ((u_rs1 < imm_i) ? 1 : 0);
+    //the register group must start on a multiple of its size and a masked
+    //load cannot overwrite the mask
+    if (!legal || nregs == 0 || vd % nregs != 0 || (masked && !store && vd == 0))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← (rs1 < imm i) ? 1 : 0, pc ← pc+4)
+    //involved before and after the instruction simulation (vd ← m(rs1) or m(rs1) ← vd, pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_alu(insn, "sltiu", imm_i);
+        std::string s = render_vmem(insn, store);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
-
-        //                         rd        =                rs1          <U              imm_i          =            val
-        *pos << "// " << render_reg(rd) << " = (" << to_hex0x32(u_rs1) << " <U " << imm_i << ") ? 1 : 0 = " << to_hex0x32(val);
+
+        if (store)
+            *pos << "// m(" << to_hex0x32(addr) << ") = " << render_vreg(vd) << ", " << count << " x " << eew << " bits";
+        else
+            *pos << "// " << render_vreg(vd) << " = m(" << to_hex0x32(addr) << "), " << count << " x " << eew << " bits";
     }
 
-    //set rd to the designated value
-    regs.set(rd, val);
+    uint8_t *v = vregs.get(vd);
+    if (!masked && stride == (int32_t)size)
+    {
+        if (!vec_transfer(addr, v, count * size, store))
+        {
+            return;
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (!masked || vregs.get_mask(0, i))
+            {
+                if (!vec_transfer(addr + i * stride, v + i * size, size, store))
+                {
+                    return;
+                }
+            }
+        }
+    }
 
     //increment the pc register
-    pc += 4;       
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the xori instruction.
+ * @brief Method to execute the OPIVV, OPIVX and OPIVI vector integer
+ * instructions.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RVV instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_xori(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_vopi(uint32_t insn, std::ostream* pos)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
+    uint32_t funct3 = get_funct3(insn);
+    uint32_t funct6 = get_funct6(insn);
 
-    //get first source operand
-    uint32_t rs1 = get_rs1(insn);
+    //get the vector registers
+    uint32_t vd = get_rd(insn);
+    uint32_t vs2 = get_rs2(insn);
+    uint32_t vs1 = get_rs1(insn);
 
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
+    //the compares write a single mask register
+    bool vv = funct3 == funct3_opivv;
+    bool compare = funct6 >= funct6_vmseq && funct6 <= funct6_vmsgt;
+    uint32_t nregs = get_vgroup(8 << ((vtype >> 3) & 0x7));
 
-    //get the signed register source operand
-    int32_t s_rs1 = regs.get(rs1);
+    //the other operand is x[rs1] for .vx and the immediate for .vi
+    int64_t scalar = (funct3 == funct3_opivx) ? regs.get(vs1) : get_simm5(insn);
 
-    //Set register rd to the bitwise xor of rs1 and imm_i.
-    int32_t val = s_rs1 ^ imm_i;
+    //the shift immediates are unsigned
+    if (funct3 == funct3_opivi && (funct6 == funct6_vsll || funct6 == funct6_vsrl || funct6 == funct6_vsra))
+    {
+        scalar = vs1;
+    }
+
+    //register groups must start on a multiple of LMUL and only a mask
+    //result may overwrite the mask of a masked instruction
+    if (!get_vopi_name(insn) || (vtype & vtype_vill) || (!compare && vd % nregs) || vs2 % nregs || (vv && vs1 % nregs)
+        || (!get_vm(insn) && vd == 0 && !compare))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 ^ imm i, pc ← pc+4)
+    //involved before and after the instruction simulation (vd[i] ← vs2[i] op vs1[i], pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_alu(insn, "xori", imm_i);
+        std::string s = render_vopi(insn);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1          ^              imm_i          =            val
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " ^ " << to_hex0x32(imm_i) << " = " << to_hex0x32(val);
+        *pos << "// vl = " << vl << ", " << render_vtype(vtype);
     }
 
-    //set rd to the result of the bitwise operation
-    regs.set(rd, val);
+    switch (funct6)
+    {
+        case funct6_vadd:  vec_arith(insn, scalar, [](auto a, auto b) { return a + b; }); break;
+        case funct6_vsub:  vec_arith(insn, scalar, [](auto a, auto b) { return a - b; }); break;
+        case funct6_vrsub:  vec_arith(insn, scalar, [](auto a, auto b) { return b - a; }); break;
+        case funct6_vand:  vec_arith(insn, scalar, [](auto a, auto b) { return a & b; }); break;
+        case funct6_vor:  vec_arith(insn, scalar, [](auto a, auto b) { return a | b; }); break;
+        case funct6_vxor:  vec_arith(insn, scalar, [](auto a, auto b) { return a ^ b; }); break;
+        case funct6_vmin:  vec_arith(insn, scalar, [](auto a, auto b) { return (a < b) ? a : b; }); break;
+        case funct6_vmax:  vec_arith(insn, scalar, [](auto a, auto b) { return (a > b) ? a : b; }); break;
+
+        case funct6_vminu:
+            vec_arith(insn, scalar, [](auto a, auto b) {
+                typedef std::make_unsigned_t<decltype(a)> U;
+                return ((U)a < (U)b) ? a : b;
+            });
+            break;
+
+        case funct6_vmaxu:
+            vec_arith(insn, scalar, [](auto a, auto b) {
+                typedef std::make_unsigned_t<decltype(a)> U;
+                return ((U)a > (U)b) ? a : b;
+            });
+            break;
+
+        //shifts use the low log2(SEW) bits of the shift amount
+        case funct6_vsll:
+            vec_arith(insn, scalar, [](auto a, auto b) {
+                typedef std::make_unsigned_t<decltype(a)> U;
+                return (U)a << (b & (sizeof(a) * 8 - 1));
+            });
+            break;
+
+        case funct6_vsrl:
+            vec_arith(insn, scalar, [](auto a, auto b) {
+                typedef std::make_unsigned_t<decltype(a)> U;
+                return (U)a >> (b & (sizeof(a) * 8 - 1));
+            });
+            break;
+
+        case funct6_vsra:  vec_arith(insn, scalar, [](auto a, auto b) { return a >> (b & (sizeof(a) * 8 - 1)); }); break;
+
+        case funct6_vmseq:  vec_compare(insn, scalar, [](auto a, auto b) { return a == b; }); break;
+        case funct6_vmsne:  vec_compare(insn, scalar, [](auto a, auto b) { return a != b; }); break;
+        case funct6_vmslt:  vec_compare(insn, scalar, [](auto a, auto b) { return a < b; }); break;
+        case funct6_vmsle:  vec_compare(insn, scalar, [](auto a, auto b) { return a <= b; }); break;
+        case funct6_vmsgt:  vec_compare(insn, scalar, [](auto a, auto b) { return a > b; }); break;
+
+        case funct6_vmsltu:
+            vec_compare(insn, scalar, [](auto a, auto b) {
+                typedef std::make_unsigned_t<decltype(a)> U;
+                return (U)a < (U)b;
+            });
+            break;
+
+        case funct6_vmsleu:
+            vec_compare(insn, scalar, [](auto a, auto b) {
+                typedef std::make_unsigned_t<decltype(a)> U;
+                return (U)a <= (U)b;
+            });
+            break;
+
+        case funct6_vmsgtu:
+            vec_compare(insn, scalar, [](auto a, auto b) {
+                typedef std::make_unsigned_t<decltype(a)> U;
+                return (U)a > (U)b;
+            });
+            break;
+
+        case funct6_vmerge:  vec_merge(insn, scalar); break;
+    }
 
     //increment the pc register
-    pc += 4;    
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the ori instruction.
+ * @brief Method to execute the OPMVV and OPMVX vector instructions.
  * 
- * @param insn RV32I instruction to be executed.
+ * @param insn RVV instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_ori(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_vopm(uint32_t insn, std::ostream* pos)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
-
-    //get first source operand
-    uint32_t rs1 = get_rs1(insn);
-
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
-
-    //get the signed register source operand
-    int32_t s_rs1 = regs.get(rs1);
-
-    //Set register rd to the bitwise or of rs1 and imm_i.
-    uint32_t val = s_rs1 | imm_i;
+    uint32_t funct6 = get_funct6(insn);
+
+    //get the vector registers
+    uint32_t vd = get_rd(insn);
+    uint32_t vs2 = get_rs2(insn);
+    uint32_t vs1 = get_rs1(insn);
+
+    //reductions and the scalar moves use single registers for vd and vs1
+    bool vv = get_funct3(insn) == funct3_opmvv;
+    bool single = funct6 <= funct6_vredmax || funct6 == funct6_vwxunary0;
+    uint32_t sew = 8 << ((vtype >> 3) & 0x7);
+    uint32_t nregs = get_vgroup(sew);
+    int64_t scalar = regs.get(vs1);
+
+    if (!get_vopm_name(insn) || (vtype & vtype_vill) || (!single && vd % nregs) || vs2 % nregs || (vv && !single && vs1 % nregs)
+        || (!get_vm(insn) && vd == 0 && funct6 > funct6_vredmax))
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 ^ imm i, pc ← pc+4)
+    //involved before and after the instruction simulation (vd[i] ← vs2[i] op vs1[i], pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_alu(insn, "ori", imm_i);
+        std::string s = render_vopm(insn);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1          |              imm_i          =            val
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " | " << to_hex0x32(imm_i) << " = " << to_hex0x32(val);
+        *pos << "// vl = " << vl << ", " << render_vtype(vtype);
     }
 
-    //set rd to the result of the bitwise operation
-    regs.set(rd, val);
+    switch (funct6)
+    {
+        case funct6_vredsum:  vec_reduce(insn, [](auto a, auto b) { return a + b; }); break;
+        case funct6_vredand:  vec_reduce(insn, [](auto a, auto b) { return a & b; }); break;
+        case funct6_vredor:  vec_reduce(insn, [](auto a, auto b) { return a | b; }); break;
+        case funct6_vredxor:  vec_reduce(insn, [](auto a, auto b) { return a ^ b; }); break;
+        case funct6_vredmin:  vec_reduce(insn, [](auto a, auto b) { return (a < b) ? a : b; }); break;
+        case funct6_vredmax:  vec_reduce(insn, [](auto a, auto b) { return (a > b) ? a : b; }); break;
+
+        case funct6_vredminu:
+            vec_reduce(insn, [](auto a, auto b) {
+                typedef std::make_unsigned_t<decltype(a)> U;
+                return ((U)a < (U)b) ? a : b;
+            });
+            break;
+
+        case funct6_vredmaxu:
+            vec_reduce(insn, [](auto a, auto b) {
+                typedef std::make_unsigned_t<decltype(a)> U;
+                return ((U)a > (U)b) ? a : b;
+            });
+            break;
+
+        //unsigned arithmetic wraps the way the instruction does
+        case funct6_vmul:
+            vec_arith(insn, scalar, [](auto a, auto b) {
+                typedef std::make_unsigned_t<decltype(a)> U;
+                return (U)a * (U)b;
+            });
+            break;
+
+        //the high half of the 2*SEW-bit product
+        case funct6_vmulh:
+            vec_arith(insn, scalar, [](auto a, auto b) {
+                typedef decltype(a) T;
+                if constexpr (sizeof(T) == 8)
+                    return (T)(((__int128)a * b) >> 64);
+                else
+                    return (T)(((int64_t)a * b) >> (sizeof(T) * 8));
+            });
+            break;
+
+        case funct6_vmulhu:
+            vec_arith(insn, scalar, [](auto a, auto b) {
+                typedef decltype(a) T;
+                typedef std::make_unsigned_t<T> U;
+                if constexpr (sizeof(T) == 8)
+                    return (T)(((unsigned __int128)(U)a * (U)b) >> 64);
+                else
+                    return (T)(((uint64_t)(U)a * (U)b) >> (sizeof(T) * 8));
+            });
+            break;
+
+        case funct6_vmacc:  vec_macc(insn, scalar); break;
+
+        case funct6_vwxunary0:
+            if (vv)
+            {
+                //vmv.x.s: x[rd] = vs2[0] sign extended, or its low 32 bits
+                const uint8_t *p = vregs.get(vs2);
+                int32_t val;
+                if (sew == 8)
+                    val = (int8_t)p[0];
+                else if (sew == 16)
+                    val = (int16_t)(p[0] | p[1] << 8);
+                else
+                    val = p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+                regs.set(vd, val);
+            }
+            else if (vl > 0)
+            {
+                //vmv.s.x: vd[0] = x[rs1] sign extended to SEW
+                uint8_t *p = vregs.get(vd);
+                for (uint32_t b = 0; b < sew / 8; b++)
+                    p[b] = scalar >> (b * 8);
+            }
+            break;
+    }
 
     //increment the pc register
-    pc += 4;      
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the andi instruction.
+ * @brief Method that translates every page of a bulk memory range under
+ * Sv32, so a fault is raised before any byte of the operation moves.
  * 
- * @param insn RV32I instruction to be executed.
- * @param pos ostream used to print comment column.
+ * @param addr virtual address of the first byte.
+ * @param len number of bytes.
+ * @param access access_load or access_store.
+ * @param paddr set to the physical address of each page sized piece.
+ * @return true if every page translated, false if the hart trapped.
  */
-void rv32i_hart::exec_andi(uint32_t insn, std::ostream* pos)
+bool rv32i_hart::bulk_translate(uint32_t addr, uint32_t len, uint32_t access, std::vector<uint32_t> &paddr)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
+    tlb_entry *tlb = (access == access_store) ? wtlb : rtlb;
+    paddr.clear();
 
-    //get first source operand
-    uint32_t rs1 = get_rs1(insn);
-
-    //get immediate value for i-type instruction
-    int32_t imm_i = get_imm_i(insn);
+    uint32_t done = 0;
+    while (done < len)
+    {
+        uint32_t va = addr + done;
+        uint32_t offset = va & (memory::page_size - 1);
+        tlb_entry *e = translate(tlb, data_key, va, access);
+        if (!e)
+        {
+            return false;
+        }
+        paddr.push_back(e->page | offset);
+        done += std::min(len - done, memory::page_size - offset);
+    }
+    return true;
+}
 
-    //get the signed register source operand
-    int32_t s_rs1 = regs.get(rs1);
+/**
+ * @brief Method that copies a translated bulk memory range to or from a
+ * host buffer one page sized piece at a time.
+ * 
+ * @param addr virtual address of the first byte, only used for the piece sizes.
+ * @param paddr physical address of each piece from bulk_translate().
+ * @param buf host buffer of len bytes.
+ * @param len number of bytes.
+ * @param store true to write buf to memory, false to read memory into buf.
+ * @return true if every piece is in memory.
+ */
+bool rv32i_hart::bulk_transfer(uint32_t addr, const std::vector<uint32_t> &paddr, uint8_t *buf, uint32_t len, bool store)
+{
+    uint32_t done = 0;
+    for (uint32_t p : paddr)
+    {
+        uint32_t n = std::min(len - done, memory::page_size - ((addr + done) & (memory::page_size - 1)));
+        if (!(store ? mem.write_block(p, buf + done, n) : mem.read_block(p, buf + done, n)))
+        {
+            return false;
+        }
+        done += n;
+    }
+    return true;
+}
 
-    //Set register rd to the bitwise and of rs1 and imm_i.
-    uint32_t val = s_rs1 & imm_i;
+/**
+ * @brief Method to execute the bulk.cpy instruction,
+ * memmove(a0, a1, a2) done on the host in one call. a0 is left alone.
+ * 
+ * @param insn host bulk memory instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_bulk_cpy(uint32_t insn, std::ostream* pos)
+{
+    //get the destination, source and length from a0-a2
+    uint32_t dst = regs.get(10);
+    uint32_t src = regs.get(11);
+    uint32_t len = regs.get(12);
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 ^ imm i, pc ← pc+4)
+    //involved before and after the instruction simulation (m[a0] ← m[a1] for a2 bytes, pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_alu(insn, "andi", imm_i);
+        std::string s = render_bulk(insn, "bulk.cpy");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1          &              imm_i          =            val
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " & " << to_hex0x32(imm_i) << " = " << to_hex0x32(val);
+        *pos << "// m(" << to_hex0x32(dst) << ") = m(" << to_hex0x32(src) << "), " << len << " bytes";
     }
 
-    //set rd to the result of the bitwise operation
-    regs.set(rd, val);
+    bool ok;
+    if (vm_data)
+    {
+        //translate every page of both ranges before any byte moves, then
+        //go through a host buffer so overlapping ranges still act like
+        //memmove
+        std::vector<uint32_t> from, to;
+        if (!bulk_translate(src, len, access_load, from) || !bulk_translate(dst, len, access_store, to))
+        {
+            return;
+        }
+        std::vector<uint8_t> buf(len);
+        ok = bulk_transfer(src, from, buf.data(), len, false) && bulk_transfer(dst, to, buf.data(), len, true);
+    }
+    else
+    {
+        //trap if a page does not allow the access or either range is
+        //outside of memory
+        if (!check_perm(src, len, access_load, src) || !check_perm(dst, len, access_store, dst))
+        {
+            return;
+        }
+        ok = mem.copy_block(dst, src, len);
+    }
+    if (!ok)
+    {
+        trap(cause_store_fault, dst, "Bulk memory range error");
+        return;
+    }
 
     //increment the pc register
-    pc += 4;
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the srli instruction.
+ * @brief Method to execute the bulk.set instruction,
+ * memset(a0, a1, a2) done on the host in one call. a0 is left alone.
  * 
- * @param insn RV32I instruction to be executed.
- * @param pos ostream used to print comment column. 
+ * @param insn host bulk memory instruction to be executed.
+ * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_srli(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_bulk_set(uint32_t insn, std::ostream* pos)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
-
-    //get first source operand
-    uint32_t rs1 = get_rs1(insn);
-
-    //get immediate value for i-type instruction
-    uint32_t imm_i = get_imm_i(insn);
-
-    //get the signed register source operand
-    uint32_t u_rs1 = regs.get(rs1);
-
-    //Shift rs1 right by the number of bits specified in shamt_i
-    uint32_t shift = u_rs1 >> (imm_i & 0x0000001f);
+    //get the destination, byte value and length from a0-a2
+    uint32_t dst = regs.get(10);
+    uint8_t val = regs.get(11);
+    uint32_t len = regs.get(12);
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 >> shamt i, pc ← pc+4)
+    //involved before and after the instruction simulation (m[a0] ← a1 for a2 bytes, pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_alu(insn, "srli", imm_i);
+        std::string s = render_bulk(insn, "bulk.set");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1          >>       imm_i          =            shift
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(u_rs1) << " >> " << imm_i << " = " << to_hex0x32(shift);
+        *pos << "// m(" << to_hex0x32(dst) << ") = " << "0x" << to_hex8(val) << ", " << len << " bytes";
     }
 
-    //set rd to the result of the shift
-    regs.set(rd, shift);
+    bool ok;
+    if (vm_data)
+    {
+        //translate every page of the range before any byte is set
+        std::vector<uint32_t> to;
+        if (!bulk_translate(dst, len, access_store, to))
+        {
+            return;
+        }
+        std::vector<uint8_t> buf(len, val);
+        ok = bulk_transfer(dst, to, buf.data(), len, true);
+    }
+    else
+    {
+        //trap if a page does not allow the access or the range is outside
+        //of memory
+        if (!check_perm(dst, len, access_store, dst))
+        {
+            return;
+        }
+        ok = mem.fill_block(dst, val, len);
+    }
+    if (!ok)
+    {
+        trap(cause_store_fault, dst, "Bulk memory range error");
+        return;
+    }
 
     //increment the pc register
-    pc += 4;   
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the srai instruction.
+ * @brief Method to execute the bulk.cmp instruction,
+ * a0 = memcmp(a0, a1, a2) done on the host in one call. a0 is set to
+ * -1, 0 or 1.
  * 
- * @param insn RV32I instruction to be executed.
- * @param pos ostream used to print comment column. 
+ * @param insn host bulk memory instruction to be executed.
+ * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_srai(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_bulk_cmp(uint32_t insn, std::ostream* pos)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
-
-    //get first source operand
-    uint32_t rs1 = get_rs1(insn);
-
-    //get immediate value for i-type instruction
-    uint32_t imm_i = get_imm_i(insn);
-
-    //get the signed register source operand
-    int32_t s_rs1 = regs.get(rs1);
-
-    //extract shamt_i value from imm_i
-    int32_t shamt_i = (imm_i & 0x0000001f);
-
-    //Shift rs1 right by the number of bits specified in shamt_i
-    int32_t shift = s_rs1 >> shamt_i;
+    //get the two ranges and their length from a0-a2
+    uint32_t a = regs.get(10);
+    uint32_t b = regs.get(11);
+    uint32_t len = regs.get(12);
+
+    int32_t val;
+    bool ok;
+    if (vm_data)
+    {
+        //translate every page of both ranges, then compare host copies
+        std::vector<uint32_t> pa, pb;
+        if (!bulk_translate(a, len, access_load, pa) || !bulk_translate(b, len, access_load, pb))
+        {
+            return;
+        }
+        std::vector<uint8_t> bufa(len), bufb(len);
+        ok = bulk_transfer(a, pa, bufa.data(), len, false) && bulk_transfer(b, pb, bufb.data(), len, false);
+        int diff = len ? std::memcmp(bufa.data(), bufb.data(), len) : 0;
+        val = (diff > 0) - (diff < 0);
+    }
+    else
+    {
+        //trap if a page does not allow the access or either range is
+        //outside of memory
+        if (!check_perm(a, len, access_load, a) || !check_perm(b, len, access_load, b))
+        {
+            return;
+        }
+        ok = mem.compare_block(a, b, len, val);
+    }
+    if (!ok)
+    {
+        trap(cause_load_fault, a, "Bulk memory range error");
+        return;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 >> shamt i, pc ← pc+4)
+    //involved before and after the instruction simulation (a0 ← memcmp(a0, a1, a2), pc ← pc+4)
     if(pos)
     {
-        std::string s = render_itype_alu(insn, "srai", shamt_i);
+        std::string s = render_bulk(insn, "bulk.cmp");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1          >>        shamt_i     =            shift
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(s_rs1) << " >> " << shamt_i << " = " << to_hex0x32(shift);
+        *pos << "// " << render_reg(10) << " = memcmp(" << to_hex0x32(a) << ", " << to_hex0x32(b) << ", " << len << ") = " << val;
     }
 
-    //set rd to the result of the shift
-    regs.set(rd, shift);
+    //set a0 to the result
+    regs.set(10, val);
 
     //increment the pc register
-    pc += 4;
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the add instruction.
+ * @brief Method to execute the ECALL instruction. The system call in a7
+ * is run on the host by the syscall proxy and its result goes to a0.
+ * Without a proxy ECALL raises an environment call exception for the
+ * guest's own handler.
  * 
  * @param insn RV32I instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_add(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_ecall(uint32_t insn, std::ostream* pos)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
-
-    //get first source register
-    uint32_t rs1 = get_rs1(insn);
-
-    //get second source register
-    uint32_t rs2 = get_rs2(insn);
+    //only M-mode calls go to the host, the lower modes trap to the guest
+    if (!sys || priv != priv_m)
+    {
+        if(pos)
+        {
+            *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << render_ecall(insn);
+            *pos << "// trap";
+        }
+        trap((priv == priv_u) ? cause_ecall_u : (priv == priv_s) ? cause_ecall_s : cause_ecall_m, 0, "ECALL instruction");
+        return;
+    }
 
-    //calculate sum of rs1 + rs2
-    int32_t val = regs.get(rs1) + regs.get(rs2);
+    //get the call number from a7 and the arguments from a0-a5
+    uint32_t num = regs.get(17);
+    syscall_proxy::args a;
+    for (uint32_t r = 0; r < 6; r++)
+    {
+        a.a[r] = regs.get(10 + r);
+    }
+    a.time = get_time();
 
-    //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 + rs2, pc ← pc+4)
+    //print the call before running it so its output follows the trace line
     if(pos)
     {
-        std::string s = render_rtype(insn, "add");
+        std::string s = render_ecall(insn);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1                  +                     rs2           =            val
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " + " << to_hex0x32(regs.get(rs2)) << " = " << to_hex0x32(val);
+        *pos << "// syscall " << num << "(" << to_hex0x32(a.a[0]) << ", " << to_hex0x32(a.a[1]) << ", " << to_hex0x32(a.a[2]) << ")";
     }
 
-    //Set register rd to rs1 + rs2.
-    regs.set(rd, val);
+    int32_t ret = sys->call(num, a);
 
-    //increment pc register
-    pc += 4;
+    //exit halts the hart with the status in the halt reason
+    if (a.exit)
+    {
+        halt = true;
+        halt_reason = "exit(" + std::to_string(ret) + ")";
+        return;
+    }
 
+    //set a0 to the result
+    regs.set(10, ret);
+
+    //increment the pc register
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the sub instruction.
+ * @brief Method to execute the MRET instruction, which returns from a
+ * trap handler to mepc and restores the interrupt enable.
  * 
  * @param insn RV32I instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_sub(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_mret(uint32_t insn, std::ostream* pos)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
-
-    //get first source register
-    uint32_t rs1 = get_rs1(insn);
-
-    //get second source register
-    uint32_t rs2 = get_rs2(insn);
-
-    //calculate difference of rs1 + rs2
-    int32_t val = regs.get(rs1) - regs.get(rs2);
+    if (priv != priv_m)
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 - rs2, pc ← pc+4)
+    //involved before and after the instruction simulation (pc ← mepc)
     if(pos)
     {
-        std::string s = render_rtype(insn, "sub");
+        std::string s = render_mret(insn);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1                  -                     rs2           =            val
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " - " << to_hex0x32(regs.get(rs2)) << " = " << to_hex0x32(val);
+        *pos << "// pc = " << to_hex0x32(mepc);
     }
 
-    //Set register rd to rs1 - rs2.
-    regs.set(rd, val);
+    //MIE = MPIE, MPIE = 1, return to the MPP mode and leave MPP = U
+    uint32_t mpp = (mstatus & mstatus_mpp) >> mstatus_mpp_shift;
+    mstatus = (mstatus & ~mstatus_mie) | ((mstatus & mstatus_mpie) ? mstatus_mie : 0);
+    mstatus |= mstatus_mpie;
+    mstatus &= ~mstatus_mpp;
 
-    //increment pc register
-    pc += 4;
+    //MPRV only stays set when returning to M-mode
+    if (mpp != priv_m)
+    {
+        mstatus &= ~mstatus_mprv;
+    }
+
+    priv = mpp;
+    update_vm();
+    update_pending();
 
+    //return to the trapped instruction or the one after it
+    pc = mepc;
 }
 
 /**
- * @brief Method to execute the sll instruction.
+ * @brief Method to execute the WFI instruction. If no enabled interrupt
+ * is pending the hart goes idle, which lets the run loop skip the time
+ * until the next device event instead of executing the wait. Execution
+ * goes on after the WFI either way, as the spec allows.
  * 
  * @param insn RV32I instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_sll(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_wfi(uint32_t insn, std::ostream* pos)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
-
-    //get first source register
-    uint32_t rs1 = get_rs1(insn);
-
-    //get second source register
-    uint32_t rs2 = get_rs2(insn);
-
-    //extract the 5 LSB of rs2
-    int32_t shift = (regs.get(rs2) & 0x0000001f);
-
-    //shift left rs1 by the extracted 5 LSB of rs2
-    int32_t val = regs.get(rs1) << shift;
+    //an interrupt wakes the hart whether or not mstatus.MIE is set
+    idle = (mip & mie) == 0;
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 << (rs2%XLEN), pc ← pc+4)
+    //involved before and after the instruction simulation
     if(pos)
     {
-        std::string s = render_rtype(insn, "sll");
+        std::string s = render_wfi(insn);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1                  <<      shift     =            val
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " << " << shift << " = " << to_hex0x32(val);
+        *pos << (idle ? "// idle" : "// interrupt pending");
     }
 
-    //Set register rd to rs1 << (rs2%XLEN)
-    regs.set(rd, val);
-
-    //increment pc register
-    pc += 4;
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the slt instruction.
+ * @brief Method to execute the SFENCE.VMA instruction. The whole TLB is
+ * flushed whatever the address and ASID operands are.
  * 
  * @param insn RV32I instruction to be executed.
- * @param pos ostream used to print comment column. 
+ * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_slt(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_sfence_vma(uint32_t insn, std::ostream* pos)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
-
-    //get first source register
-    uint32_t rs1 = get_rs1(insn);
-
-    //get second source register
-    uint32_t rs2 = get_rs2(insn);
-
-    //If the signed integer value in rs1 is less than the signed integer value in rs2 then set rd to 1. Otherwise, set rd to 0.
-    int32_t val = (regs.get(rs1) < regs.get(rs2) ? 1 : 0);
+    if (priv == priv_u)
+    {
+        exec_illegal_insn(insn, pos);
+        return;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← (rs1 < rs2) ? 1 : 0, pc ← pc+4)
+    //involved before and after the instruction simulation
     if(pos)
     {
-        std::string s = render_rtype(insn, "slt");
+        std::string s = render_sfence_vma(insn);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                (rs1                   <                     rs2          ) ? 1 : 0 =            val
-        *pos << "// " << render_reg(rd) << " = (" << to_hex0x32(regs.get(rs1)) << " < " << to_hex0x32(regs.get(rs2)) << ") ? 1 : 0 = " << to_hex0x32(val);
+        *pos << "// flush TLB";
     }
 
-    //set rd to value
-    regs.set(rd, val);
+    flush_tlb();
 
-    //increment pc register
-    pc += 4;
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the sltu instruction.
+ * @brief Method that fast-forwards an idle hart. An idle hart is stopped
+ * in WFI or in a branch or jump to itself, so until the next interrupt
+ * the only thing that changes is the instruction count, and the counters
+ * and time that follow it. Those jump straight to count.
  * 
- * @param insn RV32I instruction to be executed.
- * @param pos ostream used to print comment column. 
+ * @param count instruction count to wake up at. A count that is not ahead
+ * of the hart just wakes it.
  */
-void rv32i_hart::exec_sltu(uint32_t insn, std::ostream* pos)
+void rv32i_hart::skip_idle(uint64_t count)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
-
-    //get first source register
-    uint32_t rs1 = get_rs1(insn);
-
-    //get second source register
-    uint32_t rs2 = get_rs2(insn);
-
-    //get the unsigned source operands
-    uint32_t u_rs1 = regs.get(rs1);
-    uint32_t u_rs2 = regs.get(rs2);
-
-    //if the unsigned integer value in rs1 is less than the unsigned integer value in rs2 then set rd to 1. Otherwise, set rd to 0.
-    uint32_t val = (u_rs1 < u_rs2 ? 1 : 0);
+    if (count > insn_counter)
+    {
+        insn_counter = count;
+    }
+    idle = false;
+}
 
+/**
+ * @brief Method to execute the EBREAK instruction.
+ * 
+ * @param insn RV32I instruction to be executed.
+ * @param pos ostream used to print comment column.
+ */
+void rv32i_hart::exec_ebreak(uint32_t insn, std::ostream* pos)
+{
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← (rs1 < rs2) ? 1 : 0, pc ← pc+4)
+    //involved before and after the instruction simulation
     if(pos)
     {
-        std::string s = render_rtype(insn, "sltu");
+        std::string s = render_ebreak(insn);
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+        
+        *pos << "// HALT";
+    }
+    halt = true;
+    halt_reason = "EBREAK instruction";
+}
 
-        //                         rd        =                (rs1          <U                rs2          ) ? 1 : 0 =            val
-        *pos << "// " << render_reg(rd) << " = (" << to_hex0x32(u_rs1) << " <U " << to_hex0x32(u_rs2) << ") ? 1 : 0 = " << to_hex0x32(val);
+
+/**
+ * @brief Method that reads a CSR.
+ * 
+ * @param csr number of the CSR.
+ * @param val receives the value of the CSR.
+ * @return true if the CSR exists.
+ */
+bool rv32i_hart::csr_read(uint32_t csr, uint32_t &val) const
+{
+    //bits 9:8 of the number are the lowest mode that can access the CSR
+    if (((csr >> 8) & 0x3) > priv)
+    {
+        return false;
     }
 
-    //set rd to value
-    regs.set(rd, val);
+    //the lower modes only see the counters mcounteren, and for U-mode
+    //also scounteren, let through
+    if ((csr & 0xf60) == csr_cycle)
+    {
+        uint32_t bit = 1u << (csr & 0x1f);
+        if ((priv != priv_m && !(mcounteren & bit)) || (priv == priv_u && !(scounteren & bit)))
+        {
+            return false;
+        }
+    }
 
-    //increment pc register
-    pc += 4;
+    //the performance monitoring counters and events are hardwired to zero
+    if ((csr >= csr_hpmcounter3 && csr <= csr_hpmcounter31) || (csr >= csr_hpmcounter3h && csr <= csr_hpmcounter31h)
+        || (csr >= csr_mhpmcounter3 && csr <= csr_mhpmcounter31) || (csr >= csr_mhpmcounter3h && csr <= csr_mhpmcounter31h)
+        || (csr >= csr_mhpmevent3 && csr <= csr_mhpmevent31))
+    {
+        val = 0;
+        return true;
+    }
+
+    switch (csr)
+    {
+        default:  return false;
+
+        //floating point
+        case csr_fflags:  val = fcsr & 0x1f; return true;
+        case csr_frm:  val = (fcsr >> 5) & 0x7; return true;
+        case csr_fcsr:  val = fcsr & 0xff; return true;
+
+        //vector
+        case csr_vl:  val = vl; return true;
+        case csr_vtype:  val = vtype; return true;
+        case csr_vlenb:  val = vregs.get_vlenb(); return true;
+
+        //counters, the user copies are read-only views of the machine ones
+        case csr_cycle:
+        case csr_mcycle:  val = get_counter(cycle_base, mcountinhibit_cy); return true;
+        case csr_cycleh:
+        case csr_mcycleh:  val = get_counter(cycle_base, mcountinhibit_cy) >> 32; return true;
+        case csr_instret:
+        case csr_minstret:  val = get_counter(instret_base, mcountinhibit_ir); return true;
+        case csr_instreth:
+        case csr_minstreth:  val = get_counter(instret_base, mcountinhibit_ir) >> 32; return true;
+        case csr_time:  val = get_time(); return true;
+        case csr_timeh:  val = get_time() >> 32; return true;
+        case csr_mcountinhibit:  val = mcountinhibit; return true;
+
+        //machine information
+        case csr_mvendorid:
+        case csr_marchid:
+        case csr_mimpid:  val = 0; return true;
+        case csr_mhartid:  val = mhartid; return true;
+        case csr_misa:  val = misa; return true;
+
+        //trap handling
+        case csr_mstatus:  val = mstatus; return true;
+        case csr_mie:  val = mie; return true;
+        case csr_mip:  val = mip; return true;
+        case csr_mtvec:  val = mtvec; return true;
+        case csr_mscratch:  val = mscratch; return true;
+        case csr_mepc:  val = mepc; return true;
+        case csr_mcause:  val = mcause; return true;
+        case csr_mtval:  val = mtval; return true;
+
+        //virtual memory and the lower modes, nothing is delegated
+        case csr_satp:  val = satp; return true;
+        case csr_medeleg:
+        case csr_mideleg:  val = 0; return true;
+        case csr_mcounteren:  val = mcounteren; return true;
+        case csr_scounteren:  val = scounteren; return true;
+    }
 }
 
 /**
- * @brief Method to execute the xor instruction.
+ * @brief Method that writes a CSR. CSRs whose number starts with 0b11
+ * are read-only.
  * 
- * @param insn RV32I instruction to be executed.
- * @param pos ostream used to print comment column. 
+ * @param csr number of the CSR.
+ * @param val new value, bits the CSR does not implement are ignored.
+ * @return true if the CSR exists and can be written.
  */
-void rv32i_hart::exec_xor(uint32_t insn, std::ostream* pos)
+bool rv32i_hart::csr_write(uint32_t csr, uint32_t val)
 {
-    //get register destination
-    uint32_t rd = get_rd(insn);
+    if ((csr >> 10) == 0x3 || ((csr >> 8) & 0x3) > priv)
+    {
+        return false;
+    }
 
-    //get first source operand
-    uint32_t rs1 = get_rs1(insn);
+    //writes to the hardwired performance monitoring counters and events are ignored
+    if ((csr >= csr_mhpmcounter3 && csr <= csr_mhpmcounter31) || (csr >= csr_mhpmcounter3h && csr <= csr_mhpmcounter31h)
+        || (csr >= csr_mhpmevent3 && csr <= csr_mhpmevent31))
+    {
+        return true;
+    }
 
-    //get second source operand
-    uint32_t rs2 = get_rs2(insn);
+    uint64_t count;
+    switch (csr)
+    {
+        default:  return false;
 
-    //Set register rd to the bitwise XOR of rs1 and rs2.
-    int32_t val = regs.get(rs1) ^ regs.get(rs2);
+        case csr_fflags:  fcsr = (fcsr & ~0x1fu) | (val & 0x1f); return true;
+        case csr_frm:  fcsr = (fcsr & ~0xe0u) | ((val & 0x7) << 5); return true;
+        case csr_fcsr:  fcsr = val & 0xff; return true;
 
-    //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 ^ rs2, pc ← pc+4)
-    if(pos)
-    {
-        std::string s = render_rtype(insn, "xor");
-        *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
+        case csr_mcycle:
+            count = get_counter(cycle_base, mcountinhibit_cy);
+            set_counter(cycle_base, mcountinhibit_cy, (count & 0xffffffff00000000) | val);
+            return true;
 
-        //                         rd        =                rs1          ^              rs2          =            val
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " ^ " << to_hex0x32(regs.get(rs2)) << " = " << to_hex0x32(val);
+        case csr_mcycleh:
+            count = get_counter(cycle_base, mcountinhibit_cy);
+            set_counter(cycle_base, mcountinhibit_cy, (count & 0xffffffff) | (uint64_t)val << 32);
+            return true;
+
+        case csr_minstret:
+            count = get_counter(instret_base, mcountinhibit_ir);
+            set_counter(instret_base, mcountinhibit_ir, (count & 0xffffffff00000000) | val);
+            return true;
+
+        case csr_minstreth:
+            count = get_counter(instret_base, mcountinhibit_ir);
+            set_counter(instret_base, mcountinhibit_ir, (count & 0xffffffff) | (uint64_t)val << 32);
+            return true;
+
+        case csr_mcountinhibit:
+            {
+                //freeze or resume the counters at their current values
+                uint64_t cycle = get_counter(cycle_base, mcountinhibit_cy);
+                uint64_t instret = get_counter(instret_base, mcountinhibit_ir);
+                mcountinhibit = val & (mcountinhibit_cy | mcountinhibit_ir);
+                set_counter(cycle_base, mcountinhibit_cy, cycle);
+                set_counter(instret_base, mcountinhibit_ir, instret);
+            }
+            return true;
+
+        //misa cannot be changed and mip is driven by the devices
+        case csr_misa:
+        case csr_mip:  return true;
+
+        //MPP only holds the modes that exist, a write of the reserved
+        //mode 2 leaves it as it was
+        case csr_mstatus:
+            {
+                uint32_t mpp = (val & mstatus_mpp) >> mstatus_mpp_shift;
+                if (mpp == 2)
+                {
+                    mpp = (mstatus & mstatus_mpp) >> mstatus_mpp_shift;
+                }
+                mstatus = (val & (mstatus_mie | mstatus_mpie | mstatus_mprv | mstatus_sum | mstatus_mxr)) | mpp << mstatus_mpp_shift;
+            }
+            update_vm();
+            update_pending();
+            return true;
+
+        case csr_mie:
+            mie = val & (mip_msip | mip_mtip | mip_meip);
+            update_pending();
+            return true;
+
+        //direct and vectored modes, the reserved modes read as direct
+        case csr_mtvec:  mtvec = val & ~0x2u; return true;
+        case csr_mscratch:  mscratch = val; return true;
+        case csr_mepc:  mepc = val & ~0x1u; return true;
+        case csr_mcause:  mcause = val; return true;
+        case csr_mtval:  mtval = val; return true;
+
+        //the ASID is not implemented and reads as 0, a new satp flushes the TLB
+        case csr_satp:
+            satp = val & (satp_mode | satp_ppn);
+            flush_tlb();
+            return true;
+
+        case csr_medeleg:
+        case csr_mideleg:  return true;
+        case csr_mcounteren:  mcounteren = val; return true;
+        case csr_scounteren:  scounteren = val; return true;
     }
+}
 
-    //set rd to the result of the bitwise operation
-    regs.set(rd, val);
+/**
+ * @brief Method that returns the value of mcycle or minstret. The hart
+ * retires one instruction per cycle, so both count the instructions
+ * executed, offset by base. An inhibited counter is frozen at base.
+ * 
+ * @param base cycle_base or instret_base.
+ * @param inhibit mcountinhibit bit of the counter.
+ * @return uint64_t value of the counter.
+ */
+uint64_t rv32i_hart::get_counter(uint64_t base, uint32_t inhibit) const
+{
+    //insn_counter already includes the instruction that is executing,
+    //which has not retired yet
+    return (mcountinhibit & inhibit) ? base : insn_counter - 1 + base;
+}
 
-    //increment the pc register
-    pc += 4;    
+/**
+ * @brief Method that sets mcycle or minstret so that the next instruction
+ * reads val.
+ * 
+ * @param base cycle_base or instret_base.
+ * @param inhibit mcountinhibit bit of the counter.
+ * @param val new value of the counter.
+ */
+void rv32i_hart::set_counter(uint64_t &base, uint32_t inhibit, uint64_t val)
+{
+    base = (mcountinhibit & inhibit) ? val : val - insn_counter;
+}
 
+/**
+ * @brief Method that returns the value of the time CSR. It ticks once
+ * every insns_per_mtime instructions, a 1 MHz timebase for a hart that
+ * runs at 100 MHz, so it is deterministic and survives checkpoints.
+ * 
+ * @return uint64_t number of timebase ticks since reset.
+ */
+uint64_t rv32i_hart::get_time() const
+{
+    return insn_counter / insns_per_mtime;
 }
 
 /**
- * @brief Method to execute the or instruction.
+ * @brief Method to execute the csrrw instruction. The CSR is not read
+ * when rd is x0.
  * 
  * @param insn RV32I instruction to be executed.
- * @param pos ostream used to print comment column. 
+ * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_or(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_csrrw(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -1643,37 +8685,44 @@ void rv32i_hart::exec_or(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get second source operand
-    uint32_t rs2 = get_rs2(insn);
+    //get immediate value for i-type instruction and extract
+    int32_t csr = get_imm_i(insn) & 0x00000fff;
 
-    //Set register rd to the bitwise OR of rs1 and rs2.
-    uint32_t val = regs.get(rs1) | regs.get(rs2);
+    //read the csr and write rs1 to it
+    uint32_t val = 0;
+    if ((rd != 0 && !csr_read(csr, val)) || !csr_write(csr, regs.get(rs1)))
+    {
+        //trap, or halt execution if there is no handler, on an illegal CSR in csrrw instruction
+        trap(cause_illegal_insn, insn, "Illegal CSR in CSRRW instruction");
+        return;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 | rs2, pc ← pc+4)
+    //involved before and after the instruction simulation
     if(pos)
     {
-        std::string s = render_rtype(insn, "or");
+        std::string s = render_csrrx(insn, "csrrw");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1                  |                        rs2          =            val
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " | " << to_hex0x32(regs.get(rs2)) << " = " << to_hex0x32(val);
+        //                      rd           =      csr
+        *pos << "// " << render_reg(rd) << " = " << val;
     }
 
-    //set rd to the result of the bitwise operation
+    //set rd to the old value of the csr
     regs.set(rd, val);
 
     //increment the pc register
-    pc += 4;       
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the and instruction.
+ * @brief Method to execute the csrrs instruction. The CSR is not written
+ * when rs1 is x0.
  * 
  * @param insn RV32I instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_and(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_csrrs(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -1681,37 +8730,44 @@ void rv32i_hart::exec_and(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get second source operand
-    uint32_t rs2 = get_rs2(insn);
+    //get immediate value for i-type instruction and extract
+    int32_t csr = get_imm_i(insn) & 0x00000fff;
 
-    //Set register rd to the bitwise AND of rs1 and rs2.
-    uint32_t val = regs.get(rs1) & regs.get(rs2);
+    //read the csr and set the bits of rs1 in it
+    uint32_t val;
+    if (!csr_read(csr, val) || (rs1 != 0 && !csr_write(csr, val | regs.get(rs1))))
+    {
+        //trap, or halt execution if there is no handler, on an illegal CSR in csrrs instruction
+        trap(cause_illegal_insn, insn, "Illegal CSR in CSRRS instruction");
+        return;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 & rs2, pc ← pc+4)
+    //involved before and after the instruction simulation
     if(pos)
     {
-        std::string s = render_rtype(insn, "and");
+        std::string s = render_csrrx(insn, "csrrs");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                rs1                  &                        rs2          =            val
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " & " << to_hex0x32(regs.get(rs2)) << " = " << to_hex0x32(val);
+        //                      rd           =      csr
+        *pos << "// " << render_reg(rd) << " = " << val;
     }
 
-    //set rd to the result of the bitwise operation
+    //set rd to the old value of the csr
     regs.set(rd, val);
 
     //increment the pc register
-    pc += 4;
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the sra instruction.
+ * @brief Method to execute the csrrc instruction. The CSR is not written
+ * when rs1 is x0.
  * 
  * @param insn RV32I instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_sra(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_csrrc(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
@@ -1719,119 +8775,150 @@ void rv32i_hart::exec_sra(uint32_t insn, std::ostream* pos)
     //get first source operand
     uint32_t rs1 = get_rs1(insn);
 
-    //get second source operand
-    uint32_t rs2 = get_rs2(insn);
-
-    //extract the 5 LSB of rs2
-    int32_t shift = (regs.get(rs2) & 0x0000001f);
+    //get immediate value for i-type instruction and extract
+    int32_t csr = get_imm_i(insn) & 0x00000fff;
 
-    //shift right arithmetically rs1 by the extracted 5 LSB of rs2
-    int32_t val = regs.get(rs1) >> shift;
+    //read the csr and clear the bits of rs1 in it
+    uint32_t val;
+    if (!csr_read(csr, val) || (rs1 != 0 && !csr_write(csr, val & ~regs.get(rs1))))
+    {
+        //trap, or halt execution if there is no handler, on an illegal CSR in csrrc instruction
+        trap(cause_illegal_insn, insn, "Illegal CSR in CSRRC instruction");
+        return;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 >> (rs2%XLEN), pc ← pc+4)
+    //involved before and after the instruction simulation
     if(pos)
     {
-        std::string s = render_rtype(insn, "sra");
+        std::string s = render_csrrx(insn, "csrrc");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                (rs1                   >>     shift      =            val
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " >> " << shift << " = " << to_hex0x32(val);
+        //                      rd           =      csr
+        *pos << "// " << render_reg(rd) << " = " << val;
     }
 
-    //set rd to the result of the bitwise operation
+    //set rd to the old value of the csr
     regs.set(rd, val);
 
     //increment the pc register
-    pc += 4;
+    pc += insn_length;
 }
 
 /**
- * @brief Method to execute the srl instruction.
+ * @brief Method to execute the csrrwi instruction. The CSR is not read
+ * when rd is x0.
  * 
  * @param insn RV32I instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_srl(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_csrrwi(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
 
-    //get first source operand
-    uint32_t rs1 = get_rs1(insn);
-
-    //get second source operand
-    uint32_t rs2 = get_rs2(insn);
+    //get the 5 bit unsigned immediate from the rs1 field
+    uint32_t zimm = get_rs1(insn);
 
-    //extract the 5 LSB of rs2
-    uint32_t shift = (regs.get(rs2) & 0x0000001f);
+    //get immediate value for i-type instruction and extract
+    int32_t csr = get_imm_i(insn) & 0x00000fff;
 
-    //shift right arithmetically rs1 by the extracted 5 LSB of rs2
-    uint32_t val = (uint32_t) regs.get(rs1) >> shift;
+    //read the csr and write zimm to it
+    uint32_t val = 0;
+    if ((rd != 0 && !csr_read(csr, val)) || !csr_write(csr, zimm))
+    {
+        //trap, or halt execution if there is no handler, on an illegal CSR in csrrwi instruction
+        trap(cause_illegal_insn, insn, "Illegal CSR in CSRRWI instruction");
+        return;
+    }
 
     //render the simulation summary comment that shows the values of all the registers 
-    //involved before and after the instruction simulation (rd ← rs1 >> (rs2%XLEN), pc ← pc+4)
+    //involved before and after the instruction simulation
     if(pos)
     {
-        std::string s = render_rtype(insn, "srl");
+        std::string s = render_csrrxi(insn, "csrrwi");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                         rd        =                (rs1                   >>     shift      =            val
-        *pos << "// " << render_reg(rd) << " = " << to_hex0x32(regs.get(rs1)) << " >> " << shift << " = " << to_hex0x32(val);
+        //                      rd           =      csr
+        *pos << "// " << render_reg(rd) << " = " << val;
     }
 
-    //set rd to the result of the bitwise operation
+    //set rd to the old value of the csr
     regs.set(rd, val);
 
     //increment the pc register
-    pc += 4;    
+    pc += insn_length;
 }
 
-
 /**
- * @brief Method to execute the EBREAK instruction.
+ * @brief Method to execute the csrrsi instruction. The CSR is not written
+ * when zimm is 0.
  * 
  * @param insn RV32I instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_ebreak(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_csrrsi(uint32_t insn, std::ostream* pos)
 {
+    //get register destination
+    uint32_t rd = get_rd(insn);
+
+    //get the 5 bit unsigned immediate from the rs1 field
+    uint32_t zimm = get_rs1(insn);
+
+    //get immediate value for i-type instruction and extract
+    int32_t csr = get_imm_i(insn) & 0x00000fff;
+
+    //read the csr and set the bits of zimm in it
+    uint32_t val;
+    if (!csr_read(csr, val) || (zimm != 0 && !csr_write(csr, val | zimm)))
+    {
+        //trap, or halt execution if there is no handler, on an illegal CSR in csrrsi instruction
+        trap(cause_illegal_insn, insn, "Illegal CSR in CSRRSI instruction");
+        return;
+    }
+
     //render the simulation summary comment that shows the values of all the registers 
     //involved before and after the instruction simulation
     if(pos)
     {
-        std::string s = render_ebreak(insn);
+        std::string s = render_csrrxi(insn, "csrrsi");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
-        
-        *pos << "// HALT";
+
+        //                      rd           =      csr
+        *pos << "// " << render_reg(rd) << " = " << val;
     }
-    halt = true;
-    halt_reason = "EBREAK instruction";
-}
 
+    //set rd to the old value of the csr
+    regs.set(rd, val);
+
+    //increment the pc register
+    pc += insn_length;
+}
 
 /**
- * @brief Method to execute the csrrs instruction.
+ * @brief Method to execute the csrrci instruction. The CSR is not written
+ * when zimm is 0.
  * 
  * @param insn RV32I instruction to be executed.
  * @param pos ostream used to print comment column.
  */
-void rv32i_hart::exec_csrrs(uint32_t insn, std::ostream* pos)
+void rv32i_hart::exec_csrrci(uint32_t insn, std::ostream* pos)
 {
     //get register destination
     uint32_t rd = get_rd(insn);
 
-    //get first source operand
-    uint32_t rs1 = get_rs1(insn);
+    //get the 5 bit unsigned immediate from the rs1 field
+    uint32_t zimm = get_rs1(insn);
 
     //get immediate value for i-type instruction and extract
     int32_t csr = get_imm_i(insn) & 0x00000fff;
 
-    //halt execution if illegal CSR in csrrs instruction or rs1 is not x0
-    if(csr != 0xf14 || rs1 != 0)
+    //read the csr and clear the bits of zimm in it
+    uint32_t val;
+    if (!csr_read(csr, val) || (zimm != 0 && !csr_write(csr, val & ~zimm)))
     {
-        halt = true;
-        halt_reason = "Illegal CSR in CSRRS instruction";
+        //trap, or halt execution if there is no handler, on an illegal CSR in csrrci instruction
+        trap(cause_illegal_insn, insn, "Illegal CSR in CSRRCI instruction");
         return;
     }
 
@@ -1839,16 +8926,16 @@ void rv32i_hart::exec_csrrs(uint32_t insn, std::ostream* pos)
     //involved before and after the instruction simulation
     if(pos)
     {
-        std::string s = render_csrrx(insn, "csrrs");
+        std::string s = render_csrrxi(insn, "csrrci");
         *pos << std::setw(instruction_width) << std::setfill(' ') << std::left << s;
 
-        //                      rd           =      mhartid
-        *pos << "// " << render_reg(rd) << " = " << mhartid;
+        //                      rd           =      csr
+        *pos << "// " << render_reg(rd) << " = " << val;
     }
 
-    //set rd to mhartid
-    regs.set(rd, mhartid);
+    //set rd to the old value of the csr
+    regs.set(rd, val);
 
     //increment the pc register
-    pc += 4;
+    pc += insn_length;
 }
\ No newline at end of file
@@ -0,0 +1,402 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+#include "syscall_proxy.h"
+#include <cerrno>
+#include <cstring>      //memchr memset memcpy
+#include <iostream>
+#include <climits>      //INT32_MAX
+#include <fcntl.h>      //openat
+#include <sys/stat.h>   //fstat
+#include <unistd.h>     //read write lseek close
+
+/**
+ * @brief Construct a new syscall_proxy object. The guest starts with
+ * stdin, stdout and stderr open and its heap right after the program.
+ * 
+ * @param mem memory shared by the harts that make the calls.
+ */
+syscall_proxy::syscall_proxy(memory &mem) : mem(mem), fds{ 0, 1, 2 }
+{
+    table.fill(nullptr);
+    table[nr_openat] = &syscall_proxy::sys_openat;
+    table[nr_close] = &syscall_proxy::sys_close;
+    table[nr_lseek] = &syscall_proxy::sys_lseek;
+    table[nr_read] = &syscall_proxy::sys_read;
+    table[nr_write] = &syscall_proxy::sys_write;
+    table[nr_fstat] = &syscall_proxy::sys_fstat;
+    table[nr_exit] = &syscall_proxy::sys_exit;
+    table[nr_exit_group] = &syscall_proxy::sys_exit;
+    table[nr_clock_gettime] = &syscall_proxy::sys_clock_gettime;
+    table[nr_brk] = &syscall_proxy::sys_brk;
+    table[nr_clock_gettime64] = &syscall_proxy::sys_clock_gettime64;
+
+    //set by the first brk(), since a checkpoint may restore the program
+    //after construction
+    brk_start = 0;
+    brk = 0;
+}
+
+/**
+ * @brief Method to run one system call.
+ * 
+ * @param num call number from a7.
+ * @param a arguments from a0-a5. exit is set if the guest asked to exit.
+ * @return int32_t value for a0, -ENOSYS for calls that are not supported.
+ */
+int32_t syscall_proxy::call(uint32_t num, args &a)
+{
+    if (num >= table.size() || !table[num])
+    {
+        return -ENOSYS;
+    }
+    return (this->*table[num])(a);
+}
+
+/**
+ * @brief Method that returns the host fd behind a guest fd.
+ * 
+ * @param fd guest file descriptor.
+ * @return int host file descriptor, or -1 if fd is not open.
+ */
+int syscall_proxy::get_host_fd(uint32_t fd) const
+{
+    return (fd < fds.size()) ? fds[fd] : -1;
+}
+
+/**
+ * @brief Method that returns a duplicate of the host fd behind a guest fd
+ * for calls that may block, so they can run without the lock. Another
+ * hart may close the guest fd meanwhile and the host may reuse the
+ * number, but the duplicate still refers to the same open file. The
+ * caller closes it.
+ * 
+ * @param fd guest file descriptor.
+ * @param host set to the host fd that was duplicated, if not nullptr.
+ * @return int duplicate host fd, or -errno.
+ */
+int syscall_proxy::dup_host_fd(uint32_t fd, int *host)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    int host_fd = get_host_fd(fd);
+    if (host_fd == -1)
+    {
+        return -EBADF;
+    }
+    if (host)
+    {
+        *host = host_fd;
+    }
+
+    int copy = dup(host_fd);
+    return (copy < 0) ? -errno : copy;
+}
+
+/**
+ * @brief Method that translates open flags from the Linux RV32 values to
+ * the host ones.
+ * 
+ * @param flags guest open flags.
+ * @return int host open flags.
+ */
+int syscall_proxy::get_host_flags(uint32_t flags)
+{
+    return (flags & 03)
+        | ((flags & 0100) ? O_CREAT : 0)
+        | ((flags & 0200) ? O_EXCL : 0)
+        | ((flags & 01000) ? O_TRUNC : 0)
+        | ((flags & 02000) ? O_APPEND : 0)
+        | ((flags & 04000) ? O_NONBLOCK : 0)
+        | ((flags & 0200000) ? O_DIRECTORY : 0)
+        | ((flags & 02000000) ? O_CLOEXEC : 0);
+}
+
+/**
+ * @brief openat(dirfd, path, flags, mode). The new guest fd is the lowest
+ * one that is free.
+ * 
+ * @param a call arguments.
+ * @return int32_t the new guest fd, or -errno.
+ */
+int32_t syscall_proxy::sys_openat(args &a)
+{
+    //the path must be terminated inside memory the guest may read
+    const char *path = reinterpret_cast<const char*>(mem.get_read_ptr(a.a[1], 1));
+    const char *end = path ? static_cast<const char*>(memchr(path, 0, mem.get_size() - a.a[1])) : nullptr;
+    if (!end || !mem.check_perm(a.a[1], end - path + 1, memory::perm_r))
+    {
+        return -EFAULT;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    int dirfd = ((int32_t)a.a[0] == -100) ? AT_FDCWD : get_host_fd(a.a[0]);
+    if (dirfd == -1)
+    {
+        return -EBADF;
+    }
+
+    int host_fd = openat(dirfd, path, get_host_flags(a.a[2]), a.a[3]);
+    if (host_fd < 0)
+    {
+        return -errno;
+    }
+
+    uint32_t fd = 0;
+    while (fd < fds.size() && fds[fd] != -1)
+    {
+        fd++;
+    }
+    if (fd == fds.size())
+    {
+        fds.push_back(host_fd);
+    }
+    fds[fd] = host_fd;
+    return fd;
+}
+
+/**
+ * @brief close(fd). The simulator's own stdin, stdout and stderr stay
+ * open when the guest closes them.
+ * 
+ * @param a call arguments.
+ * @return int32_t 0, or -errno.
+ */
+int32_t syscall_proxy::sys_close(args &a)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    int host_fd = get_host_fd(a.a[0]);
+    if (host_fd == -1)
+    {
+        return -EBADF;
+    }
+
+    fds[a.a[0]] = -1;
+    if (host_fd > 2 && close(host_fd) != 0)
+    {
+        return -errno;
+    }
+    return 0;
+}
+
+/**
+ * @brief lseek(fd, offset, whence). This is the three argument form that
+ * newlib uses, not the llseek that Linux puts at the same number.
+ * 
+ * @param a call arguments.
+ * @return int32_t the new offset, or -errno.
+ */
+int32_t syscall_proxy::sys_lseek(args &a)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    int host_fd = get_host_fd(a.a[0]);
+    if (host_fd == -1)
+    {
+        return -EBADF;
+    }
+
+    off_t pos = lseek(host_fd, (int32_t)a.a[1], a.a[2]);
+    if (pos < 0)
+    {
+        return -errno;
+    }
+    return (pos > INT32_MAX) ? -EOVERFLOW : pos;
+}
+
+/**
+ * @brief read(fd, buf, count) straight into guest memory. The buffer has
+ * to be writable by the guest, just as if it stored the bytes itself.
+ * 
+ * @param a call arguments.
+ * @return int32_t number of bytes read, or -errno.
+ */
+int32_t syscall_proxy::sys_read(args &a)
+{
+    int host_fd = dup_host_fd(a.a[0]);
+    if (host_fd < 0)
+    {
+        return host_fd;
+    }
+
+    int32_t res = -EFAULT;
+    uint8_t *buf = mem.check_perm(a.a[1], a.a[2], memory::perm_w) ? mem.get_write_ptr(a.a[1], a.a[2]) : nullptr;
+    if (buf)
+    {
+        ssize_t len = read(host_fd, buf, a.a[2]);
+        res = (len < 0) ? -errno : len;
+    }
+
+    close(host_fd);
+    return res;
+}
+
+/**
+ * @brief write(fd, buf, count) straight from guest memory. The buffer has
+ * to be readable by the guest.
+ * 
+ * @param a call arguments.
+ * @return int32_t number of bytes written, or -errno.
+ */
+int32_t syscall_proxy::sys_write(args &a)
+{
+    int target = -1;
+    int host_fd = dup_host_fd(a.a[0], &target);
+    if (host_fd < 0)
+    {
+        return host_fd;
+    }
+
+    int32_t res = -EFAULT;
+    const uint8_t *buf = mem.check_perm(a.a[1], a.a[2], memory::perm_r) ? mem.get_read_ptr(a.a[1], a.a[2]) : nullptr;
+    if (buf)
+    {
+        //keep the output in order with what the simulator prints itself
+        if (target == 1 || target == 2)
+        {
+            std::cout.flush();
+        }
+
+        ssize_t len = write(host_fd, buf, a.a[2]);
+        res = (len < 0) ? -errno : len;
+    }
+
+    close(host_fd);
+    return res;
+}
+
+/**
+ * @brief fstat(fd, statbuf). statbuf has the layout of the Linux
+ * asm-generic struct stat64, which is what newlib expects on RV32.
+ * 
+ * @param a call arguments.
+ * @return int32_t 0, or -errno.
+ */
+int32_t syscall_proxy::sys_fstat(args &a)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    int host_fd = get_host_fd(a.a[0]);
+    uint8_t *st = mem.check_perm(a.a[1], 104, memory::perm_w) ? mem.get_write_ptr(a.a[1], 104) : nullptr;
+    if (host_fd == -1)
+    {
+        return -EBADF;
+    }
+    if (!st)
+    {
+        return -EFAULT;
+    }
+
+    struct stat hs;
+    if (fstat(host_fd, &hs) != 0)
+    {
+        return -errno;
+    }
+
+    //store a field at its offset, the host is little endian like the guest
+    auto put = [st](uint32_t off, uint64_t val, uint32_t size) { memcpy(st + off, &val, size); };
+
+    memset(st, 0, 104);
+    put(0, hs.st_dev, 8);
+    put(8, hs.st_ino, 8);
+    put(16, hs.st_mode, 4);
+    put(20, hs.st_nlink, 4);
+    put(24, hs.st_uid, 4);
+    put(28, hs.st_gid, 4);
+    put(32, hs.st_rdev, 8);
+    put(48, hs.st_size, 8);
+    put(56, hs.st_blksize, 4);
+    put(64, hs.st_blocks, 8);
+    put(72, hs.st_atim.tv_sec, 4);
+    put(76, hs.st_atim.tv_nsec, 4);
+    put(80, hs.st_mtim.tv_sec, 4);
+    put(84, hs.st_mtim.tv_nsec, 4);
+    put(88, hs.st_ctim.tv_sec, 4);
+    put(92, hs.st_ctim.tv_nsec, 4);
+    return 0;
+}
+
+/**
+ * @brief exit(status) and exit_group(status). The hart halts and the
+ * status is left as the result.
+ * 
+ * @param a call arguments.
+ * @return int32_t the exit status.
+ */
+int32_t syscall_proxy::sys_exit(args &a)
+{
+    a.exit = true;
+    return a.a[0];
+}
+
+/**
+ * @brief clock_gettime(clockid, tp) with a 32-bit struct timespec. Every
+ * clock reads the hart time CSR so timings are deterministic.
+ * 
+ * @param a call arguments.
+ * @return int32_t 0, or -errno.
+ */
+int32_t syscall_proxy::sys_clock_gettime(args &a)
+{
+    int32_t ts[2] = { (int32_t)(a.time / 1000000), (int32_t)(a.time % 1000000 * 1000) };
+    if (!mem.check_perm(a.a[1], sizeof(ts), memory::perm_w))
+    {
+        return -EFAULT;
+    }
+    return mem.write_block(a.a[1], ts, sizeof(ts)) ? 0 : -EFAULT;
+}
+
+/**
+ * @brief brk(addr). The heap may grow up to the end of memory and brk(0)
+ * reads the current break. The break is returned either way, a request
+ * that cannot be met leaves it unchanged.
+ * 
+ * @param a call arguments.
+ * @return int32_t the break.
+ */
+int32_t syscall_proxy::sys_brk(args &a)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    //the heap starts at the page after the program
+    if (brk == 0)
+    {
+        brk_start = (mem.get_load_size() + memory::page_size - 1) & ~(memory::page_size - 1);
+        brk = brk_start;
+    }
+
+    if (a.a[0] >= brk_start && a.a[0] <= mem.get_size())
+    {
+        brk = a.a[0];
+    }
+    return brk;
+}
+
+/**
+ * @brief clock_gettime64(clockid, tp) with a 64-bit struct timespec, the
+ * only form RV32 Linux has.
+ * 
+ * @param a call arguments.
+ * @return int32_t 0, or -errno.
+ */
+int32_t syscall_proxy::sys_clock_gettime64(args &a)
+{
+    int64_t sec = a.time / 1000000;
+    int32_t ts[4] = { (int32_t)sec, (int32_t)(sec >> 32), (int32_t)(a.time % 1000000 * 1000), 0 };
+    if (!mem.check_perm(a.a[1], sizeof(ts), memory::perm_w))
+    {
+        return -EFAULT;
+    }
+    return mem.write_block(a.a[1], ts, sizeof(ts)) ? 0 : -EFAULT;
+}
@@ -0,0 +1,85 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+#ifndef SYSCALL_PROXY_H
+#define SYSCALL_PROXY_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "memory.h"
+
+/**
+ * Runs the system calls a guest makes with ECALL on the host, following
+ * the Linux RV32 calling convention: a7 holds the call number, a0-a5 the
+ * arguments and a0 receives the result or -errno. Calls are looked up in
+ * a table indexed directly by the call number. Guest buffers are handed to
+ * the host as pointers into memory, so read and write copy nothing.
+ * Guest file descriptors are mapped onto host ones so the guest can only
+ * reach the files it opened plus stdin, stdout and stderr.
+ ********************************************************************************/
+class syscall_proxy
+{
+public:
+    /// one call made by a hart
+    struct args
+    {
+        uint32_t a[6];              ///< a0-a5
+        uint64_t time;              ///< hart time CSR, in microseconds
+        bool exit = { false };      ///< set by exit and exit_group
+    };
+
+    syscall_proxy(memory &mem);
+
+    int32_t call(uint32_t num, args &a);
+
+    static constexpr uint32_t nr_openat = 56;
+    static constexpr uint32_t nr_close = 57;
+    static constexpr uint32_t nr_lseek = 62;
+    static constexpr uint32_t nr_read = 63;
+    static constexpr uint32_t nr_write = 64;
+    static constexpr uint32_t nr_fstat = 80;
+    static constexpr uint32_t nr_exit = 93;
+    static constexpr uint32_t nr_exit_group = 94;
+    static constexpr uint32_t nr_clock_gettime = 113;
+    static constexpr uint32_t nr_brk = 214;
+    static constexpr uint32_t nr_clock_gettime64 = 403;
+
+private:
+    typedef int32_t (syscall_proxy::*handler)(args &a);
+
+    int32_t sys_openat(args &a);
+    int32_t sys_close(args &a);
+    int32_t sys_lseek(args &a);
+    int32_t sys_read(args &a);
+    int32_t sys_write(args &a);
+    int32_t sys_fstat(args &a);
+    int32_t sys_exit(args &a);
+    int32_t sys_clock_gettime(args &a);
+    int32_t sys_brk(args &a);
+    int32_t sys_clock_gettime64(args &a);
+
+    int get_host_fd(uint32_t fd) const;
+    int dup_host_fd(uint32_t fd, int *host = nullptr);
+    static int get_host_flags(uint32_t flags);
+
+    memory &mem;
+    std::array<handler, nr_clock_gettime64 + 1> table;
+    std::mutex lock;            ///< guards fds and brk between harts
+    std::vector<int> fds;       ///< host fd for each guest fd, -1 if closed
+    uint32_t brk_start;         ///< page after the loaded program, set by the first brk()
+    uint32_t brk;
+};
+
+#endif
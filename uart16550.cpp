@@ -0,0 +1,309 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+#include "uart16550.h"
+#include <fcntl.h>      //open
+#include <poll.h>       //poll
+#include <unistd.h>     //read write close
+#include <iostream>
+
+/**
+ * @brief Construct a new uart16550 object. It reads the host stdin until
+ * open_input() picks a file.
+ */
+uart16550::uart16550()
+{
+    tx.reserve(flush_size);
+}
+
+/**
+ * @brief Destroy the uart16550 object, writing out any buffered bytes.
+ */
+uart16550::~uart16550()
+{
+    flush();
+
+    if (rx_fd > 2)
+    {
+        close(rx_fd);
+    }
+}
+
+/**
+ * @brief Method to map the registers into memory.
+ * 
+ * @param mem memory to map the UART into.
+ * @param base address of the RBR register, above the RAM.
+ * @return true if the registers were mapped.
+ */
+bool uart16550::map(memory &mem, uint32_t base)
+{
+    return mem.add_mmio(base, size,
+        [this](uint32_t offset, uint32_t) -> uint32_t
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            return read_reg(offset);
+        },
+        [this](uint32_t offset, uint32_t, uint32_t val)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            write_reg(offset, val);
+        });
+}
+
+/**
+ * @brief Method to take the received bytes from a file instead of stdin.
+ * 
+ * @param fname file to read.
+ * @return true if the file could be opened.
+ */
+bool uart16550::open_input(const std::string &fname)
+{
+    int fd = open(fname.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        std::cerr << "Can't open file '" << fname << "' for reading." << std::endl;
+        return false;
+    }
+
+    rx_fd = fd;
+    return true;
+}
+
+/**
+ * @brief Method to connect the interrupt line. It is called with the new
+ * level every time the line changes.
+ * 
+ * @param irq function that drives the interrupt input of a hart.
+ */
+void uart16550::set_irq(std::function<void(bool)> irq)
+{
+    this->irq = std::move(irq);
+}
+
+/**
+ * @brief Method to check the host for received bytes without the guest
+ * touching the UART, so that a received data interrupt can be raised.
+ */
+void uart16550::poll()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    rx_ready();
+    update_irq();
+}
+
+/**
+ * @brief Method to write the buffered transmit bytes to the host stdout.
+ */
+void uart16550::flush()
+{
+    size_t done = 0;
+
+    while (done < tx.size())
+    {
+        ssize_t n = write(1, tx.data() + done, tx.size() - done);
+        if (n <= 0)
+        {
+            break;
+        }
+        done += n;
+    }
+
+    tx.clear();
+}
+
+/**
+ * @brief Method that reports whether a received byte is waiting. When the
+ * buffer is empty the host is asked for more with a poll() that never
+ * waits.
+ * 
+ * @return true if the guest can read a byte from RBR.
+ */
+bool uart16550::rx_ready()
+{
+    if (rx_pos < rx.size() || rx_eof)
+    {
+        return rx_pos < rx.size();
+    }
+
+    struct pollfd p = { rx_fd, POLLIN, 0 };
+    if (::poll(&p, 1, 0) <= 0)
+    {
+        return false;
+    }
+
+    rx.resize(256);
+    ssize_t n = read(rx_fd, rx.data(), rx.size());
+
+    //stop asking once the input has ended
+    rx_eof = n <= 0;
+    rx.resize(n > 0 ? n : 0);
+    rx_pos = 0;
+    return n > 0;
+}
+
+/**
+ * @brief Method to drive the interrupt line from the enabled sources.
+ * Only the bytes already buffered count, so a transmit never costs a
+ * host call.
+ */
+void uart16550::update_irq()
+{
+    bool level = ((ier & ier_rdi) && rx_pos < rx.size()) || ((ier & ier_thri) && thre_pending);
+
+    if (level != irq_level)
+    {
+        irq_level = level;
+        if (irq)
+        {
+            irq(level);
+        }
+    }
+}
+
+/**
+ * @brief Method to read a register. Wider accesses read the byte at the
+ * same offset.
+ * 
+ * @param offset register number.
+ * @return uint8_t register value.
+ */
+uint8_t uart16550::read_reg(uint32_t offset)
+{
+    uint8_t val = 0;
+
+    switch (offset)
+    {
+    case reg_rbr:
+        if (lcr & lcr_dlab)
+        {
+            val = dll;
+        }
+        else if (rx_ready())
+        {
+            val = rx[rx_pos++];
+        }
+        break;
+
+    case reg_ier:
+        val = (lcr & lcr_dlab) ? dlm : ier;
+        break;
+
+    case reg_iir:
+        //received data has priority over the transmitter
+        if ((ier & ier_rdi) && rx_ready())
+        {
+            val = iir_rdi;
+        }
+        else if ((ier & ier_thri) && thre_pending)
+        {
+            //reading the id acknowledges the transmitter interrupt
+            val = iir_thri;
+            thre_pending = false;
+        }
+        else
+        {
+            val = iir_none;
+        }
+        val |= (fcr & fcr_enable) ? iir_fifo : 0;
+        break;
+
+    case reg_lcr:
+        val = lcr;
+        break;
+
+    case reg_mcr:
+        val = mcr;
+        break;
+
+    case reg_lsr:
+        //bytes leave the transmitter as soon as they are written
+        val = lsr_thre | lsr_temt | (rx_ready() ? lsr_dr : 0);
+        break;
+
+    case reg_msr:
+        val = 0;
+        break;
+
+    case reg_scr:
+        val = scr;
+        break;
+    }
+
+    update_irq();
+    return val;
+}
+
+/**
+ * @brief Method to write a register. Wider accesses write the low byte
+ * at the same offset.
+ * 
+ * @param offset register number.
+ * @param val value to write.
+ */
+void uart16550::write_reg(uint32_t offset, uint8_t val)
+{
+    switch (offset)
+    {
+    case reg_rbr:
+        if (lcr & lcr_dlab)
+        {
+            dll = val;
+            break;
+        }
+
+        tx.push_back(val);
+        if (val == '\n' || tx.size() >= flush_size)
+        {
+            flush();
+        }
+
+        //the holding register is empty again at once
+        thre_pending = true;
+        break;
+
+    case reg_ier:
+        if (lcr & lcr_dlab)
+        {
+            dlm = val;
+            break;
+        }
+
+        //enabling the transmitter interrupt raises it if THR is empty
+        thre_pending |= (val & ier_thri) && !(ier & ier_thri);
+        ier = val & 0x0f;
+        break;
+
+    case reg_iir:
+        fcr = val;
+        if (val & fcr_clear_rx)
+        {
+            rx_pos = rx.size();
+        }
+        break;
+
+    case reg_lcr:
+        lcr = val;
+        break;
+
+    case reg_mcr:
+        mcr = val & 0x1f;
+        break;
+
+    case reg_scr:
+        scr = val;
+        break;
+    }
+
+    update_irq();
+}
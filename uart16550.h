@@ -0,0 +1,97 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+
+#ifndef UART16550_H
+#define UART16550_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "memory.h"
+
+/**
+ * A 16550-compatible UART with its eight byte-wide registers mapped into
+ * memory. Transmitted bytes are collected in a host buffer and written
+ * out in one host write() on newline, when the buffer is full or when
+ * flush() is called at the end of the run. Received bytes come from the
+ * host stdin or a file, read without blocking whenever the guest looks at
+ * the receive side and nothing is buffered.
+ ********************************************************************************/
+class uart16550
+{
+public:
+    uart16550();
+    ~uart16550();
+
+    bool map(memory &mem, uint32_t base);
+    bool open_input(const std::string &fname);
+    void set_irq(std::function<void(bool)> irq);
+    void poll();
+    void flush();
+
+    static constexpr uint32_t size = 8;         ///< bytes of registers mapped
+    static constexpr uint32_t flush_size = 4096;///< tx bytes held before a write
+    static constexpr uint64_t poll_interval = 100000;///< insns between poll() calls
+
+    static constexpr uint32_t reg_rbr = 0;      ///< receive / transmit, DLL with DLAB
+    static constexpr uint32_t reg_ier = 1;      ///< interrupt enable, DLM with DLAB
+    static constexpr uint32_t reg_iir = 2;      ///< interrupt id / FIFO control
+    static constexpr uint32_t reg_lcr = 3;
+    static constexpr uint32_t reg_mcr = 4;
+    static constexpr uint32_t reg_lsr = 5;
+    static constexpr uint32_t reg_msr = 6;
+    static constexpr uint32_t reg_scr = 7;
+
+    static constexpr uint8_t ier_rdi = 0x01;    ///< received data interrupt
+    static constexpr uint8_t ier_thri = 0x02;   ///< transmitter empty interrupt
+    static constexpr uint8_t iir_none = 0x01;
+    static constexpr uint8_t iir_thri = 0x02;
+    static constexpr uint8_t iir_rdi = 0x04;
+    static constexpr uint8_t iir_fifo = 0xc0;   ///< FIFOs enabled
+    static constexpr uint8_t fcr_enable = 0x01;
+    static constexpr uint8_t fcr_clear_rx = 0x02;
+    static constexpr uint8_t lcr_dlab = 0x80;
+    static constexpr uint8_t lsr_dr = 0x01;     ///< data ready
+    static constexpr uint8_t lsr_thre = 0x20;   ///< transmit holding register empty
+    static constexpr uint8_t lsr_temt = 0x40;   ///< transmitter empty
+
+private:
+    uint8_t read_reg(uint32_t offset);
+    void write_reg(uint32_t offset, uint8_t val);
+    bool rx_ready();
+    void update_irq();
+
+    std::mutex lock;                ///< guards the registers between harts
+    std::function<void(bool)> irq;  ///< interrupt line, may be empty
+    bool irq_level = { false };
+
+    std::string tx;                 ///< bytes not yet written to the host
+    int rx_fd = { 0 };
+    bool rx_eof = { false };
+    std::vector<uint8_t> rx;        ///< bytes read from the host
+    size_t rx_pos = { 0 };          ///< next byte of rx for the guest
+
+    uint8_t ier = { 0 };
+    uint8_t fcr = { 0 };
+    uint8_t lcr = { 0 };
+    uint8_t mcr = { 0 };
+    uint8_t scr = { 0 };
+    uint8_t dll = { 0 };
+    uint8_t dlm = { 0 };
+    bool thre_pending = { false };  ///< THRE interrupt not yet acknowledged
+};
+
+#endif
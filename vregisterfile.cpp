@@ -0,0 +1,95 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+#include "vregisterfile.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * @brief Construct a new vregisterfile object
+ * 
+ * @param vlen width of each vector register in bits.
+ */
+vregisterfile::vregisterfile(uint32_t vlen)
+{
+    set_vlen(vlen);
+}
+
+/**
+ * @brief Method to reset the registers.
+ * 
+ */
+void vregisterfile::reset()
+{
+    //initialize all registers to the same pattern as the GP registers
+    std::fill(regs.begin(), regs.end(), 0xf0);
+}
+
+/**
+ * @brief Method to change the width of the vector registers. The
+ * registers are reset.
+ * 
+ * @param vlen width of each vector register in bits, see is_valid_vlen().
+ */
+void vregisterfile::set_vlen(uint32_t vlen)
+{
+    vlenb = vlen / 8;
+    regs.resize(32 * vlenb);
+    reset();
+}
+
+/**
+ * @brief Method to check that vlen is a power of two between min_vlen and
+ * max_vlen.
+ * 
+ * @param vlen width of each vector register in bits.
+ * @return true if the width can be used.
+ */
+bool vregisterfile::is_valid_vlen(uint32_t vlen)
+{
+    return vlen >= min_vlen && vlen <= max_vlen && (vlen & (vlen - 1)) == 0;
+}
+
+/**
+ * @brief Method to dump the registers as 32-bit words, lowest element
+ * first, with up to 256 bits of registers per line.
+ * 
+ * @param hdr string that must be printed at beginning line.
+ */
+void vregisterfile::dump(const std::string &hdr) const
+{
+    uint32_t per_line = std::max<uint32_t>(1, 32 / vlenb);
+
+    for (uint32_t regr = 0; regr < 32; regr += per_line)
+    {
+        //format string for row header
+        std::string v = "v" + std::to_string(regr);
+
+        //print out header with proper formatting
+        std::cout << hdr;
+        std::cout << std::setw(3) << std::setfill(' ') << std::right << v;
+
+        //print the registers in the current row with an extra space between them
+        for (uint32_t r = regr; r < regr + per_line; r++)
+        {
+            std::cout << " ";
+            for (uint32_t byte = 0; byte < vlenb; byte += 4)
+            {
+                const uint8_t *p = get(r) + byte;
+                std::cout << " " << to_hex32(p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24);
+            }
+        }
+        std::cout << std::endl;
+    }
+}
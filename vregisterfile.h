@@ -0,0 +1,64 @@
+//***************************************************************************
+//
+//  Matthew Lorenc
+//  z1904531
+//  CSCI 463 Section 1
+//
+//  I certify that this is my own work and where appropriate an extension 
+//  of the starter code provided for the assignment.
+//
+//***************************************************************************
+
+
+#ifndef VREGISTERFILE_H
+#define VREGISTERFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "hex.h"
+
+/**
+ * The 32 vector registers of the V extension, each vlen bits wide. The
+ * registers are stored back to back so that a register group (LMUL > 1)
+ * is one contiguous span of memory that the execution kernels can walk as
+ * a plain array of elements.
+ ********************************************************************************/
+class vregisterfile : public hex
+{
+public:
+    vregisterfile(uint32_t vlen = default_vlen);
+
+    void reset();
+    void set_vlen(uint32_t vlen);
+
+    uint32_t get_vlen() const { return vlenb * 8; }
+    uint32_t get_vlenb() const { return vlenb; }
+
+    uint8_t *get(uint32_t v) { return &regs[v * vlenb]; }
+    const uint8_t *get(uint32_t v) const { return &regs[v * vlenb]; }
+
+    /// bit i of the mask held in register v
+    bool get_mask(uint32_t v, uint32_t i) const { return (get(v)[i >> 3] >> (i & 7)) & 1; }
+
+    void dump(const std::string &hdr) const;
+
+    static bool is_valid_vlen(uint32_t vlen);
+
+    /**
+     * Element type that may alias the bytes of the register file, used by
+     * the kernels to view a register group as an array of T.
+     ********************************************************************************/
+    template<typename T> struct alias { typedef T __attribute__((__may_alias__)) type; };
+
+    static constexpr uint32_t default_vlen = 128;
+    static constexpr uint32_t min_vlen = 64;
+    static constexpr uint32_t max_vlen = 1024;
+
+private:
+    uint32_t vlenb;
+    std::vector<uint8_t> regs;
+};
+
+#endif